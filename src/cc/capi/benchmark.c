@@ -0,0 +1,195 @@
+/*
+ * Measures the per-call latency of the C ABI, as seen by a C caller.
+ *
+ *   benchmark <corpus> [<rounds>]
+ *
+ * The corpus lists puzzles in the input format of the sudoku binary, separated by empty lines.
+ * Every puzzle is solved once to warm up, and then rounds times (100 by default), each call
+ * timed on its own. One record is written per puzzle, followed by a summary:
+ *
+ *   call,<index>,<size>,<median_ns>,<min_ns>
+ *   summary,<puzzles>,<calls>,<mean_ns>
+ */
+#define _POSIX_C_SOURCE 199309L  // for clock_gettime()
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sudoku.h"
+
+/*
+ * Largest supported grid, and its number of cells
+ */
+#define MAX_SIZE 16
+#define MAX_CELLS (MAX_SIZE * MAX_SIZE)
+
+/*
+ * Default number of timed calls per puzzle, and the longest line read
+ */
+#define DEFAULT_ROUNDS 100
+#define MAX_LINE 1024
+
+/*
+ * Get a monotonic timestamp in nanoseconds.
+ */
+static uint64_t now_ns(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+static int compare_u64(const void *left, const void *right) {
+  const uint64_t a = *(const uint64_t *)left;
+  const uint64_t b = *(const uint64_t *)right;
+  return (a > b) - (a < b);
+}
+
+/*
+ * Remove all whitespace from the given line, and return its length.
+ */
+static size_t strip(char *line) {
+  size_t length = 0;
+  for (const char *c = line; *c != '\0'; c++) {
+    if (*c != ' ' && *c != '\t' && *c != '\r' && *c != '\n') {
+      line[length++] = *c;
+    }
+  }
+  line[length] = '\0';
+  return length;
+}
+
+/*
+ * Get the number of a cell for a grid of the given size, 0 for an empty cell, or -1 if invalid.
+ * Sudokus of 16x16 use 0..F for the numbers 1..16.
+ */
+static int cell_number(char token, int size) {
+  int number = -1;
+  if (token == '_') {
+    return 0;
+  } else if (token >= '0' && token <= '9') {
+    number = token - '0';
+  } else if (token >= 'A' && token <= 'F') {
+    number = token - 'A' + 10;
+  } else if (token >= 'a' && token <= 'f') {
+    number = token - 'a' + 10;
+  }
+  if (size == MAX_SIZE && number >= 0) {
+    number++;
+  }
+  return number >= 1 && number <= size ? number : -1;
+}
+
+/*
+ * Read the next puzzle from the corpus into cells.
+ *
+ * Returns the size of the puzzle, 0 at the end of the corpus, or -1 if the puzzle is malformed.
+ */
+static int read_puzzle(FILE *corpus, uint8_t *cells) {
+  char line[MAX_LINE];
+  int size = 0;
+  int row = 0;
+
+  while (fgets(line, sizeof(line), corpus) != NULL) {
+    const size_t length = strip(line);
+    if (length == 0) {
+      if (size == 0) {
+        continue;
+      }
+      break;
+    }
+
+    if (size == 0) {
+      size = (int)length;
+      if (size != 4 && size != 9 && size != MAX_SIZE) {
+        return -1;
+      }
+    }
+    if ((int)length != size || row >= size) {
+      return -1;
+    }
+
+    for (int column = 0; column < size; column++) {
+      const int number = cell_number(line[column], size);
+      if (number < 0) {
+        return -1;
+      }
+      cells[row * size + column] = (uint8_t)number;
+    }
+    row++;
+  }
+
+  return row == size ? size : -1;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <corpus> [<rounds>]\n", argv[0]);
+    return 1;
+  }
+  const int rounds = argc > 2 ? atoi(argv[2]) : DEFAULT_ROUNDS;
+  if (rounds <= 0) {
+    fprintf(stderr, "Error: rounds must be positive\n");
+    return 1;
+  }
+
+  FILE *corpus = fopen(argv[1], "r");
+  if (corpus == NULL) {
+    fprintf(stderr, "Error: Cannot read corpus %s\n", argv[1]);
+    return 1;
+  }
+
+  // one handle per grid size, created on first use
+  sudoku_solver *solvers[MAX_SIZE + 1] = {NULL};
+  uint64_t *latencies = malloc(sizeof(uint64_t) * (size_t)rounds);
+  uint8_t cells[MAX_CELLS];
+  uint8_t solution[MAX_CELLS];
+
+  int puzzles = 0;
+  uint64_t calls = 0;
+  uint64_t total_ns = 0;
+  int result = 0;
+
+  for (int size = read_puzzle(corpus, cells); size != 0; size = read_puzzle(corpus, cells)) {
+    if (size < 0) {
+      fprintf(stderr, "Error: Malformed puzzle %d\n", puzzles + 1);
+      result = 1;
+      break;
+    }
+
+    if (solvers[size] == NULL) {
+      solvers[size] = sudoku_solver_create(size);
+    }
+
+    const size_t length = (size_t)(size * size);
+    if (sudoku_solve(solvers[size], cells, length, solution, length) != SUDOKU_OK) {
+      fprintf(stderr, "Error: No solution for puzzle %d\n", puzzles + 1);
+      result = 1;
+    }
+
+    for (int round = 0; round < rounds; round++) {
+      const uint64_t start = now_ns();
+      sudoku_solve(solvers[size], cells, length, solution, length);
+      latencies[round] = now_ns() - start;
+      total_ns += latencies[round];
+    }
+    calls += (uint64_t)rounds;
+
+    qsort(latencies, (size_t)rounds, sizeof(uint64_t), compare_u64);
+    printf("call,%d,%d,%llu,%llu\n", puzzles, size, (unsigned long long)latencies[rounds / 2],
+           (unsigned long long)latencies[0]);
+    puzzles++;
+  }
+
+  printf("summary,%d,%llu,%llu\n", puzzles, (unsigned long long)calls,
+         (unsigned long long)(calls > 0 ? total_ns / calls : 0));
+
+  for (int size = 0; size <= MAX_SIZE; size++) {
+    sudoku_solver_free(solvers[size]);
+  }
+  free(latencies);
+  fclose(corpus);
+  return result;
+}
@@ -0,0 +1,257 @@
+#include "sudoku.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/cc/libdlx/memory-resource.hpp"
+
+namespace {
+/**
+ * Number of allocations via the global operator new, replaced below
+ */
+std::atomic<std::size_t> heap_allocations{0};
+
+/**
+ * Test Helper: allocate from the heap for the replaced operator new, counting the allocation
+ */
+auto countedAllocate(std::size_t size, std::size_t alignment) -> void * {
+  heap_allocations++;
+  size = size == 0 ? 1 : size;
+
+  // aligned_alloc() requires a size that is a multiple of the alignment
+  void *memory = alignment <= alignof(std::max_align_t)
+                     ? std::malloc(size)
+                     : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+}  // namespace
+
+// Replace every allocating form of the global operator new, and the matching forms of operator delete,
+// so that any heap allocation in the library is counted. The nothrow forms call these.
+// The forms of operator delete are not inlined: GCC would otherwise see the std::free() calls on memory
+// from a new-expression at the call site, and report them as -Wmismatched-new-delete.
+auto operator new(std::size_t size) -> void * {
+  return countedAllocate(size, alignof(std::max_align_t));
+}
+
+auto operator new[](std::size_t size) -> void * {
+  return countedAllocate(size, alignof(std::max_align_t));
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void * {
+  return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void * {
+  return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+__attribute__((noinline)) void operator delete(void *memory) noexcept {
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void *memory) noexcept {
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void *memory, std::size_t /*size*/) noexcept {
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void *memory, std::size_t /*size*/) noexcept {
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void *memory, std::align_val_t /*alignment*/) noexcept {
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void *memory, std::align_val_t /*alignment*/) noexcept {
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void *memory, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void *memory, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  std::free(memory);
+}
+
+namespace {
+
+/**
+ * Test Helper: the example 4x4 Sudoku, and its solution
+ */
+constexpr std::array<std::uint8_t, 16> SmallGivens = {4, 0, 0, 1, 0, 1, 3, 0, 0, 4, 1, 0, 1, 0, 0, 3};
+constexpr std::array<std::uint8_t, 16> SmallSolution = {4, 3, 2, 1, 2, 1, 3, 4, 3, 4, 1, 2, 1, 2, 4, 3};
+
+/**
+ * Test Helper: the example 16x16 Sudoku, the hardest to solve of the examples, and its solution
+ */
+constexpr std::array<const char *, 16> LargeGivens = {
+    "89_4_3_1_DA2_6__", "___DA__B_E_5C__8", "__1CF_5_____EB__", "6_____4_____32_A",
+    "C____9___4_1__A_", "_4____6________E", "7_8_____E___6__5", "__________7_0F4_",
+    "___6____7C___9__", "D87__E_6__5A____", "__2_08_5__E_F___", "45__2FA_8369__D_",
+    "_______A3720___F", "__A_D5_C____4___", "_1D04____AF___C_", "___E8_B_C1______"};
+constexpr std::array<const char *, 16> LargeSolution = {
+    "89E4C301BDA256F7", "0F3DA72B6E95C418", "2A1CF6584037EB9D", "6B57ED491FC8320A",
+    "C6B579E0F4812DA3", "34FA1C6D250B978E", "70823AF4E9DC61B5", "ED915B82A6730F4C",
+    "AE06B4D37C1F8952", "D87F9E16025ABC34", "132908C5DBE4FA76", "45CB2FA783691ED0",
+    "BC48619A3720D5EF", "F2A3D57C98BE4061", "91D0423E5AF678CB", "576E80BFC14DA329"};
+
+/**
+ * Test Helper: convert rows of a 16x16 grid, in the digit range 0..F, to numbers 1..16,
+ * with 0 for '_'
+ */
+auto toNumbers(const std::array<const char *, 16> &rows) -> std::vector<std::uint8_t> {
+  std::vector<std::uint8_t> numbers;
+  for (const char *row : rows) {
+    for (const char *cell = row; *cell != '\0'; cell++) {
+      if (*cell == '_') {
+        numbers.push_back(0);
+      } else if (*cell >= 'A') {
+        numbers.push_back(static_cast<std::uint8_t>(*cell - 'A' + 11));
+      } else {
+        numbers.push_back(static_cast<std::uint8_t>(*cell - '0' + 1));
+      }
+    }
+  }
+  return numbers;
+}
+
+/**
+ * Test: a handle solves and counts puzzles of its size
+ */
+TEST(CApi, SolveAndCount) {
+  EXPECT_EQ(SUDOKU_ABI_VERSION, sudoku_abi_version());
+
+  sudoku_solver *solver = sudoku_solver_create(4);
+  ASSERT_NE(nullptr, solver);
+
+  std::array<std::uint8_t, 16> solution{};
+  EXPECT_EQ(SUDOKU_OK, sudoku_solve(solver, SmallGivens.data(), SmallGivens.size(), solution.data(), solution.size()));
+  EXPECT_EQ(SmallSolution, solution);
+
+  // the empty grid has 288 solutions
+  const std::array<std::uint8_t, 16> empty{};
+  std::uint64_t count = 0;
+  EXPECT_EQ(SUDOKU_OK, sudoku_count(solver, empty.data(), empty.size(), 1000, &count));
+  EXPECT_EQ(288, count);
+  EXPECT_EQ(SUDOKU_OK, sudoku_count(solver, empty.data(), empty.size(), 2, &count));
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(SUDOKU_OK, sudoku_count(solver, SmallGivens.data(), SmallGivens.size(), 2, &count));
+  EXPECT_EQ(1, count);
+
+  sudoku_solver_free(solver);
+}
+
+/**
+ * Test: invalid arguments and puzzles are reported as status codes
+ */
+TEST(CApi, Errors) {
+  EXPECT_EQ(nullptr, sudoku_solver_create(5));
+  sudoku_solver_free(nullptr);
+
+  sudoku_solver *solver = sudoku_solver_create(4);
+  ASSERT_NE(nullptr, solver);
+  std::array<std::uint8_t, 16> solution{};
+  std::uint64_t count = 0;
+
+  // conflicting givens, and givens that cannot be completed
+  std::array<std::uint8_t, 16> givens{1, 1};
+  EXPECT_EQ(SUDOKU_NO_SOLUTION, sudoku_solve(solver, givens.data(), givens.size(), solution.data(), solution.size()));
+  EXPECT_EQ(SUDOKU_OK, sudoku_count(solver, givens.data(), givens.size(), 2, &count));
+  EXPECT_EQ(0, count);
+  givens = {1, 2, 3, 0, 0, 0, 0, 4};
+  EXPECT_EQ(SUDOKU_NO_SOLUTION, sudoku_solve(solver, givens.data(), givens.size(), solution.data(), solution.size()));
+
+  // numbers out of range, and buffers of the wrong size
+  givens = {5};
+  EXPECT_EQ(SUDOKU_ERROR_GIVENS, sudoku_solve(solver, givens.data(), givens.size(), solution.data(), solution.size()));
+  EXPECT_EQ(SUDOKU_ERROR_ARGUMENT, sudoku_solve(solver, SmallGivens.data(), 15, solution.data(), 15));
+  EXPECT_EQ(SUDOKU_ERROR_ARGUMENT, sudoku_solve(solver, SmallGivens.data(), 16, nullptr, 16));
+  EXPECT_EQ(SUDOKU_ERROR_ARGUMENT, sudoku_count(solver, SmallGivens.data(), 16, 2, nullptr));
+  EXPECT_EQ(SUDOKU_ERROR_ARGUMENT, sudoku_count(nullptr, SmallGivens.data(), 16, 2, &count));
+
+  // the handle is still usable
+  EXPECT_EQ(SUDOKU_OK, sudoku_solve(solver, SmallGivens.data(), SmallGivens.size(), solution.data(), solution.size()));
+  EXPECT_EQ(SmallSolution, solution);
+
+  sudoku_solver_free(solver);
+}
+
+/**
+ * Test: once a handle is created, solving and counting only allocate from the arena of the handle,
+ * neither from the heap nor from the default memory resource
+ */
+TEST(CApi, NoAllocation) {
+  for (int size : {4, 9, 16}) {
+    // creating a handle allocates its arena from the heap, which is counted
+    const auto created = heap_allocations.load();
+    sudoku_solver *solver = sudoku_solver_create(size);
+    ASSERT_NE(nullptr, solver);
+    EXPECT_LT(created, heap_allocations.load()) << size;
+
+    const auto cells = static_cast<std::size_t>(size * size);
+    std::vector<std::uint8_t> empty(cells, 0);
+    std::vector<std::uint8_t> solution(cells, 0);
+    std::vector<std::uint8_t> solved(cells, 0);
+    std::uint64_t count = 0;
+
+    dlx::CountingMemoryResource counter(std::pmr::null_memory_resource());
+    auto *previous = std::pmr::set_default_resource(&counter);
+    const auto before = heap_allocations.load();
+    int status = SUDOKU_OK;
+    for (int i = 0; i < 3; i++) {
+      // the empty grid needs the most memory, and its solution the least
+      status |= sudoku_solve(solver, empty.data(), cells, solution.data(), cells);
+      status |= sudoku_solve(solver, solution.data(), cells, solved.data(), cells);
+      status |= sudoku_count(solver, empty.data(), cells, 10, &count);
+    }
+    const auto after = heap_allocations.load();
+    std::pmr::set_default_resource(previous);
+
+    EXPECT_EQ(SUDOKU_OK, status) << size;
+    EXPECT_EQ(solution, solved) << size;
+    EXPECT_EQ(10, count) << size;
+    EXPECT_EQ(before, after) << size;
+    EXPECT_EQ(0, counter.getAllocations()) << size;
+
+    sudoku_solver_free(solver);
+  }
+}
+
+/**
+ * Test: the arena of a handle holds what the hardest example needs, without any upstream memory
+ */
+TEST(CApi, LargeArena) {
+  sudoku_solver *solver = sudoku_solver_create(16);
+  ASSERT_NE(nullptr, solver);
+
+  const auto givens = toNumbers(LargeGivens);
+  ASSERT_EQ(256, givens.size());
+  std::vector<std::uint8_t> solution(givens.size(), 0);
+  EXPECT_EQ(SUDOKU_OK, sudoku_solve(solver, givens.data(), givens.size(), solution.data(), solution.size()));
+  EXPECT_EQ(toNumbers(LargeSolution), solution);
+
+  std::uint64_t count = 0;
+  EXPECT_EQ(SUDOKU_OK, sudoku_count(solver, givens.data(), givens.size(), 2, &count));
+  EXPECT_EQ(1, count);
+
+  // the solution itself, as givens, has the longest list of givens
+  EXPECT_EQ(SUDOKU_OK, sudoku_solve(solver, solution.data(), solution.size(), solution.data(), solution.size()));
+
+  sudoku_solver_free(solver);
+}
+
+}  // namespace
@@ -0,0 +1,183 @@
+#include "sudoku.h"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "src/cc/libdlx/dancing-cells-solver.hpp"
+#include "src/cc/libdlx/memory-resource.hpp"
+#include "src/cc/libsudoku/solution.hpp"
+#include "src/cc/libsudoku/sudoku-matrix.hpp"
+
+/**
+ * The state behind a solver handle: a puzzle to fill in with the givens of each call,
+ * and a fixed arena from which the exact cover problem and its solver are allocated.
+ *
+ * The arena is backed by a single buffer, with the null memory resource upstream: once the
+ * buffer is exhausted, allocating throws std::bad_alloc instead of falling back to the heap.
+ * The buffer holds what the worst puzzle of its size needs, see measureCapacity().
+ */
+struct sudoku_solver {
+  sudoku_solver(sudoku::SudokuSize size, std::size_t capacity)
+      : size(size),
+        puzzle(size),
+        capacity(capacity),
+        buffer(std::make_unique<std::byte[]>(capacity)),
+        arena(this->buffer.get(), this->capacity, std::pmr::null_memory_resource()) {}
+
+  // The size of the grid of every puzzle
+  sudoku::SudokuSize size;
+
+  // The puzzle of the current call
+  sudoku::Puzzle puzzle;
+
+  // The buffer of the arena, and its size in bytes
+  std::size_t capacity;
+  std::unique_ptr<std::byte[]> buffer;
+
+  // The arena of the current call, released after every call
+  std::pmr::monotonic_buffer_resource arena;
+};
+
+namespace {
+/**
+ * Helper method to get the memory needed to prepare and search any puzzle of the given size.
+ *
+ * Every allocation grows with the number of rows, columns and nodes of the problem, or with the
+ * depth of the search, which the empty grid has the most of, except for the list of givens, which
+ * a solved grid has the most of. So the allocations of both, searched to their first solution
+ * (the solver reserves its levels up front, and allocates nothing further while searching), bound
+ * those of any puzzle, with each allocation padded to the largest alignment by the arena.
+ */
+auto measureCapacity(sudoku::SudokuSize size) -> std::size_t {
+  const auto digits = static_cast<std::size_t>(size);
+  dlx::CountingMemoryResource counter(std::pmr::new_delete_resource());
+
+  std::vector<std::uint8_t> solution(digits * digits, 0);
+  {
+    auto problem = sudoku::SudokuMatrix::describe(sudoku::Puzzle(size), &counter);
+    dlx::DancingCellsSolver solver(problem.value().problem, &counter);
+    solver.next();
+    sudoku::decodeRows(size, solver.getSolution(), problem.value().placements, solution);
+  }
+
+  sudoku::Puzzle solved(size);
+  for (std::size_t cell = 0; cell < solution.size(); cell++) {
+    solved.setCellValue(static_cast<int>(cell / digits) + 1, static_cast<int>(cell % digits) + 1, solution[cell]);
+  }
+  {
+    auto problem = sudoku::SudokuMatrix::describe(solved, &counter);
+    dlx::DancingCellsSolver solver(problem.value().problem, &counter);
+    solver.next();
+  }
+
+  return counter.getBytesAllocated() + (counter.getAllocations() * alignof(std::max_align_t));
+}
+
+/**
+ * Helper method to prepare the search for the puzzle with the given cells, and run the given
+ * search on it. The arena is released afterwards, whether the search succeeded or not.
+ *
+ * \return the status of the search, or an error status if the puzzle could not be prepared.
+ */
+template <typename Search>
+auto withSearch(sudoku_solver *solver, const std::uint8_t *givens, std::size_t givens_length, Search search) -> int {
+  const auto digits = static_cast<std::size_t>(solver->size);
+  if (givens == nullptr || givens_length != digits * digits) {
+    return SUDOKU_ERROR_ARGUMENT;
+  }
+
+  for (std::size_t cell = 0; cell < givens_length; cell++) {
+    if (givens[cell] > digits) {
+      return SUDOKU_ERROR_GIVENS;
+    }
+    const auto row = static_cast<int>(cell / digits) + 1;
+    const auto column = static_cast<int>(cell % digits) + 1;
+    solver->puzzle.setCellValue(row, column, givens[cell]);
+  }
+
+  int status = SUDOKU_ERROR_INTERNAL;
+  try {
+    auto problem = sudoku::SudokuMatrix::describe(solver->puzzle, &solver->arena);
+    if (!problem.has_value()) {
+      // the givens are in range, so they conflict
+      status = search(nullptr, nullptr);
+    } else {
+      dlx::DancingCellsSolver cells(problem.value().problem, &solver->arena);
+      status = search(&problem.value(), &cells);
+    }
+  } catch (const std::bad_alloc &) {
+    status = SUDOKU_ERROR_MEMORY;
+  } catch (...) {
+    status = SUDOKU_ERROR_INTERNAL;
+  }
+
+  solver->arena.release();
+  return status;
+}
+}  // namespace
+
+extern "C" {
+
+SUDOKU_API auto sudoku_abi_version() -> int {
+  return SUDOKU_ABI_VERSION;
+}
+
+SUDOKU_API auto sudoku_solver_create(int size) -> sudoku_solver * {
+  if (size != static_cast<int>(sudoku::SudokuSize::Four) && size != static_cast<int>(sudoku::SudokuSize::Nine) &&
+      size != static_cast<int>(sudoku::SudokuSize::Sixteen)) {
+    return nullptr;
+  }
+
+  try {
+    const auto sudoku_size = static_cast<sudoku::SudokuSize>(size);
+    return new sudoku_solver(sudoku_size, measureCapacity(sudoku_size));
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+SUDOKU_API void sudoku_solver_free(sudoku_solver *solver) {
+  delete solver;
+}
+
+SUDOKU_API auto sudoku_solve(sudoku_solver *solver, const uint8_t *givens, size_t givens_length, uint8_t *solution,
+                             size_t solution_length) -> int {
+  if (solver == nullptr || solution == nullptr || solution_length != givens_length) {
+    return SUDOKU_ERROR_ARGUMENT;
+  }
+
+  return withSearch(solver, givens, givens_length,
+                    [&](const sudoku::SudokuProblem *problem, dlx::DancingCellsSolver *cells) {
+                      if (cells == nullptr || !cells->next()) {
+                        return SUDOKU_NO_SOLUTION;
+                      }
+
+                      const std::span<std::uint8_t> digits(solution, solution_length);
+                      sudoku::decodeRows(problem->sudoku_size, problem->givens, digits);
+                      sudoku::decodeRows(problem->sudoku_size, cells->getSolution(), problem->placements, digits);
+                      return SUDOKU_OK;
+                    });
+}
+
+SUDOKU_API auto sudoku_count(sudoku_solver *solver, const uint8_t *givens, size_t givens_length, uint64_t limit,
+                             uint64_t *count) -> int {
+  if (solver == nullptr || count == nullptr) {
+    return SUDOKU_ERROR_ARGUMENT;
+  }
+
+  return withSearch(solver, givens, givens_length,
+                    [&](const sudoku::SudokuProblem * /*problem*/, dlx::DancingCellsSolver *cells) {
+                      *count = 0;
+                      while (cells != nullptr && *count < limit && cells->next()) {
+                        (*count)++;
+                      }
+                      return SUDOKU_OK;
+                    });
+}
+
+}  // extern "C"
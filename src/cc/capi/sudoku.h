@@ -0,0 +1,91 @@
+#ifndef CAPI_SUDOKU_H_
+#define CAPI_SUDOKU_H_
+
+/*
+ * A stable C ABI for embedding the Sudoku solver in-process, e.g. from Go via cgo or from Java
+ * via JNI or the foreign function API, instead of spawning the command-line binary.
+ *
+ * A solver handle is created once for a grid size and reused for any number of puzzles of that
+ * size. All memory a puzzle needs is reserved when the handle is created, so that solving and
+ * counting never allocate, and no C++ exception ever crosses this boundary: every failure is
+ * reported as a status code instead. A handle is not thread-safe; use one handle per thread.
+ *
+ * Grids are passed as size * size bytes, row by row, each the number (1..size) of its cell,
+ * or 0 for an empty cell.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SUDOKU_API __attribute__((visibility("default")))
+#else
+#define SUDOKU_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Version of this ABI, incremented on any incompatible change.
+ */
+#define SUDOKU_ABI_VERSION 1
+
+/*
+ * Status codes returned by the functions below. Errors are negative.
+ */
+#define SUDOKU_OK 0
+#define SUDOKU_NO_SOLUTION 1
+#define SUDOKU_ERROR_ARGUMENT (-1)
+#define SUDOKU_ERROR_GIVENS (-2)
+#define SUDOKU_ERROR_MEMORY (-3)
+#define SUDOKU_ERROR_INTERNAL (-4)
+
+/*
+ * An opaque solver handle for puzzles of a single grid size.
+ */
+typedef struct sudoku_solver sudoku_solver;
+
+/*
+ * Get the ABI version of the loaded library, to compare against SUDOKU_ABI_VERSION.
+ */
+SUDOKU_API int sudoku_abi_version(void);
+
+/*
+ * Create a solver handle for grids of the given size: 4, 9 or 16.
+ *
+ * Returns NULL if the size is not supported, or if the memory of the handle cannot be allocated.
+ */
+SUDOKU_API sudoku_solver *sudoku_solver_create(int size);
+
+/*
+ * Free a solver handle created by sudoku_solver_create(). Passing NULL is a no-op.
+ */
+SUDOKU_API void sudoku_solver_free(sudoku_solver *solver);
+
+/*
+ * Solve the puzzle with the given cells, and write the first solution found to solution.
+ *
+ * Both buffers hold size * size cells; givens_length and solution_length are checked against it.
+ * Returns SUDOKU_OK if a solution was written, SUDOKU_NO_SOLUTION if the givens conflict or
+ * cannot be completed, SUDOKU_ERROR_GIVENS if a cell is out of range, or another error.
+ */
+SUDOKU_API int sudoku_solve(sudoku_solver *solver, const uint8_t *givens, size_t givens_length, uint8_t *solution,
+                            size_t solution_length);
+
+/*
+ * Count the solutions of the puzzle with the given cells, stopping at limit.
+ *
+ * For example, a limit of 2 tells whether a puzzle has a unique solution.
+ * Returns SUDOKU_OK with the number of solutions (at most limit) written to count,
+ * SUDOKU_ERROR_GIVENS if a cell is out of range, or another error.
+ */
+SUDOKU_API int sudoku_count(sudoku_solver *solver, const uint8_t *givens, size_t givens_length, uint64_t limit,
+                            uint64_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAPI_SUDOKU_H_ */
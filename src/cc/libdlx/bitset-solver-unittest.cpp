@@ -0,0 +1,124 @@
+#include "bitset-solver.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "solver.hpp"
+#include "test-problems.hpp"
+
+namespace dlx {
+namespace {
+
+/**
+ * Test: rows with a column out of range or listed twice are rejected, without adding a row
+ */
+TEST(BitsetSolver, InvalidRows) {
+  ExactCoverProblem problem(3);
+  EXPECT_EQ(0, problem.addRow({0, 2}));
+  EXPECT_EQ(-1, problem.addRow({0, 3}));
+  EXPECT_EQ(-1, problem.addRow({-1}));
+  EXPECT_EQ(-1, problem.addRow({1, 2, 1}));
+  EXPECT_EQ(1, problem.addRow({1}));
+  ASSERT_EQ(2, problem.getNumRows());
+
+  BitsetSolver solver(problem);
+  auto result = solver.solve();
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ((RowSolution{0, 1}), result.value());
+}
+
+/**
+ * Test: BitsetSolver can solve basic exact cover example problem.
+ */
+TEST(BitsetSolver, Basic) {
+  // Solve the Basic Example from https://en.wikipedia.org/wiki/Exact_cover
+  // covering X = {1,2,3,4} with O = {1,3}, P = {1,2,3} and E = {2,4}
+  ExactCoverProblem problem(4);
+  problem.addRow({0, 2});
+  problem.addRow({0, 1, 2});
+  problem.addRow({1, 3});
+
+  BitsetSolver solver(problem);
+  auto result = solver.solve();
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ((RowSolution{2, 0}), result.value());
+}
+
+/**
+ * Test: BitsetSolver enumerates the same solutions in the same order as Solver, visiting as many nodes.
+ */
+TEST(BitsetSolver, SameOrderAsSolver) {
+  auto problem = describeTwoSolutionProblem();
+
+  BitsetSolver bitset_solver(problem);
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+
+  std::vector<RowSolution> bitset_solutions;
+  while (bitset_solver.next()) {
+    bitset_solutions.push_back(bitset_solver.getSolution());
+  }
+
+  std::vector<RowSolution> solutions;
+  while (solver.next()) {
+    RowSolution rows;
+    for (auto *node : solver.getSolution()) {
+      rows.push_back(node->getData());
+    }
+    solutions.push_back(rows);
+  }
+
+  EXPECT_EQ(2, bitset_solutions.size());
+  EXPECT_EQ(solutions, bitset_solutions);
+  EXPECT_FALSE(bitset_solver.next());
+  EXPECT_EQ(solver.getNodes(), bitset_solver.getNodes());
+}
+
+/**
+ * Test: covered rows are part of every solution, and conflicting rows are rejected.
+ */
+TEST(BitsetSolver, CoverRow) {
+  BitsetSolver solver(describeTwoSolutionProblem());
+
+  // cover D, so that only {C,D} remains
+  EXPECT_TRUE(solver.coverRow(3));
+
+  // B conflicts with D
+  EXPECT_FALSE(solver.coverRow(1));
+
+  // rows outside the problem, also within the last word of the row bitsets
+  EXPECT_FALSE(solver.coverRow(-1));
+  EXPECT_FALSE(solver.coverRow(4));
+  EXPECT_FALSE(solver.coverRow(64));
+
+  ASSERT_TRUE(solver.next());
+  EXPECT_EQ((RowSolution{3, 2}), solver.getSolution());
+  EXPECT_FALSE(solver.next());
+}
+
+/**
+ * Test: a problem with more rows and columns than fit a single word.
+ */
+TEST(BitsetSolver, MultipleWords) {
+  // a chain of 100 columns covered by pairs {i, i+1} for even i, and decoy rows {i+1, i+2}
+  const int num_columns = 100;
+  ExactCoverProblem problem(num_columns);
+  for (int column = 0; column + 1 < num_columns; column += 2) {
+    problem.addRow({column + 1, (column + 2) % num_columns});
+    problem.addRow({column, column + 1});
+  }
+
+  BitsetSolver solver(problem);
+  int count = 0;
+  while (solver.next()) {
+    EXPECT_EQ(num_columns / 2, solver.getSolution().size());
+    count++;
+  }
+
+  // either all pairs, or all decoys (wrapping around)
+  EXPECT_EQ(2, count);
+}
+
+}  // namespace
+}  // namespace dlx
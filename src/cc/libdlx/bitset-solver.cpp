@@ -0,0 +1,236 @@
+#include "bitset-solver.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <utility>
+
+namespace dlx {
+
+/**
+ * Number of bits in a bitset word
+ */
+constexpr int WordBits = 64;
+
+/**
+ * Helper method to get the number of words in a bitset of the given number of bits.
+ */
+static auto wordsFor(int bits) -> std::size_t {
+  return (static_cast<std::size_t>(bits) + WordBits - 1) / WordBits;
+}
+
+/**
+ * Helper method to get the word holding the given bit in a bitset.
+ */
+static auto wordOf(int bit) -> std::size_t {
+  return static_cast<std::size_t>(bit) / WordBits;
+}
+
+/**
+ * Helper method to get the mask selecting the given bit within its word.
+ */
+static auto maskOf(int bit) -> std::uint64_t {
+  return std::uint64_t{1} << (static_cast<unsigned>(bit) % WordBits);
+}
+
+BitsetSolver::BitsetSolver(const ExactCoverProblem &problem, std::pmr::memory_resource *resource)
+    : column_words(wordsFor(problem.getNumColumns())),
+      row_words(wordsFor(problem.getNumRows())),
+      row_columns(resource),
+      row_offsets(resource),
+      column_masks(static_cast<std::size_t>(problem.getNumColumns()) * wordsFor(problem.getNumRows()), 0, resource),
+      active_columns(wordsFor(problem.getNumColumns()), 0, resource),
+      active_rows(wordsFor(problem.getNumRows()), 0, resource),
+      levels(resource),
+      level_words(2 * this->row_words + this->column_words),
+      depth(0),
+      solution(resource),
+      state(SearchState::Fresh),
+      nodes(0) {
+  // Precompute the rows of every column, and keep the columns of every row
+  this->row_offsets.reserve(problem.getNumRows() + 1);
+  this->row_offsets.push_back(0);
+  for (int row = 0; row < problem.getNumRows(); row++) {
+    for (int column : problem.getRow(row)) {
+      this->column_masks[column * this->row_words + wordOf(row)] |= maskOf(row);
+      this->row_columns.push_back(column);
+    }
+    this->row_offsets.push_back(static_cast<int>(this->row_columns.size()));
+    this->active_rows[wordOf(row)] |= maskOf(row);
+  }
+
+  for (int column = 0; column < problem.getNumColumns(); column++) {
+    this->active_columns[wordOf(column)] |= maskOf(column);
+  }
+}
+
+auto BitsetSolver::solve() -> std::optional<RowSolution> {
+  if (this->next()) {
+    // copy using our own allocator, as a plain copy would use the default resource
+    return RowSolution(this->solution, this->solution.get_allocator());
+  }
+
+  return std::nullopt;
+}
+
+// @return if a next solution is found
+auto BitsetSolver::next() -> bool {
+  // whether to descend into a deeper level, or to backtrack and try the next row
+  bool descend = false;
+
+  switch (this->state) {
+    case SearchState::Exhausted:
+      return false;
+    case SearchState::Fresh:
+      descend = true;
+      break;
+    case SearchState::Found:
+      // resume by backtracking from the previously found solution
+      descend = false;
+      break;
+  }
+
+  while (true) {
+    if (descend) {
+      auto selected = this->selectColumn();
+
+      // no columns left, so we have a valid solution
+      if (!selected.has_value()) {
+        this->state = SearchState::Found;
+        return true;
+      }
+
+      auto [column, count] = selected.value();
+
+      // dead end: a column that can no longer be covered, so backtrack
+      if (count == 0) {
+        descend = false;
+        continue;
+      }
+
+      // push a new level, saving the active state and the candidate rows of the column
+      if (this->levels.size() < (this->depth + 1) * this->level_words) {
+        this->levels.resize((this->depth + 1) * this->level_words);
+      }
+      auto *level = this->levels.data() + this->depth * this->level_words;
+      const auto *mask = this->column_masks.data() + column * this->row_words;
+      std::copy(this->active_rows.begin(), this->active_rows.end(), level);
+      std::copy(this->active_columns.begin(), this->active_columns.end(), level + this->row_words);
+      auto *candidates = level + this->row_words + this->column_words;
+      for (std::size_t word = 0; word < this->row_words; word++) {
+        candidates[word] = this->active_rows[word] & mask[word];
+      }
+      this->depth++;
+
+    } else {
+      // backtrack: check if there are levels left to resume
+      if (this->depth == 0) {
+        this->state = SearchState::Exhausted;
+        return false;
+      }
+
+      // remove row from solution, and restore the active state from before it was covered
+      const auto *level = this->levels.data() + (this->depth - 1) * this->level_words;
+      std::copy(level, level + this->row_words, this->active_rows.begin());
+      std::copy(level + this->row_words, level + this->row_words + this->column_words, this->active_columns.begin());
+      this->solution.pop_back();
+    }
+
+    // take the lowest candidate row not yet tried at the current level
+    auto *candidates = this->levels.data() + (this->depth - 1) * this->level_words + this->row_words + this->column_words;
+    std::size_t word = 0;
+    while (word < this->row_words && candidates[word] == 0) {
+      word++;
+    }
+
+    // check if every row in this column has been tried
+    if (word == this->row_words) {
+      // backtrack to the previous level
+      this->depth--;
+      descend = false;
+      continue;
+    }
+
+    const int row = static_cast<int>(word * WordBits) + std::countr_zero(candidates[word]);
+    candidates[word] &= candidates[word] - 1;
+
+    // try solution with current row, covering all its columns
+    this->solution.push_back(row);
+    this->nodes++;
+    this->cover(row);
+
+    // continue the search with this row in the solution and all it's columns covered
+    descend = true;
+  }
+}
+
+auto BitsetSolver::getSolution() const -> const RowSolution & {
+  return this->solution;
+}
+
+auto BitsetSolver::coverRow(int row) -> bool {
+  if (row < 0 || row + 1 >= static_cast<int>(this->row_offsets.size())) {
+    return false;
+  }
+
+  // a row conflicting with the partial solution was removed from the active rows
+  if ((this->active_rows[wordOf(row)] & maskOf(row)) == 0) {
+    return false;
+  }
+
+  this->solution.push_back(row);
+  this->cover(row);
+  return true;
+}
+
+auto BitsetSolver::getNodes() const -> std::uint64_t {
+  return this->nodes;
+}
+
+auto BitsetSolver::selectColumn() const -> std::optional<std::pair<int, int>> {
+  std::optional<std::pair<int, int>> target;
+  int min_count = std::numeric_limits<int>::max();
+
+  // visit every active column, via the set bits of the active columns
+  for (std::size_t column_word = 0; column_word < this->column_words; column_word++) {
+    for (std::uint64_t bits = this->active_columns[column_word]; bits != 0; bits &= bits - 1) {
+      const int column = static_cast<int>(column_word * WordBits) + std::countr_zero(bits);
+      const auto *mask = this->column_masks.data() + column * this->row_words;
+
+      int count = 0;
+      for (std::size_t word = 0; word < this->row_words; word++) {
+        count += std::popcount(this->active_rows[word] & mask[word]);
+      }
+
+      if (count < min_count) {
+        min_count = count;
+        target = std::make_pair(column, count);
+
+        // no column can have a lower count than 1 (or 0, a dead end), so stop looking
+        if (count <= 1) {
+          return target;
+        }
+      }
+    }
+  }
+
+  return target;
+}
+
+void BitsetSolver::cover(int row) {
+  for (int offset = this->row_offsets[row]; offset < this->row_offsets[row + 1]; offset++) {
+    const int column = this->row_columns[offset];
+    const auto *mask = this->column_masks.data() + column * this->row_words;
+
+    // remove the column, indicating this condition is satisfied
+    this->active_columns[wordOf(column)] &= ~maskOf(column);
+
+    // remove all rows in this column, including this row itself,
+    // indicating these are no longer a way to satisfy their conditions
+    for (std::size_t word = 0; word < this->row_words; word++) {
+      this->active_rows[word] &= ~mask[word];
+    }
+  }
+}
+
+}  // namespace dlx
@@ -0,0 +1,260 @@
+#include "checkpoint.hpp"
+
+#include <memory>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "solver.hpp"
+
+namespace dlx {
+namespace {
+
+/**
+ * Test Helper: X = {0..7} covered by rows of single columns, pairs and triples, having many solutions.
+ */
+auto createProblem() -> ExactCoverProblem {
+  ExactCoverProblem problem(8);
+  for (int column = 0; column < 8; column++) {
+    problem.addRow({column});
+    if (column + 1 < 8) {
+      problem.addRow({column, column + 1});
+    }
+    if (column + 2 < 8) {
+      problem.addRow({column, column + 2});
+    }
+  }
+  problem.addRow({0, 7});
+  return problem;
+}
+
+/**
+ * Test Helper: the row indices of the solver's current solution
+ */
+auto solutionRows(const Solver &solver) -> std::vector<int> {
+  std::vector<int> rows;
+  for (auto *node : solver.getSolution()) {
+    rows.push_back(node->getData());
+  }
+  return rows;
+}
+
+/**
+ * Test: a search paused at a checkpoint continues in a fresh solver exactly where it stopped
+ */
+TEST(DLXCheckpoint, PauseAndResume) {
+  auto problem = createProblem();
+
+  Solver sequential(std::make_unique<DancingLinksMatrix>(problem));
+  std::vector<std::vector<int>> expected;
+  while (sequential.next()) {
+    expected.push_back(solutionRows(sequential));
+  }
+  ASSERT_LT(10, expected.size());
+
+  for (std::uint64_t interval : {1, 3, 7}) {
+    // pause at the third checkpoint, which travels through its text format as to another process
+    Solver first(std::make_unique<DancingLinksMatrix>(problem));
+    std::stringstream file;
+    int checkpoints = 0;
+    first.setCheckpointHandler(interval, [&](const Checkpoint &checkpoint) {
+      if (++checkpoints < 3) {
+        return true;
+      }
+      writeCheckpoint(file, checkpoint);
+      return false;
+    });
+
+    std::vector<std::vector<int>> found;
+    while (first.next()) {
+      found.push_back(solutionRows(first));
+    }
+    ASSERT_TRUE(first.isPaused()) << "interval " << interval;
+    EXPECT_LE(3 * interval, first.getNodes());
+    EXPECT_EQ(found.size(), first.getSolutions());
+
+    auto checkpoint = readCheckpoint(file);
+    ASSERT_TRUE(checkpoint.has_value());
+    EXPECT_EQ(CheckpointState::Searching, checkpoint->state);
+
+    Solver second(std::make_unique<DancingLinksMatrix>(problem));
+    ASSERT_TRUE(second.resume(checkpoint.value()));
+    while (second.next()) {
+      found.push_back(solutionRows(second));
+    }
+    EXPECT_FALSE(second.isPaused());
+    EXPECT_EQ(expected, found) << "interval " << interval;
+    EXPECT_EQ(sequential.getNodes(), second.getNodes());
+    EXPECT_EQ(expected.size(), second.getSolutions());
+  }
+}
+
+/**
+ * Test: a cancel predicate pauses the search without taking checkpoints, and the search continues after it
+ */
+TEST(DLXCheckpoint, CancelPredicate) {
+  auto problem = createProblem();
+
+  Solver sequential(std::make_unique<DancingLinksMatrix>(problem));
+  std::vector<std::vector<int>> expected;
+  while (sequential.next()) {
+    expected.push_back(solutionRows(sequential));
+  }
+
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+  std::vector<std::vector<int>> found;
+  int calls = 0;
+  solver.setCancelPredicate(1, [&]() {
+    calls++;
+    return found.size() >= 3;
+  });
+  int checkpoints = 0;
+  solver.setCheckpointHandler(0, [&](const Checkpoint &) {
+    checkpoints++;
+    return true;
+  });
+
+  while (solver.next()) {
+    found.push_back(solutionRows(solver));
+  }
+  ASSERT_TRUE(solver.isPaused());
+  EXPECT_LE(3, found.size());
+  EXPECT_GT(expected.size(), found.size());
+  EXPECT_LT(0, calls);
+  EXPECT_GE(solver.getNodes(), calls);
+  EXPECT_EQ(0, checkpoints);
+
+  // the search continues once the predicate is removed
+  solver.setCancelPredicate(0, nullptr);
+  while (solver.next()) {
+    found.push_back(solutionRows(solver));
+  }
+  EXPECT_FALSE(solver.isPaused());
+  EXPECT_EQ(expected, found);
+  EXPECT_EQ(sequential.getNodes(), solver.getNodes());
+
+  // a cancelled work unit is not exhaustive
+  Solver worker(std::make_unique<DancingLinksMatrix>(problem));
+  worker.setCancelPredicate(1, []() { return true; });
+  auto result = worker.solveUnit(WorkUnit{0, 1, {}, worker.fingerprint()}, true);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_FALSE(result->exhaustive);
+}
+
+/**
+ * Test: checkpoints taken at a solution and after the search, and on request
+ */
+TEST(DLXCheckpoint, FoundAndExhausted) {
+  auto problem = createProblem();
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+  ASSERT_TRUE(solver.coverRow(solver.getMatrix()->getRow(0)));
+  ASSERT_TRUE(solver.next());
+  ASSERT_TRUE(solver.next());
+  const auto second = solutionRows(solver);
+
+  auto found = solver.checkpoint();
+  ASSERT_TRUE(found.has_value());
+  EXPECT_EQ(CheckpointState::Found, found->state);
+  EXPECT_EQ(std::vector<int>{0}, found->inputs);
+  EXPECT_EQ(2, found->solutions);
+
+  // a request is served at the next search node, without an interval
+  int requests = 0;
+  solver.setCheckpointHandler(0, [&](const Checkpoint &) {
+    requests++;
+    return true;
+  });
+  solver.requestCheckpoint();
+  ASSERT_TRUE(solver.next());
+  EXPECT_EQ(1, requests);
+
+  // resuming at a solution continues by backtracking from it
+  Solver resumed(std::make_unique<DancingLinksMatrix>(problem));
+  ASSERT_TRUE(resumed.resume(found.value()));
+  EXPECT_EQ(second, solutionRows(resumed));
+  ASSERT_TRUE(resumed.next());
+  EXPECT_EQ(solutionRows(solver), solutionRows(resumed));
+
+  while (solver.next()) {
+  }
+  auto exhausted = solver.checkpoint();
+  ASSERT_TRUE(exhausted.has_value());
+  EXPECT_EQ(CheckpointState::Exhausted, exhausted->state);
+
+  Solver done(std::make_unique<DancingLinksMatrix>(problem));
+  ASSERT_TRUE(done.resume(exhausted.value()));
+  EXPECT_FALSE(done.next());
+  EXPECT_EQ(solver.getSolutions(), done.getSolutions());
+  EXPECT_EQ(solver.getNodes(), done.getNodes());
+
+  // a saved checkpoint replaces the previous one
+  const auto path = ::testing::TempDir() + "dlx-checkpoint-unittest.checkpoint";
+  ASSERT_TRUE(saveCheckpoint(path, found.value()));
+  ASSERT_TRUE(saveCheckpoint(path, exhausted.value()));
+  auto loaded = loadCheckpoint(path);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(CheckpointState::Exhausted, loaded->state);
+  EXPECT_EQ(exhausted->nodes, loaded->nodes);
+}
+
+/**
+ * Test: checkpoints that do not belong to the problem are rejected
+ */
+TEST(DLXCheckpoint, Invalid) {
+  auto problem = createProblem();
+
+  // the size of the matrix is checked first
+  Checkpoint other_size;
+  Solver sized(std::make_unique<DancingLinksMatrix>(problem));
+  EXPECT_FALSE(sized.resume(other_size));
+
+  Checkpoint conflicting = sized.checkpoint().value();
+  conflicting.inputs = {0, 1};
+  Solver first(std::make_unique<DancingLinksMatrix>(problem));
+  EXPECT_FALSE(first.resume(conflicting));
+
+  // a problem of the same size, with another row
+  ExactCoverProblem other(8);
+  for (int row = 0; row + 1 < problem.getNumRows(); row++) {
+    other.addRow(problem.getRow(row));
+  }
+  other.addRow({1, 6});
+  Solver stranger(std::make_unique<DancingLinksMatrix>(other));
+  ASSERT_TRUE(stranger.next());
+  auto foreign = stranger.checkpoint();
+  ASSERT_TRUE(foreign.has_value());
+  EXPECT_NE(sized.checkpoint()->fingerprint, foreign->fingerprint);
+  Solver resumed(std::make_unique<DancingLinksMatrix>(problem));
+  EXPECT_FALSE(resumed.resume(foreign.value()));
+
+  // row 0 only covers column 0
+  Checkpoint wrong_column = conflicting;
+  wrong_column.inputs.clear();
+  wrong_column.columns = {1};
+  wrong_column.rows = {0};
+  Solver second(std::make_unique<DancingLinksMatrix>(problem));
+  EXPECT_FALSE(second.resume(wrong_column));
+
+  Checkpoint unknown_row = wrong_column;
+  unknown_row.columns = {0};
+  unknown_row.rows = {1000};
+  Solver third(std::make_unique<DancingLinksMatrix>(problem));
+  EXPECT_FALSE(third.resume(unknown_row));
+
+  // a started search cannot be resumed
+  Solver started(std::make_unique<DancingLinksMatrix>(problem));
+  ASSERT_TRUE(started.next());
+  EXPECT_FALSE(started.resume(sized.checkpoint().value()));
+
+  // a randomized search cannot be checkpointed
+  Solver randomized(std::make_unique<DancingLinksMatrix>(problem));
+  randomized.randomize(1);
+  EXPECT_FALSE(randomized.checkpoint().has_value());
+
+  std::istringstream mismatched("dlx-checkpoint 2 8 30 0 0 5 0\n\n0 1\n2\n");
+  EXPECT_FALSE(readCheckpoint(mismatched).has_value());
+  std::istringstream not_a_checkpoint("dlx-unit 2 0 1 0\n0 1\n");
+  EXPECT_FALSE(readCheckpoint(not_a_checkpoint).has_value());
+}
+
+}  // namespace
+}  // namespace dlx
@@ -0,0 +1,105 @@
+#include "checkpoint.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <span>
+
+namespace dlx {
+
+/**
+ * The tag starting every checkpoint, followed by the format version
+ */
+constexpr const char *CheckpointTag = "dlx-checkpoint";
+constexpr int CheckpointVersion = 2;
+
+namespace {
+/**
+ * Helper method to write row or column indices on a single line.
+ */
+void writeIndices(std::ostream &output, std::span<const int> indices) {
+  for (std::size_t i = 0; i < indices.size(); i++) {
+    output << (i == 0 ? "" : " ") << indices[i];
+  }
+  output << '\n';
+}
+
+/**
+ * Helper method to read the row or column indices on the next line.
+ *
+ * \return if the line consists of indices only.
+ */
+auto readIndices(std::istream &input, std::vector<int> &indices) -> bool {
+  std::string line;
+  if (!std::getline(input, line)) {
+    return false;
+  }
+
+  std::istringstream stream(line);
+  int index = 0;
+  while (stream >> index) {
+    if (index < 0) {
+      return false;
+    }
+    indices.push_back(index);
+  }
+  return stream.eof();
+}
+}  // namespace
+
+void writeCheckpoint(std::ostream &output, const Checkpoint &checkpoint) {
+  output << CheckpointTag << ' ' << CheckpointVersion << ' ' << checkpoint.num_columns << ' ' << checkpoint.num_rows
+         << ' ' << checkpoint.fingerprint << ' ' << static_cast<int>(checkpoint.state) << ' ' << checkpoint.nodes << ' ' << checkpoint.solutions << '\n';
+  writeIndices(output, checkpoint.inputs);
+  writeIndices(output, checkpoint.columns);
+  writeIndices(output, checkpoint.rows);
+}
+
+auto readCheckpoint(std::istream &input) -> std::optional<Checkpoint> {
+  Checkpoint checkpoint;
+  std::string tag;
+  int version = 0;
+  int state = 0;
+  if (!(input >> tag >> version >> checkpoint.num_columns >> checkpoint.num_rows >> checkpoint.fingerprint >> state >>
+        checkpoint.nodes >> checkpoint.solutions) ||
+      tag != CheckpointTag ||
+      version != CheckpointVersion || state < 0 || state > static_cast<int>(CheckpointState::Exhausted)) {
+    return std::nullopt;
+  }
+  checkpoint.state = static_cast<CheckpointState>(state);
+
+  // skip the rest of the header line, then read one line of indices each
+  input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  if (!readIndices(input, checkpoint.inputs) || !readIndices(input, checkpoint.columns) ||
+      !readIndices(input, checkpoint.rows) || checkpoint.columns.size() != checkpoint.rows.size()) {
+    return std::nullopt;
+  }
+  return checkpoint;
+}
+
+auto saveCheckpoint(const std::string &path, const Checkpoint &checkpoint) -> bool {
+  const std::string temporary = path + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::trunc);
+    writeCheckpoint(file, checkpoint);
+    file.flush();
+    if (!file) {
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+  return !error;
+}
+
+auto loadCheckpoint(const std::string &path) -> std::optional<Checkpoint> {
+  std::ifstream file(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  return readCheckpoint(file);
+}
+
+}  // namespace dlx
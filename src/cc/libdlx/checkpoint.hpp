@@ -0,0 +1,104 @@
+#ifndef LIBDLX_CHECKPOINT_HPP_
+#define LIBDLX_CHECKPOINT_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace dlx {
+/**
+ * Where the search of a \link Checkpoint was suspended.
+ */
+enum class CheckpointState : std::uint8_t {
+  // Between two search nodes: the search continues by descending below the last row tried
+  Searching,
+
+  // At a solution: the search continues by backtracking from it
+  Found,
+
+  // After all solutions have been enumerated
+  Exhausted
+};
+
+/**
+ * The state of a suspended search, see \link Solver::checkpoint() and \link Solver::resume() .
+ *
+ * Only the path from the top of the search tree to the current node is stored: the column
+ * selected at every level and the row tried in it. The rows of a column are tried in order,
+ * so the row tried is also the position at which the level continues. Everything else, such as
+ * the covered columns and the counts of the headers, follows from covering these rows again.
+ * A checkpoint is hence proportional to the search depth, not to the size of the search.
+ *
+ * Rows are referred to by their index in the \link ExactCoverProblem description, and columns
+ * by their index, so that any process building the same matrix can resume the search. The
+ * fingerprint of the problem, see \link Solver::fingerprint() , rejects a checkpoint resumed by
+ * a process building another matrix, even one of the same size.
+ */
+struct Checkpoint {
+  // The number of columns and rows of the matrix searched, and the fingerprint of the problem,
+  // to reject checkpoints of other problems
+  int num_columns = 0;
+  int num_rows = 0;
+  std::uint64_t fingerprint = 0;
+
+  // Where the search was suspended
+  CheckpointState state = CheckpointState::Searching;
+
+  // Number of search nodes visited, and solutions found, up to the checkpoint
+  std::uint64_t nodes = 0;
+  std::uint64_t solutions = 0;
+
+  // The row indices covered before the search was started, see Solver::coverRow()
+  std::vector<int> inputs;
+
+  // The column selected at every search level, from the top level down
+  std::vector<int> columns;
+
+  // The row tried at every search level, from the top level down
+  std::vector<int> rows;
+};
+
+/**
+ * Called by the \link Solver with a checkpoint of its search, see \link Solver::setCheckpointHandler() .
+ *
+ * \return whether to continue the search. If false, the search is paused right at the checkpoint.
+ */
+using CheckpointHandler = std::function<bool(const Checkpoint &checkpoint)>;
+
+/**
+ * Writes a checkpoint in a line-based text format:
+ *
+ *   dlx-checkpoint <version> <columns> <rows> <fingerprint> <state> <nodes> <solutions>
+ *   <input row> <input row> ...
+ *   <column> <column> ...
+ *   <row> <row> ...
+ */
+void writeCheckpoint(std::ostream &output, const Checkpoint &checkpoint);
+
+/**
+ * Reads a checkpoint, as written by \link writeCheckpoint() .
+ *
+ * \return the checkpoint, or std::nullopt if the input is not a checkpoint.
+ */
+auto readCheckpoint(std::istream &input) -> std::optional<Checkpoint>;
+
+/**
+ * Writes a checkpoint to the given file, replacing it atomically: the checkpoint is written to
+ * a temporary file next to it first, and then renamed. A process stopped while saving leaves
+ * the previous checkpoint intact.
+ *
+ * \return if the checkpoint was written.
+ */
+auto saveCheckpoint(const std::string &path, const Checkpoint &checkpoint) -> bool;
+
+/**
+ * Reads a checkpoint from the given file, see \link readCheckpoint() .
+ */
+auto loadCheckpoint(const std::string &path) -> std::optional<Checkpoint>;
+
+}  // namespace dlx
+
+#endif  // LIBDLX_CHECKPOINT_HPP_
@@ -0,0 +1,110 @@
+#include "count-cache.hpp"
+
+#include <array>
+#include <memory>
+#include <memory_resource>
+
+#include "gtest/gtest.h"
+#include "memory-resource.hpp"
+#include "solver.hpp"
+#include "test-problems.hpp"
+
+namespace dlx {
+namespace {
+
+/**
+ * Test: entries are found after the table has grown, until it is full
+ */
+TEST(DLXCountCache, InsertAndFind) {
+  // room for 4096 slots of a two-word key next to the 2048 slots it grows from, of which at most half are used
+  CountCache cache(2, (4096 + 2048) * 4 * sizeof(std::uint64_t));
+
+  for (std::uint64_t i = 0; i < 2049; i++) {
+    const std::array<std::uint64_t, 2> key = {i, ~i};
+    ASSERT_EQ(i < 2048, cache.insert(key, i * 3)) << i;
+  }
+  EXPECT_EQ(2048, cache.size());
+  EXPECT_TRUE(cache.isFull());
+
+  for (std::uint64_t i = 0; i < 2048; i++) {
+    const std::array<std::uint64_t, 2> key = {i, ~i};
+    ASSERT_EQ(i * 3, cache.find(key)) << i;
+  }
+  const std::array<std::uint64_t, 2> missing = {1, 1};
+  EXPECT_FALSE(cache.find(missing).has_value());
+
+  // without room for both tables while growing, the table stops at the previous size
+  CountCache bounded(2, 4096 * 4 * sizeof(std::uint64_t));
+  for (std::uint64_t i = 0; i < 1025; i++) {
+    const std::array<std::uint64_t, 2> key = {i, ~i};
+    ASSERT_EQ(i < 1024, bounded.insert(key, i)) << i;
+  }
+  EXPECT_TRUE(bounded.isFull());
+
+  // without memory, nothing is stored
+  CountCache none(2, 0);
+  EXPECT_FALSE(none.insert(missing, 1));
+  EXPECT_FALSE(none.find(missing).has_value());
+}
+
+/**
+ * Test: the memoized count equals the enumerated count, with or without room in the cache
+ */
+TEST(DLXCountCache, CountSolutions) {
+  for (int columns : {1, 5, 12}) {
+    auto problem = describeChainProblem(columns);
+    Solver enumerated(std::make_unique<DancingLinksMatrix>(problem));
+    const auto expected = enumerate(enumerated).size();
+
+    for (std::size_t bytes : {std::size_t{0}, std::size_t{256}, DefaultCountCacheBytes}) {
+      Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+      auto count = solver.countSolutions(bytes);
+      ASSERT_TRUE(count.has_value());
+      EXPECT_EQ(expected, count->solutions) << columns << " columns, " << bytes << " bytes";
+      EXPECT_FALSE(count->saturated);
+
+      // the matrix is restored, so the search enumerates the same solutions afterwards
+      EXPECT_EQ(expected, enumerate(solver).size());
+    }
+  }
+
+  // the subproblems of the tribonacci-like problem are its suffixes
+  Solver memoized(std::make_unique<DancingLinksMatrix>(describeChainProblem(40)));
+  memoized.coverRow(memoized.getMatrix()->getRow(0));
+  auto count = memoized.countSolutions();
+  ASSERT_TRUE(count.has_value());
+  EXPECT_EQ(12960201916, count->solutions);
+  EXPECT_GT(200, count->nodes);
+  EXPECT_LT(0, count->hits);
+  EXPECT_FALSE(count->cache_full);
+
+  // a started search cannot be counted
+  EXPECT_TRUE(memoized.next());
+  EXPECT_FALSE(memoized.countSolutions().has_value());
+}
+
+/**
+ * Test: the cache of a matrix built in an arena is not allocated from the arena, whose memory
+ * would never be released as the table grows, and its memory is returned afterwards
+ */
+TEST(DLXCountCache, ArenaMemory) {
+  constexpr std::size_t MaxBytes = std::size_t{64} << 10U;
+
+  std::pmr::monotonic_buffer_resource arena;
+  CountingMemoryResource arena_counter(&arena);
+  Solver solver(std::make_unique<DancingLinksMatrix>(describeChainProblem(200), &arena_counter));
+  const auto built = arena_counter.getBytesAllocated();
+
+  CountingMemoryResource cache_counter;
+  auto count = solver.countSolutions(MaxBytes, &cache_counter);
+  ASSERT_TRUE(count.has_value());
+  EXPECT_TRUE(count->saturated);
+  EXPECT_LT(0, count->subproblems);
+
+  EXPECT_EQ(built, arena_counter.getBytesAllocated());
+  EXPECT_LT(0, cache_counter.getAllocations());
+  EXPECT_EQ(cache_counter.getAllocations(), cache_counter.getDeallocations());
+}
+
+}  // namespace
+}  // namespace dlx
@@ -0,0 +1,112 @@
+#include "count-cache.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace dlx {
+
+/**
+ * Number of slots of a new table
+ */
+constexpr std::size_t InitialSlots = 1024;
+
+/**
+ * Odd multiplier and shifts of the key hash (from the splitmix64 finalizer)
+ */
+constexpr std::uint64_t HashMultiplier = 0x9E3779B97F4A7C15ULL;
+constexpr std::uint64_t MixMultiplier = 0xBF58476D1CE4E5B9ULL;
+constexpr unsigned MixShift = 31;
+
+CountCache::CountCache(std::size_t words, std::size_t max_bytes, std::pmr::memory_resource *resource)
+    : words(words), stride(words + 2), max_slots(0), entries(0), full(false), slots(resource) {
+  // the largest power of two of slots that fits in the given memory
+  const std::size_t fitting = max_bytes / (this->stride * sizeof(std::uint64_t));
+  this->max_slots = fitting == 0 ? 0 : std::bit_floor(fitting);
+
+  // growing into the largest table holds the previous table of half its size as well
+  if (this->max_slots > InitialSlots && this->max_slots + (this->max_slots / 2) > fitting) {
+    this->max_slots /= 2;
+  }
+  if (this->max_slots > 0) {
+    this->slots.resize(std::min(InitialSlots, this->max_slots) * this->stride, 0);
+  }
+}
+
+auto CountCache::hash(std::span<const std::uint64_t> key) const -> std::uint64_t {
+  std::uint64_t hash = 0;
+  for (auto word : key) {
+    hash = (hash ^ word) * HashMultiplier;
+  }
+  hash = (hash ^ (hash >> MixShift)) * MixMultiplier;
+  return hash | 1U;
+}
+
+auto CountCache::probe(std::span<const std::uint64_t> key, std::uint64_t hash) const -> std::size_t {
+  const std::size_t mask = (this->slots.size() / this->stride) - 1;
+  for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    const auto *entry = this->slots.data() + (slot * this->stride);
+    if (entry[0] == 0 || (entry[0] == hash && std::equal(key.begin(), key.end(), entry + 2))) {
+      return slot;
+    }
+  }
+}
+
+auto CountCache::find(std::span<const std::uint64_t> key) const -> std::optional<std::uint64_t> {
+  if (this->slots.empty()) {
+    return std::nullopt;
+  }
+
+  const auto hash = this->hash(key);
+  const auto *entry = this->slots.data() + (this->probe(key, hash) * this->stride);
+  if (entry[0] == 0) {
+    return std::nullopt;
+  }
+  return entry[1];
+}
+
+auto CountCache::insert(std::span<const std::uint64_t> key, std::uint64_t count) -> bool {
+  // keep the table at most half full, so that probes stay short
+  const std::size_t num_slots = this->slots.size() / this->stride;
+  if (2 * (this->entries + 1) > num_slots) {
+    if (num_slots >= this->max_slots) {
+      this->full = true;
+      return false;
+    }
+    this->grow();
+  }
+
+  const auto hash = this->hash(key);
+  auto *entry = this->slots.data() + (this->probe(key, hash) * this->stride);
+  entry[0] = hash;
+  entry[1] = count;
+  std::copy(key.begin(), key.end(), entry + 2);
+  this->entries++;
+  return true;
+}
+
+void CountCache::grow() {
+  std::pmr::vector<std::uint64_t> previous(this->slots.size() * 2, 0, this->slots.get_allocator());
+  previous.swap(this->slots);
+
+  // re-insert every entry into the larger table, reusing its hash
+  for (std::size_t offset = 0; offset < previous.size(); offset += this->stride) {
+    const auto *entry = previous.data() + offset;
+    if (entry[0] == 0) {
+      continue;
+    }
+
+    const std::span<const std::uint64_t> key(entry + 2, this->words);
+    auto *target = this->slots.data() + (this->probe(key, entry[0]) * this->stride);
+    std::copy(entry, entry + this->stride, target);
+  }
+}
+
+auto CountCache::size() const -> std::size_t {
+  return this->entries;
+}
+
+auto CountCache::isFull() const -> bool {
+  return this->full;
+}
+
+}  // namespace dlx
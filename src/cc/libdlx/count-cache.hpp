@@ -0,0 +1,121 @@
+#ifndef LIBDLX_COUNT_CACHE_HPP_
+#define LIBDLX_COUNT_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dlx {
+/**
+ * Memory available to a \link CountCache , if not specified: 256 MiB
+ */
+constexpr std::size_t DefaultCountCacheBytes = std::size_t{256} << 20U;
+
+/**
+ * The outcome of counting the solutions of an exact cover problem, see \link Solver::countSolutions() .
+ */
+struct CountResult {
+  // Number of solutions, or UINT64_MAX if saturated
+  std::uint64_t solutions = 0;
+
+  // Whether the number of solutions exceeds UINT64_MAX
+  bool saturated = false;
+
+  // Number of search nodes visited, i.e., rows tried
+  std::uint64_t nodes = 0;
+
+  // Number of distinct subproblems stored in the cache, and number of subproblems found in it
+  std::uint64_t subproblems = 0;
+  std::uint64_t hits = 0;
+
+  // Whether the cache ran out of memory, so that later subproblems were counted without it
+  bool cache_full = false;
+};
+
+/**
+ * A CountCache maps a set of active columns to the number of exact covers of those columns.
+ *
+ * In an exact cover problem, the rows remaining after covering some rows are exactly the rows
+ * whose columns are all still active. The number of ways to complete a partial solution thus
+ * only depends on its set of active columns. Different partial solutions often leave the same
+ * columns, such as the same digits placed in a different order, and the cache lets their
+ * subproblem be counted once (ref: Knuth, "Dancing links", The Art of Computer Programming,
+ * Volume 4B, on memoizing exact cover counts in algorithm DXZ).
+ *
+ * A key is a bitset of the active columns, as uint64_t words. Entries are stored in a single
+ * open-addressing table with linear probing, each slot holding the hash, the count and the key
+ * inline, so a lookup touches one or two cache lines. The table doubles as it fills, up to the
+ * memory given at construction, which also holds the previous table while the entries move into
+ * the doubled one. When full, no further entries are stored; lookups still work.
+ */
+class CountCache {
+ public:
+  /**
+   * Constructs an empty cache for keys of the given number of words.
+   *
+   * \param max_bytes The memory the table may grow to, including the previous table while it doubles.
+   *                  Below the size of a few slots, nothing is cached.
+   * \param resource The memory resource from which the table is allocated.
+   */
+  CountCache(std::size_t words, std::size_t max_bytes,
+             std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Look up the count stored for the given key.
+   */
+  [[nodiscard]] auto find(std::span<const std::uint64_t> key) const -> std::optional<std::uint64_t>;
+
+  /**
+   * Store the count for the given key, which must not be stored yet.
+   *
+   * \return if the count was stored. If false, the cache is full.
+   */
+  auto insert(std::span<const std::uint64_t> key, std::uint64_t count) -> bool;
+
+  /**
+   * Get the number of stored entries.
+   */
+  [[nodiscard]] auto size() const -> std::size_t;
+
+  /**
+   * Get if an entry could not be stored because the cache is full.
+   */
+  [[nodiscard]] auto isFull() const -> bool;
+
+ private:
+  // The number of words of a key, and of a slot: the hash, the count, and the key
+  std::size_t words;
+  std::size_t stride;
+
+  // The number of slots the table may grow to, a power of two
+  std::size_t max_slots;
+
+  // The number of stored entries, and if an entry was rejected
+  std::size_t entries;
+  bool full;
+
+  // The slots, of which a slot with hash 0 is empty
+  std::pmr::vector<std::uint64_t> slots;
+
+  /**
+   * Helper method to hash a key. The hash is never 0, which marks an empty slot.
+   */
+  [[nodiscard]] auto hash(std::span<const std::uint64_t> key) const -> std::uint64_t;
+
+  /**
+   * Helper method to get the slot of the given key, or the empty slot it would be stored in.
+   */
+  [[nodiscard]] auto probe(std::span<const std::uint64_t> key, std::uint64_t hash) const -> std::size_t;
+
+  /**
+   * Helper method to double the number of slots, keeping all entries.
+   */
+  void grow();
+};
+
+}  // namespace dlx
+
+#endif  // LIBDLX_COUNT_CACHE_HPP_
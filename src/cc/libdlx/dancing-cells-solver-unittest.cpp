@@ -0,0 +1,125 @@
+#include "dancing-cells-solver.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "solver.hpp"
+#include "test-problems.hpp"
+
+namespace dlx {
+namespace {
+
+/**
+ * Test Helper: expect both engines to enumerate the same solutions, as sorted row indices
+ */
+void expectSameSolutions(const ExactCoverProblem &problem) {
+  DancingCellsSolver cells(problem);
+  std::vector<std::vector<int>> cells_solutions;
+  while (cells.next()) {
+    std::vector<int> rows(cells.getSolution().begin(), cells.getSolution().end());
+    std::ranges::sort(rows);
+    cells_solutions.push_back(rows);
+  }
+  std::ranges::sort(cells_solutions);
+
+  Solver links(std::make_unique<DancingLinksMatrix>(problem));
+  auto links_solutions = enumerate(links);
+  std::ranges::sort(links_solutions);
+
+  EXPECT_EQ(links_solutions, cells_solutions);
+  EXPECT_FALSE(cells.next());
+}
+
+/**
+ * Test: DancingCellsSolver can solve basic exact cover example problem.
+ */
+TEST(DancingCellsSolver, Basic) {
+  // Solve the Basic Example from https://en.wikipedia.org/wiki/Exact_cover
+  // covering X = {1,2,3,4} with O = {1,3}, P = {1,2,3} and E = {2,4}
+  ExactCoverProblem problem(4);
+  problem.addRow({0, 2});
+  problem.addRow({0, 1, 2});
+  problem.addRow({1, 3});
+
+  DancingCellsSolver solver(problem);
+  auto result = solver.solve();
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ((RowSolution{2, 0}), result.value());
+  EXPECT_FALSE(solver.solve().has_value());
+}
+
+/**
+ * Test: DancingCellsSolver enumerates the same solutions as Solver, and restores its sets on backtracking.
+ */
+TEST(DancingCellsSolver, SameSolutionsAsSolver) {
+  expectSameSolutions(describeTwoSolutionProblem());
+  for (int columns : {1, 2, 7, 12}) {
+    expectSameSolutions(describeChainProblem(columns));
+  }
+
+  // a problem without solutions
+  ExactCoverProblem problem(2);
+  problem.addRow({0});
+  DancingCellsSolver solver(problem);
+  EXPECT_FALSE(solver.next());
+  EXPECT_FALSE(solver.next());
+}
+
+/**
+ * Test: rows outside the problem are rejected, and an empty row is covered without covering a column.
+ */
+TEST(DancingCellsSolver, CoverInvalidAndEmptyRows) {
+  auto problem = describeTwoSolutionProblem();
+  EXPECT_EQ(4, problem.addRow({}));
+  DancingCellsSolver solver(problem);
+
+  EXPECT_FALSE(solver.coverRow(-1));
+  EXPECT_FALSE(solver.coverRow(5));
+
+  // the empty row is part of both solutions, and leaves every column to the search
+  EXPECT_TRUE(solver.coverRow(4));
+  int count = 0;
+  while (solver.next()) {
+    EXPECT_EQ(4, solver.getSolution().front());
+    EXPECT_EQ(3, solver.getSolution().size());
+    count++;
+  }
+  EXPECT_EQ(2, count);
+}
+
+/**
+ * Test: covered rows are part of every solution, and conflicting rows are rejected.
+ */
+TEST(DancingCellsSolver, CoverRow) {
+  DancingCellsSolver solver(describeTwoSolutionProblem());
+
+  // cover D, so that only {C,D} remains
+  EXPECT_TRUE(solver.coverRow(3));
+
+  // B conflicts with D
+  EXPECT_FALSE(solver.coverRow(1));
+
+  ASSERT_TRUE(solver.next());
+  EXPECT_EQ((RowSolution{3, 2}), solver.getSolution());
+  EXPECT_FALSE(solver.next());
+
+  // covering the first single column leaves the solutions of the remaining chain
+  DancingCellsSolver chain(describeChainProblem(12));
+  EXPECT_TRUE(chain.coverRow(0));
+  EXPECT_FALSE(chain.coverRow(1));
+  int count = 0;
+  while (chain.next()) {
+    EXPECT_EQ(0, chain.getSolution().front());
+    count++;
+  }
+
+  // the number of compositions of 11 into parts 1, 2 and 3 (tribonacci)
+  EXPECT_EQ(504, count);
+  EXPECT_LT(0, chain.getNodes());
+}
+
+}  // namespace
+}  // namespace dlx
@@ -0,0 +1,271 @@
+#include "dancing-cells-solver.hpp"
+
+#include <limits>
+
+namespace dlx {
+
+DancingCellsSolver::DancingCellsSolver(const ExactCoverProblem &problem, std::pmr::memory_resource *resource)
+    : columns(resource),
+      column_positions(resource),
+      num_active(problem.getNumColumns()),
+      set_starts(resource),
+      set_sizes(static_cast<std::size_t>(problem.getNumColumns()), 0, resource),
+      set(resource),
+      node_columns(resource),
+      node_positions(resource),
+      node_rows(resource),
+      row_starts(resource),
+      levels(resource),
+      solution(resource),
+      state(SearchState::Fresh),
+      nodes(0) {
+  // All columns start active, in order
+  this->columns.reserve(problem.getNumColumns());
+  this->column_positions.reserve(problem.getNumColumns());
+  for (int column = 0; column < problem.getNumColumns(); column++) {
+    this->columns.push_back(column);
+    this->column_positions.push_back(column);
+  }
+
+  // Number the nodes row by row, and count the rows of every column
+  this->row_starts.reserve(problem.getNumRows() + 1);
+  for (int row = 0; row < problem.getNumRows(); row++) {
+    this->row_starts.push_back(static_cast<int>(this->node_columns.size()));
+    for (int column : problem.getRow(row)) {
+      this->node_columns.push_back(column);
+      this->node_rows.push_back(row);
+      this->set_sizes[column]++;
+    }
+  }
+  this->row_starts.push_back(static_cast<int>(this->node_columns.size()));
+
+  // Lay out the segments of the columns back to back, then fill them in row order
+  this->set_starts.reserve(problem.getNumColumns());
+  int start = 0;
+  for (int column = 0; column < problem.getNumColumns(); column++) {
+    this->set_starts.push_back(start);
+    start += this->set_sizes[column];
+    this->set_sizes[column] = 0;
+  }
+
+  this->set.resize(this->node_columns.size());
+  this->node_positions.resize(this->node_columns.size());
+  for (int node = 0; node < static_cast<int>(this->node_columns.size()); node++) {
+    const int column = this->node_columns[node];
+    const int position = this->set_starts[column] + this->set_sizes[column]++;
+    this->set[position] = node;
+    this->node_positions[node] = position;
+  }
+
+  // every level and every row of a solution covers at least one column,
+  // so that the search itself never allocates
+  this->levels.reserve(problem.getNumColumns());
+  this->solution.reserve(problem.getNumColumns());
+}
+
+auto DancingCellsSolver::solve() -> std::optional<RowSolution> {
+  if (this->next()) {
+    // copy using our own allocator, as a plain copy would use the default resource
+    return RowSolution(this->solution, this->solution.get_allocator());
+  }
+
+  return std::nullopt;
+}
+
+// @return if a next solution is found
+auto DancingCellsSolver::next() -> bool {
+  // whether to descend into a deeper level, or to backtrack and try the next row
+  bool descend = false;
+
+  switch (this->state) {
+    case SearchState::Exhausted:
+      return false;
+    case SearchState::Fresh:
+      descend = true;
+      break;
+    case SearchState::Found:
+      // resume by backtracking from the previously found solution
+      descend = false;
+      break;
+  }
+
+  while (true) {
+    if (descend) {
+      auto selected = this->selectColumn();
+
+      // no columns left, so we have a valid solution
+      if (!selected.has_value()) {
+        this->state = SearchState::Found;
+        return true;
+      }
+
+      // dead end: a column that can no longer be covered, so backtrack
+      const int column = selected.value();
+      if (this->set_sizes[column] == 0) {
+        descend = false;
+        continue;
+      }
+
+      // cover this column and start with the first of its rows
+      this->cover(column);
+      this->levels.push_back(Level{column, 0});
+
+    } else {
+      // backtrack: check if there are levels left to resume
+      if (this->levels.empty()) {
+        this->state = SearchState::Exhausted;
+        return false;
+      }
+
+      // remove row from solution, and uncover its other columns, so we may try the next row
+      auto &level = this->levels.back();
+      this->solution.pop_back();
+      this->uncoverOthers(this->set[this->set_starts[level.column] + level.position]);
+      level.position++;
+    }
+
+    // check if every row in this column has been tried
+    auto &level = this->levels.back();
+    if (level.position == this->set_sizes[level.column]) {
+      // uncover column and backtrack to the previous level
+      this->uncover(level.column);
+      this->levels.pop_back();
+      descend = false;
+      continue;
+    }
+
+    // try solution with current row, covering all its other columns
+    const int node = this->set[this->set_starts[level.column] + level.position];
+    this->solution.push_back(this->node_rows[node]);
+    this->nodes++;
+    this->coverOthers(node);
+
+    // continue the search with this row in the solution and all it's columns covered
+    descend = true;
+  }
+}
+
+auto DancingCellsSolver::getSolution() const -> const RowSolution & {
+  return this->solution;
+}
+
+auto DancingCellsSolver::coverRow(int row) -> bool {
+  if (row < 0 || row + 1 >= static_cast<int>(this->row_starts.size())) {
+    return false;
+  }
+
+  // a row is still active as long as none of its columns is covered
+  for (int node = this->row_starts[row]; node < this->row_starts[row + 1]; node++) {
+    if (this->column_positions[this->node_columns[node]] >= this->num_active) {
+      return false;
+    }
+  }
+
+  this->solution.push_back(row);
+
+  // a row without columns covers nothing
+  const int first = this->row_starts[row];
+  if (first < this->row_starts[row + 1]) {
+    this->cover(this->node_columns[first]);
+    this->coverOthers(first);
+  }
+  return true;
+}
+
+auto DancingCellsSolver::getNodes() const -> std::uint64_t {
+  return this->nodes;
+}
+
+auto DancingCellsSolver::selectColumn() const -> std::optional<int> {
+  std::optional<int> target;
+  int min_size = std::numeric_limits<int>::max();
+
+  // the active columns are the first num_active entries of a contiguous array
+  for (int position = 0; position < this->num_active; position++) {
+    const int column = this->columns[position];
+    const int size = this->set_sizes[column];
+    if (size < min_size) {
+      min_size = size;
+      target = column;
+
+      // no column can have a lower size than 1 (or 0, a dead end), so stop looking
+      if (size <= 1) {
+        break;
+      }
+    }
+  }
+
+  return target;
+}
+
+void DancingCellsSolver::cover(int column) {
+  // swap the column with the last active column, and shrink the active columns past it
+  const int position = this->column_positions[column];
+  const int last = this->columns[--this->num_active];
+  this->columns[position] = last;
+  this->column_positions[last] = position;
+  this->columns[this->num_active] = column;
+  this->column_positions[column] = this->num_active;
+
+  // hide all rows in this column from the other columns they are in,
+  // by swapping each node past the end of the active part of its column's segment
+  const int start = this->set_starts[column];
+  const int end = start + this->set_sizes[column];
+  for (int index = start; index < end; index++) {
+    const int row_node = this->set[index];
+    const int row = this->node_rows[row_node];
+    for (int node = this->row_starts[row]; node < this->row_starts[row + 1]; node++) {
+      if (node == row_node) {
+        continue;
+      }
+
+      const int other = this->node_columns[node];
+      const int from = this->node_positions[node];
+      const int to = this->set_starts[other] + --this->set_sizes[other];
+      const int swapped = this->set[to];
+      this->set[from] = swapped;
+      this->node_positions[swapped] = from;
+      this->set[to] = node;
+      this->node_positions[node] = to;
+    }
+  }
+}
+
+void DancingCellsSolver::uncover(int column) {
+  // unhide the rows in the reverse order, so that every node is right at the end of the active
+  // part of its column's segment again, and growing the segment reinserts it
+  const int start = this->set_starts[column];
+  for (int index = start + this->set_sizes[column] - 1; index >= start; index--) {
+    const int row_node = this->set[index];
+    const int row = this->node_rows[row_node];
+    for (int node = this->row_starts[row + 1] - 1; node >= this->row_starts[row]; node--) {
+      if (node != row_node) {
+        this->set_sizes[this->node_columns[node]]++;
+      }
+    }
+  }
+
+  // the column was swapped right past the active columns, so growing them reinserts it
+  this->num_active++;
+}
+
+void DancingCellsSolver::coverOthers(int node) {
+  const int row = this->node_rows[node];
+  for (int other = this->row_starts[row]; other < this->row_starts[row + 1]; other++) {
+    if (other != node) {
+      this->cover(this->node_columns[other]);
+    }
+  }
+}
+
+void DancingCellsSolver::uncoverOthers(int node) {
+  // columns are uncovered in the reverse order of covering
+  const int row = this->node_rows[node];
+  for (int other = this->row_starts[row + 1] - 1; other >= this->row_starts[row]; other--) {
+    if (other != node) {
+      this->uncover(this->node_columns[other]);
+    }
+  }
+}
+
+}  // namespace dlx
@@ -0,0 +1,170 @@
+#ifndef LIBDLX_DANCING_CELLS_SOLVER_HPP_
+#define LIBDLX_DANCING_CELLS_SOLVER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+#include "bitset-solver.hpp"
+#include "exact-cover-problem.hpp"
+
+namespace dlx {
+/**
+ * The DancingCellsSolver implements Algorithm X on sparse sets ("dancing cells") instead of
+ * doubly linked lists (ref: Knuth, "Dancing cells", The Art of Computer Programming, Volume 4B,
+ * Section 7.2.2.3).
+ *
+ * All state lives in a few dense arrays of ints, indexed by column, row or node:
+ *  - The active columns form a sparse set: the first num_active entries of an array of columns,
+ *    with the position of every column in it. A column is removed by swapping it with the last
+ *    active column, and reinserted by growing the set again, in reverse order of removal.
+ *  - The rows of each column form a sparse set as well, within a segment of one array of nodes:
+ *    the first size entries of the segment are the rows still active in that column. A row is
+ *    hidden from a column by swapping its node to the end of the active part, and unhidden by
+ *    incrementing the size again, so uncovering needs no swaps at all.
+ *  - The nodes of every row are stored consecutively, each with its column and its position in
+ *    that column's segment.
+ * Selecting a column scans a contiguous array, and covering touches consecutive nodes, which is
+ * far more cache-friendly than chasing pointers through the nodes of \link DancingLinksMatrix .
+ *
+ * The solver takes the same \link ExactCoverProblem description as \link DancingLinksMatrix and
+ * offers the same API as \link Solver , in terms of row indices like \link BitsetSolver . As rows
+ * are swapped within their columns, solutions may be found in a different order than by Solver.
+ */
+class DancingCellsSolver {
+ public:
+  /**
+   * Constructs a new solver for the given problem description.
+   *
+   * \param resource The memory resource from which the sets and solutions are allocated.
+   */
+  explicit DancingCellsSolver(const ExactCoverProblem &problem,
+                              std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Solve the problem, see \link Solver::solve() .
+   *
+   * \return If no solution is found, std::nullopt is returned.
+   *         If a solution is found, the indices of the chosen rows are returned.
+   */
+  auto solve() -> std::optional<RowSolution>;
+
+  /**
+   * Resume the search until the next solution is found, see \link Solver::next() .
+   *
+   * \return if a next solution was found, available via \link getSolution() .
+   *         If false, all solutions have been enumerated.
+   */
+  auto next() -> bool;
+
+  /**
+   * Get the solution found by the last successful call to \link next() ,
+   * including the rows covered before the search.
+   *
+   * The reference is only valid until the search is resumed.
+   */
+  [[nodiscard]] auto getSolution() const -> const RowSolution &;
+
+  /**
+   * Cover a given row, marking it as predetermined input to the exact cover solution,
+   * see \link Solver::coverRow() .
+   *
+   * Rows can only be covered before the search is started.
+   *
+   * \return if the row could be covered. If false, the row is not a row of the problem, or it
+   *         conflicts with a previously covered row and the problem has no solution;
+   *         the solver state is unchanged.
+   */
+  auto coverRow(int row) -> bool;
+
+  /**
+   * Get the number of search nodes visited so far, see \link Solver::getNodes() .
+   */
+  [[nodiscard]] auto getNodes() const -> std::uint64_t;
+
+ private:
+  /**
+   * The state of the resumable search.
+   */
+  enum class SearchState : std::uint8_t {
+    // The search has not been started yet
+    Fresh,
+
+    // The search is suspended at a solution
+    Found,
+
+    // All solutions have been enumerated
+    Exhausted
+  };
+
+  /**
+   * A column selected at a search level, and the position in its segment of the row tried.
+   */
+  struct Level {
+    int column;
+    int position;
+  };
+
+  // The active columns, of which the first num_active are active, and the position of each column
+  std::pmr::vector<int> columns;
+  std::pmr::vector<int> column_positions;
+  int num_active;
+
+  // For every column, the start of its segment in set and its number of active rows
+  std::pmr::vector<int> set_starts;
+  std::pmr::vector<int> set_sizes;
+
+  // The segments of all columns, each listing the nodes of the rows in that column
+  std::pmr::vector<int> set;
+
+  // For every node: its column, and its position in the segment of that column
+  std::pmr::vector<int> node_columns;
+  std::pmr::vector<int> node_positions;
+
+  // For every node its row, and for every row the index of its first node (plus one past the last row)
+  std::pmr::vector<int> node_rows;
+  std::pmr::vector<int> row_starts;
+
+  // The column selected at every search level, and the row tried in it
+  std::pmr::vector<Level> levels;
+
+  // The (partial) solution constructed during solving
+  RowSolution solution;
+
+  // The state of the resumable search
+  SearchState state;
+
+  // The number of search nodes visited so far
+  std::uint64_t nodes;
+
+  /**
+   * Helper method to find the active column with the fewest active rows.
+   *
+   * \return the column, or std::nullopt if no columns are left.
+   */
+  [[nodiscard]] auto selectColumn() const -> std::optional<int>;
+
+  /**
+   * Helper method to remove the given column from the active columns, and hide all of its rows
+   * from the other columns they are in. Its own segment is left untouched.
+   */
+  void cover(int column);
+
+  /**
+   * Helper method to undo \link cover() . Columns must be uncovered in reverse order of covering.
+   */
+  void uncover(int column);
+
+  /**
+   * Helper method to cover the columns of all nodes in the row of the given node other than itself,
+   * and its reverse to uncover them again.
+   */
+  void coverOthers(int node);
+  void uncoverOthers(int node);
+};
+
+}  // namespace dlx
+
+#endif  // LIBDLX_DANCING_CELLS_SOLVER_HPP_
@@ -1,5 +1,8 @@
 #include "dancing-link-node.hpp"
 
+#include <memory>
+
+#include "dancing-links-matrix.hpp"
 #include "gtest/gtest.h"
 
 namespace dlx {
@@ -116,8 +119,9 @@ TEST(DancingLinkNode, VerticalList) {
 }
 
 TEST(DancingLinkNode, HeaderConstructor) {
-  std::unique_ptr<DancingLinkHeader> header = std::make_unique<DancingLinkHeader>();
-  auto *node1 = header.get();
+  DancingLinksMatrix matrix;
+  auto *header = matrix.newHeader();
+  auto *node1 = header;
   auto *node2 = header->newNode();
   auto *node3 = header->newNode();
 
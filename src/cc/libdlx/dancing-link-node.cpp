@@ -1,5 +1,7 @@
 #include "dancing-link-node.hpp"
 
+#include "dancing-links-matrix.hpp"
+
 // https://en.wikipedia.org/wiki/Dancing_Links
 namespace dlx {
 
@@ -41,97 +43,27 @@ void DancingLinkNode::insertUpOf(DancingLinkNode *other) {
   this->down = other;
 }
 
-void DancingLinkNode::removeHorizontal() {
-  // Before:
-  //  ... <-> [left] <-> [this] <-> [right] <-> ...
-  // After:
-  //  ... <-> [left] <-> [right] <-> ...
-  // With the references in this still intact:
-  //           [left] <- [this] -> [right]
-  this->right->left = this->left;
-  this->left->right = this->right;
-}
-
-void DancingLinkNode::removeVertical() {
-  // Before:
-  //  ... <-> [up] <-> [this] <-> [down] <-> ...
-  // After:
-  //  ... <-> [up] <-> [down] <-> ...
-  // With the references in this still intact:
-  //           [up] <- [this] -> [down]
-  this->up->down = this->down;
-  this->down->up = this->up;
-}
-
-void DancingLinkNode::reinsertHorizontal() {
-  // Before:
-  //  ... <-> [left] <-> [right] <-> ...
-  // After:
-  //  ... <-> [left] <-> [this] <-> [right] <-> ...
-  this->left->right = this;
-  this->right->left = this;
-}
-
-void DancingLinkNode::reinsertVertical() {
-  // Before:
-  //  ... <-> [up] <-> [down] <-> ...
-  // After:
-  //  ... <-> [up] <-> [this] <-> [down] <-> ...
-  this->up->down = this;
-  this->down->up = this;
-}
-
-auto DancingLinkNode::getHeader() -> DancingLinkHeader * {
-  return this->header;
+void DancingLinkNode::setData(int data) {
+  this->data = data;
 }
 
-auto DancingLinkNode::getLeft() -> DancingLinkNode * {
-  return this->left;
-}
-
-auto DancingLinkNode::getRight() -> DancingLinkNode * {
-  return this->right;
-}
-
-auto DancingLinkNode::getUp() -> DancingLinkNode * {
-  return this->up;
-}
-
-auto DancingLinkNode::getDown() -> DancingLinkNode * {
-  return this->down;
+auto DancingLinkNode::getData() const -> int {
+  return this->data;
 }
 
-void DancingLinkNode::setData(std::any data) {
-  this->data = std::move(data);
+auto DancingLinkNode::getIndex() const -> std::uint32_t {
+  return this->index;
 }
 
-auto DancingLinkNode::getData() -> std::any {
-  return this->data;
-}
-
-DancingLinkHeader::DancingLinkHeader()
-    : DancingLinkNode(this), count(0) {}
+DancingLinkHeader::DancingLinkHeader(DancingLinksMatrix *matrix)
+    : DancingLinkNode(this), matrix(matrix), count(0) {}
 
 auto DancingLinkHeader::newNode() -> DancingLinkNode * {
-  std::unique_ptr<DancingLinkNode> node = std::make_unique<DancingLinkNode>(this);
+  // Allocate the node from the matrix owning this header
+  auto *node = this->matrix->newNode(this);
   node->insertUpOf(this);
   this->incCount();
-
-  auto *nodePtr = node.get();
-  this->nodes.push_back(std::move(node));
-  return nodePtr;
-}
-
-auto DancingLinkHeader::getCount() const -> int {
-  return this->count;
-}
-
-void DancingLinkHeader::incCount() {
-  this->count++;
-}
-
-void DancingLinkHeader::decCount() {
-  this->count--;
+  return node;
 }
 
 }  // namespace dlx
\ No newline at end of file
@@ -1,13 +1,18 @@
 #ifndef LIBDLX_DANCING_LINK_NODE_HPP_
 #define LIBDLX_DANCING_LINK_NODE_HPP_
 
-#include <any>
 #include <concepts>
-#include <memory>
-#include <vector>
+#include <cstdint>
 
 namespace dlx {
 class DancingLinkHeader;
+class DancingLinksMatrix;
+
+/**
+ * Marker for the data element of a node which was not assigned any data,
+ * see \link DancingLinkNode::getData() .
+ */
+constexpr int NoData = -1;
 
 /**
  * The DancingLinkNode represents a single node in the Dancing Links
@@ -19,16 +24,19 @@ class DancingLinkHeader;
  * the Alogrithm X implementation of \link dlx::Solver .
  *
  * Nodes are typically created via \link DancingLinkHeader::newNode() instead of
- * instantiated directly. By creating nodes via DancingLinkHeader, the header
- * can own the memory for its nodes. See also \link DancingLinkHeader.
+ * instantiated directly. By creating nodes via DancingLinkHeader, the matrix of
+ * the header can own the memory for its nodes. See also \link DancingLinkHeader.
  *
  * Each node has weak references its four neighbors: left, right, up, down.
  * Via the remove and reinsert operators, a node can be removed and reinserted
  * into it's horizontal (left-right) or vertical (up-down) lists in O(1) time.
  *
- * A node also can contain a data element of any type.
+ * A node also can contain an (int) data element, such as the index of its row.
  * This data element can be used as meta-data for bookkeeping
  * when modelling exact cover problems.
+ *
+ * A node holds nothing but plain pointers and integers, so that a matrix can
+ * copy all of its nodes at once, see \link DancingLinksMatrix::clone() .
  */
 class DancingLinkNode {
  public:
@@ -37,7 +45,7 @@ class DancingLinkNode {
    * header node.
    *
    * \param header A weak reference to the header which will act as a container
-   *               and own the memory of this DancingLinkNode.
+   *               for this DancingLinkNode.
    */
   explicit DancingLinkNode(DancingLinkHeader *header);
 
@@ -164,20 +172,30 @@ class DancingLinkNode {
   auto getDown() -> DancingLinkNode *;
 
   /**
-   * Returns the data element associated with this node.
+   * Sets the data element associated with this node.
    * This data element can be used as meta-data for bookkeeping
    * when modelling exact cover problems.
    */
-  void setData(std::any data);
+  void setData(int data);
 
   /**
-   * Sets the data element associated with this node.
+   * Returns the data element associated with this node, or NoData if none was set.
    * This data element can be used as meta-data for bookkeeping
    * when modelling exact cover problems.
    */
-  auto getData() -> std::any;
+  [[nodiscard]] auto getData() const -> int;
+
+  /**
+   * Returns the position of this node among all nodes of its \link DancingLinksMatrix ,
+   * or for a header, its column in the matrix.
+   */
+  [[nodiscard]] auto getIndex() const -> std::uint32_t;
 
  private:
+  // The matrix numbers its nodes, and copies nodes including their links,
+  // see DancingLinksMatrix::clone()
+  friend class DancingLinksMatrix;
+
   // Weak reference to the header acting as container for this node.
   DancingLinkHeader *header;
 
@@ -187,7 +205,11 @@ class DancingLinkNode {
 
   // Data associated with this node.
   // This data element can be used as meta-data for bookkeeping.
-  std::any data;
+  int data = NoData;
+
+  // Position of this node in its matrix: among all nodes,
+  // or for a header, among all headers. Used to locate nodes in O(1).
+  std::uint32_t index = 0;
 };
 
 /**
@@ -196,7 +218,7 @@ class DancingLinkNode {
  *
  * Headers in the Dancing Links data structure (ref:
  * https://en.wikipedia.org/wiki/Dancing_Links) act as containers for the
- * purpose of owning the memory of the list nodes.
+ * list nodes, which are allocated from the matrix of the header.
  *
  * A header keeps tracks of the number of nodes in it's vertical circular doubly
  * linked list. This count property is used the Alogrithm X implementation of
@@ -204,23 +226,24 @@ class DancingLinkNode {
  * usage of removeVertical/reinsertVertical intentionally do not update the
  * count property directly.
  *
- * Headers are typically created via \link DancingLinksMatrix::newHeader()
- * instead of instantiated directly. By creating nodes via DancingLinksMatrix,
- * the matrix can own the memory for its header nodes.
+ * Headers are created via \link DancingLinksMatrix::newHeader() , so that
+ * the matrix owns the memory for its header nodes and their list nodes.
  */
 class DancingLinkHeader : public DancingLinkNode {
  public:
   /**
    * Constructs a new 'empty' DancingLinkHeader.
+   *
+   * \param matrix The matrix which owns this header and from which its nodes are allocated.
    */
-  DancingLinkHeader();
+  explicit DancingLinkHeader(DancingLinksMatrix *matrix);
 
   /**
    * Instantiates a new DancingLinkNode and inserts it into the vertical list of
    * this header.
    *
-   * This header will own the memory to the new node and a weak reference is
-   * returned for further setup of the new node.
+   * The matrix of this header will own the memory to the new node and a weak
+   * reference is returned for further setup of the new node.
    *
    * \post the new node is added to the end of the vertical list (this.up == new
    * node) \post count is increased to reflect this header containing an
@@ -244,13 +267,91 @@ class DancingLinkHeader : public DancingLinkNode {
   void decCount();
 
  private:
+  // The matrix copies headers including their counts, see DancingLinksMatrix::clone()
+  friend class DancingLinksMatrix;
+
+  // Weak reference to the matrix owning the memory of this header and its list nodes.
+  DancingLinksMatrix *matrix;
+
   // Counter for the number of nodes in this header's vertical list.
   int count;
-
-  // Container for owning the memory of the list nodes.
-  std::vector<std::unique_ptr<DancingLinkNode>> nodes;
 };
 
+// The link operations below are defined inline, as they are on the hot path of Solver::cover()
+// and Solver::uncover()
+
+inline void DancingLinkNode::removeHorizontal() {
+  // Before:
+  //  ... <-> [left] <-> [this] <-> [right] <-> ...
+  // After:
+  //  ... <-> [left] <-> [right] <-> ...
+  // With the references in this still intact:
+  //           [left] <- [this] -> [right]
+  this->right->left = this->left;
+  this->left->right = this->right;
+}
+
+inline void DancingLinkNode::removeVertical() {
+  // Before:
+  //  ... <-> [up] <-> [this] <-> [down] <-> ...
+  // After:
+  //  ... <-> [up] <-> [down] <-> ...
+  // With the references in this still intact:
+  //           [up] <- [this] -> [down]
+  this->up->down = this->down;
+  this->down->up = this->up;
+}
+
+inline void DancingLinkNode::reinsertHorizontal() {
+  // Before:
+  //  ... <-> [left] <-> [right] <-> ...
+  // After:
+  //  ... <-> [left] <-> [this] <-> [right] <-> ...
+  this->left->right = this;
+  this->right->left = this;
+}
+
+inline void DancingLinkNode::reinsertVertical() {
+  // Before:
+  //  ... <-> [up] <-> [down] <-> ...
+  // After:
+  //  ... <-> [up] <-> [this] <-> [down] <-> ...
+  this->up->down = this;
+  this->down->up = this;
+}
+
+inline auto DancingLinkNode::getHeader() -> DancingLinkHeader * {
+  return this->header;
+}
+
+inline auto DancingLinkNode::getLeft() -> DancingLinkNode * {
+  return this->left;
+}
+
+inline auto DancingLinkNode::getRight() -> DancingLinkNode * {
+  return this->right;
+}
+
+inline auto DancingLinkNode::getUp() -> DancingLinkNode * {
+  return this->up;
+}
+
+inline auto DancingLinkNode::getDown() -> DancingLinkNode * {
+  return this->down;
+}
+
+inline auto DancingLinkHeader::getCount() const -> int {
+  return this->count;
+}
+
+inline void DancingLinkHeader::incCount() {
+  this->count++;
+}
+
+inline void DancingLinkHeader::decCount() {
+  this->count--;
+}
+
 }  // namespace dlx
 
 #endif  // LIBDLX_DANCING_LINK_NODE_HPP_
\ No newline at end of file
@@ -1,23 +1,230 @@
 #include "dancing-links-matrix.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
 // https://en.wikipedia.org/wiki/Dancing_Links
 namespace dlx {
-DancingLinksMatrix::DancingLinksMatrix()
-    : root(std::make_unique<DancingLinkHeader>()) {}
+// Headers and nodes are copied in bulk, see the copy constructor
+static_assert(std::is_trivially_copyable_v<DancingLinkHeader>);
+static_assert(std::is_trivially_copyable_v<DancingLinkNode>);
+static_assert(sizeof(DancingLinkHeader) % alignof(DancingLinkNode) == 0);
+
+DancingLinksMatrix::DancingLinksMatrix(std::pmr::memory_resource *resource)
+    : DancingLinksMatrix(resource, 0, 0) {}
+
+DancingLinksMatrix::DancingLinksMatrix(std::pmr::memory_resource *resource, std::size_t num_columns,
+                                       std::size_t num_nodes)
+    : resource(resource), buffer(nullptr), headers(resource), nodes(resource), rows(resource), row_arity(VariableArity) {
+  // A single allocation holds the root header and all column headers, followed by all nodes
+  const std::size_t header_bytes = (num_columns + 1) * sizeof(DancingLinkHeader);
+  this->buffer = static_cast<std::byte *>(
+      resource->allocate(header_bytes + (num_nodes * sizeof(DancingLinkNode)), alignof(DancingLinkHeader)));
+  this->header_block = {reinterpret_cast<DancingLinkHeader *>(this->buffer), num_columns + 1};
+  this->node_block = {reinterpret_cast<DancingLinkNode *>(this->buffer + header_bytes), num_nodes};
+
+  auto *root = new (this->header_block.data()) DancingLinkHeader(this);
+  root->index = RootIndex;
+}
+
+DancingLinksMatrix::DancingLinksMatrix(const ExactCoverProblem &problem, std::pmr::memory_resource *resource)
+    : DancingLinksMatrix(resource, problem.getNumColumns(), [&problem] {
+        std::size_t num_nodes = 0;
+        for (int row = 0; row < problem.getNumRows(); row++) {
+          num_nodes += problem.getRow(row).size();
+        }
+        return num_nodes;
+      }()) {
+  // Create every column header in the buffer, so that header_block[i + 1] is the header of column i
+  auto *root = this->getRoot();
+  for (int column = 0; column < problem.getNumColumns(); column++) {
+    auto *header = new (&this->header_block[column + 1]) DancingLinkHeader(this);
+    header->index = static_cast<std::uint32_t>(column);
+    header->insertLeftOf(root);
+  }
+
+  // Create a node for every 1 in every row, and link each row horizontally
+  this->rows.resize(problem.getNumRows());
+  std::uint32_t index = 0;
+  for (int row = 0; row < problem.getNumRows(); row++) {
+    DancingLinkNode *row_root = nullptr;
+
+    // the arity is fixed as long as every row has as many columns as the first one
+    const auto arity = static_cast<int>(problem.getRow(row).size());
+    if (row == 0) {
+      this->row_arity = arity;
+    } else if (arity != this->row_arity) {
+      this->row_arity = VariableArity;
+    }
+
+    for (int column : problem.getRow(row)) {
+      auto *header = &this->header_block[column + 1];
+      auto *node = new (&this->node_block[index]) DancingLinkNode(header);
+      node->index = index++;
+      node->data = row;
+      node->insertUpOf(header);
+      header->incCount();
+
+      if (row_root == nullptr) {
+        row_root = node;
+      } else {
+        node->insertLeftOf(row_root);
+      }
+    }
+
+    this->rows[row] = row_root;
+  }
+}
+
+DancingLinksMatrix::DancingLinksMatrix(const DancingLinksMatrix &other, std::pmr::memory_resource *resource)
+    : DancingLinksMatrix(resource, other.getNumColumns(), other.getNumNodes()) {
+  // First copy all headers and nodes in the same order, so that every index is preserved:
+  // the buffer of the other matrix at once, then any headers and nodes added to it afterwards
+  this->header_block.front() = other.header_block.front();
+  auto header_it = std::uninitialized_copy(other.header_block.begin() + 1, other.header_block.end(),
+                                           this->header_block.begin() + 1);
+  for (const auto &header : other.headers) {
+    header_it = std::uninitialized_copy_n(header.get(), 1, header_it);
+  }
+
+  auto node_it = std::uninitialized_copy(other.node_block.begin(), other.node_block.end(), this->node_block.begin());
+  for (const auto &node : other.nodes) {
+    node_it = std::uninitialized_copy_n(node.get(), 1, node_it);
+  }
+
+  // Then rebase all links, including those of removed nodes, which still link
+  // to their former neighbours so that they can be reinserted.
+  auto rebase_links = [this, &other](DancingLinkNode &node) {
+    node.header = static_cast<DancingLinkHeader *>(this->rebase(other, node.header));
+    node.up = this->rebase(other, node.up);
+    node.down = this->rebase(other, node.down);
+    node.left = this->rebase(other, node.left);
+    node.right = this->rebase(other, node.right);
+  };
+
+  for (auto &header : this->header_block) {
+    rebase_links(header);
+    header.matrix = this;
+  }
+  for (auto &node : this->node_block) {
+    rebase_links(node);
+  }
+
+  this->rows.reserve(other.rows.size());
+  for (auto *row : other.rows) {
+    this->rows.push_back(this->rebase(other, row));
+  }
+  this->row_arity = other.row_arity;
+}
+
+DancingLinksMatrix::~DancingLinksMatrix() {
+  // headers and nodes are trivially destructible, hence only the buffer is released
+  this->resource->deallocate(this->buffer,
+                             this->header_block.size_bytes() + this->node_block.size_bytes(),
+                             alignof(DancingLinkHeader));
+}
+
+auto DancingLinksMatrix::clone(std::pmr::memory_resource *resource) const -> std::unique_ptr<DancingLinksMatrix> {
+  return std::make_unique<DancingLinksMatrix>(*this, resource);
+}
+
+auto DancingLinksMatrix::mapNode(const DancingLinkNode *node) -> DancingLinkNode * {
+  // A node is located via the position of its header, or its own position among all nodes
+  auto *target = this->getHeader(node->header->index);
+  if (node == node->header) {
+    return target;
+  }
+  return this->getNode(node->index);
+}
+
+auto DancingLinksMatrix::rebase(const DancingLinksMatrix &other, const DancingLinkNode *node) -> DancingLinkNode * {
+  // Headers and nodes in the buffer of the other matrix are at the same offset in this buffer,
+  // any other node was added to the other matrix afterwards and is located via its position.
+  const std::less<const void *> less;
+  if (!less(node, other.node_block.data()) && less(node, other.node_block.data() + other.node_block.size())) {
+    return this->node_block.data() + (node - other.node_block.data());
+  }
+  if (!less(node, other.header_block.data()) && less(node, other.header_block.data() + other.header_block.size())) {
+    return this->header_block.data() + (static_cast<const DancingLinkHeader *>(node) - other.header_block.data());
+  }
+  return this->mapNode(node);
+}
+
+auto DancingLinksMatrix::getHeader(std::uint32_t column) -> DancingLinkHeader * {
+  if (column == RootIndex) {
+    return this->getRoot();
+  }
+  if (column + 1 < this->header_block.size()) {
+    return &this->header_block[column + 1];
+  }
+  return this->headers[column + 1 - this->header_block.size()].get();
+}
+
+auto DancingLinksMatrix::getNode(std::uint32_t index) -> DancingLinkNode * {
+  if (index < this->node_block.size()) {
+    return &this->node_block[index];
+  }
+  return this->nodes[index - this->node_block.size()].get();
+}
 
 auto DancingLinksMatrix::newHeader() -> DancingLinkHeader * {
-  // Note that left of the doubly-linked list this->root always points to the end of the list
-  // Therefore, adding to the left of this->root, adds the new item to the end of the list.
-  std::unique_ptr<DancingLinkHeader> header = std::make_unique<DancingLinkHeader>();
-  header->insertLeftOf(this->root.get());
+  // Note that left of the doubly-linked list root always points to the end of the list
+  // Therefore, adding to the left of root, adds the new item to the end of the list.
+  auto header = makePmrUnique<DancingLinkHeader>(this->resource, this);
+  header->index = static_cast<std::uint32_t>(this->getNumColumns());
+  header->insertLeftOf(this->getRoot());
 
   auto *header_ptr = header.get();
   this->headers.push_back(std::move(header));
   return header_ptr;
 }
 
+auto DancingLinksMatrix::newNode(DancingLinkHeader *header) -> DancingLinkNode * {
+  auto node = makePmrUnique<DancingLinkNode>(this->resource, header);
+  node->index = static_cast<std::uint32_t>(this->getNumNodes());
+
+  auto *node_ptr = node.get();
+  this->nodes.push_back(std::move(node));
+  return node_ptr;
+}
+
+void DancingLinksMatrix::dropColumn(DancingLinkHeader *header) {
+  header->removeHorizontal();
+  header->left = header;
+  header->right = header;
+}
+
+auto DancingLinksMatrix::isDropped(DancingLinkHeader *header) -> bool {
+  return header->getRight() == header && header->index != RootIndex;
+}
+
 auto DancingLinksMatrix::getRoot() -> DancingLinkHeader * {
-  return this->root.get();
+  return this->header_block.data();
+}
+
+auto DancingLinksMatrix::getRow(int row) -> DancingLinkNode * {
+  return this->rows[row];
+}
+
+auto DancingLinksMatrix::getNumRows() const -> int {
+  return static_cast<int>(this->rows.size());
+}
+
+auto DancingLinksMatrix::getNumColumns() const -> int {
+  return static_cast<int>(this->header_block.size() - 1 + this->headers.size());
+}
+
+auto DancingLinksMatrix::getNumNodes() const -> std::size_t {
+  return this->node_block.size() + this->nodes.size();
+}
+
+auto DancingLinksMatrix::getRowArity() const -> int {
+  return this->row_arity;
+}
+
+auto DancingLinksMatrix::getMemoryResource() const -> std::pmr::memory_resource * {
+  return this->resource;
 }
 
 }  // namespace dlx
\ No newline at end of file
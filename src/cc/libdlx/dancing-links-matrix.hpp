@@ -1,11 +1,24 @@
 #ifndef LIBDLX_DANCING_LINKS_MATRIX_HPP_
 #define LIBDLX_DANCING_LINKS_MATRIX_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
 
 #include "dancing-link-node.hpp"
+#include "exact-cover-problem.hpp"
+#include "memory-resource.hpp"
 
 namespace dlx {
+/**
+ * Marker for the row arity of a matrix whose rows differ in their number of nodes,
+ * see \link DancingLinksMatrix::getRowArity() .
+ */
+constexpr int VariableArity = 0;
+
 /**
  * The DancingLinksMatrix represents a sparse matrix using the Dancing Links datastructure.
  *
@@ -20,14 +33,74 @@ namespace dlx {
  *
  * This matrix directly owns all header nodes in the header row.
  * A new header node is created and added to the header row via \link DancingLinksMatrix::newHeader() .
+ * Alternatively, the whole matrix is built at once from an \link ExactCoverProblem description,
+ * in which case the data element of every node holds the (int) index of its row.
  *
+ * All headers and nodes are allocated from the std::pmr::memory_resource given at construction.
+ * This allows a matrix to be built (and solved) entirely inside an arena, such as a per-puzzle
+ * std::pmr::monotonic_buffer_resource, which is released at once afterwards.
+ * A matrix built from a description keeps all of its headers and nodes in a single contiguous
+ * buffer, only headers and nodes added afterwards are allocated one by one.
+ *
+ * A matrix can be duplicated in its current state via \link clone() , for example to give every
+ * thread its own replica of a prepared (partially covered) matrix.
  */
 class DancingLinksMatrix {
  public:
   /**
    * Constructs a new 'empty' matrix consisting of only a root header node.
+   *
+   * \param resource The memory resource from which all headers and nodes are allocated.
+   *                 The resource must outlive this matrix.
+   */
+  explicit DancingLinksMatrix(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Constructs a new matrix with a header for every column and a node row for every row
+   * of the given problem description.
+   *
+   * The rows are appended in order, and the first node of every row is its row root,
+   * available via \link getRow() . The data element of every node is its (int) row index.
+   *
+   * \param resource The memory resource from which all headers and nodes are allocated.
+   *                 The resource must outlive this matrix.
+   */
+  explicit DancingLinksMatrix(const ExactCoverProblem &problem,
+                              std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Constructs an exact copy of the given matrix in its current state.
+   *
+   * All headers and nodes are duplicated including their links, so covered columns and rows
+   * stay covered and all header counts are kept. The copy keeps all headers and nodes in a
+   * single contiguous buffer: the buffer of the given matrix is copied in bulk, after which
+   * every link is rebased to the same offset in the copy in a single pass over the nodes.
+   *
+   * \param resource The memory resource from which all headers and nodes of the copy are allocated.
+   *                 The resource must outlive the copy.
+   */
+  DancingLinksMatrix(const DancingLinksMatrix &other, std::pmr::memory_resource *resource);
+
+  DancingLinksMatrix(const DancingLinksMatrix &) = delete;
+  DancingLinksMatrix(DancingLinksMatrix &&) = delete;
+  auto operator=(const DancingLinksMatrix &) -> DancingLinksMatrix & = delete;
+  auto operator=(DancingLinksMatrix &&) -> DancingLinksMatrix & = delete;
+  virtual ~DancingLinksMatrix();
+
+  /**
+   * Duplicate this matrix in its current state, see the copy constructor above.
+   *
+   * Derived matrices override this method to copy their own bookkeeping as well,
+   * so that a matrix owned via a base pointer is cloned as a whole.
+   */
+  [[nodiscard]] virtual auto clone(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const
+      -> std::unique_ptr<DancingLinksMatrix>;
+
+  /**
+   * Get the node of this matrix at the same position as the given node of another matrix
+   * with the same structure, such as the matrix this matrix was cloned from (or vice versa).
    */
-  DancingLinksMatrix();
+  auto mapNode(const DancingLinkNode *node) -> DancingLinkNode *;
 
   /**
    * Instantiates a new DancingLinkHeader and inserts it into the header row horizontal list.
@@ -39,17 +112,118 @@ class DancingLinksMatrix {
    */
   auto newHeader() -> DancingLinkHeader *;
 
+  /**
+   * Drop the given column header from the header row for good, keeping the nodes of its rows,
+   * such as a column that is covered by the same rows as another column, see \link reduce() .
+   *
+   * The header is linked to itself horizontally, so that it is never selected by a search,
+   * while covering and uncovering it still hides and unhides its rows (as it is covered along
+   * with any of its rows), but leaves the header row untouched.
+   */
+  void dropColumn(DancingLinkHeader *header);
+
+  /**
+   * Get if the given column header was dropped via \link dropColumn() .
+   */
+  static auto isDropped(DancingLinkHeader *header) -> bool;
+
   /**
    * Get the root header node, which represents the start of the header row list.
    */
   auto getRoot() -> DancingLinkHeader *;
 
+  /**
+   * Get the memory resource from which all headers and nodes of this matrix are allocated.
+   */
+  [[nodiscard]] auto getMemoryResource() const -> std::pmr::memory_resource *;
+
+  /**
+   * Get the root node of the row with the given index, for matrices built from an
+   * \link ExactCoverProblem description.
+   */
+  auto getRow(int row) -> DancingLinkNode *;
+
+  /**
+   * Get the number of rows, for matrices built from an \link ExactCoverProblem description.
+   */
+  [[nodiscard]] auto getNumRows() const -> int;
+
+  /**
+   * Get the number of column headers, covered or not.
+   */
+  [[nodiscard]] auto getNumColumns() const -> int;
+
+  /**
+   * Get the number of nodes in all rows, covered or not.
+   */
+  [[nodiscard]] auto getNumNodes() const -> std::size_t;
+
+  /**
+   * Get the number of nodes in every row, if all rows of the matrix have the same number of nodes,
+   * such as the four constraints of every Sudoku placement. Otherwise, or for matrices built
+   * via \link newHeader() , this is VariableArity.
+   *
+   * The \link Solver uses this to select a search specialized for a fixed row arity.
+   */
+  [[nodiscard]] auto getRowArity() const -> int;
+
  private:
-  // Root header row node, representing the start of the header row list.
-  std::unique_ptr<DancingLinkHeader> root;
+  // Headers allocate their nodes from their matrix, see DancingLinkHeader::newNode()
+  friend class DancingLinkHeader;
+
+  /**
+   * Constructs a matrix with a contiguous buffer for the given number of column headers and nodes,
+   * of which only the root header is constructed.
+   */
+  DancingLinksMatrix(std::pmr::memory_resource *resource, std::size_t num_columns, std::size_t num_nodes);
+
+  /**
+   * Instantiates a new node for the given header, see \link DancingLinkHeader::newNode() .
+   */
+  auto newNode(DancingLinkHeader *header) -> DancingLinkNode *;
+
+  /**
+   * Get the header of the given column, or the root header for RootIndex.
+   */
+  auto getHeader(std::uint32_t column) -> DancingLinkHeader *;
+
+  /**
+   * Get the node at the given position among all nodes.
+   */
+  auto getNode(std::uint32_t index) -> DancingLinkNode *;
+
+  /**
+   * Get the node of this matrix at the same position as the given node of the matrix being copied,
+   * see the copy constructor.
+   */
+  auto rebase(const DancingLinksMatrix &other, const DancingLinkNode *node) -> DancingLinkNode *;
+
+  // The memory resource from which all headers and nodes are allocated.
+  std::pmr::memory_resource *resource;
+
+  // Contiguous buffer holding the root header followed by the column headers of the matrix
+  // at construction, then the nodes of its rows, see header_block and node_block.
+  std::byte *buffer;
+
+  // The root header row node, representing the start of the header row list, followed by
+  // the header of every column in order.
+  std::span<DancingLinkHeader> header_block;
+
+  // The nodes of all rows, in order of their index.
+  std::span<DancingLinkNode> node_block;
+
+  // Owning containers for the headers and nodes added after construction, see newHeader().
+  std::pmr::vector<PmrUniquePtr<DancingLinkHeader>> headers;
+  std::pmr::vector<PmrUniquePtr<DancingLinkNode>> nodes;
+
+  // Lookup vector for row root nodes by row index, for matrices built from a description.
+  std::pmr::vector<DancingLinkNode *> rows;
+
+  // The number of nodes in every row, or VariableArity
+  int row_arity;
 
-  // Owning container for all header nodes added to this matrix.
-  std::vector<std::unique_ptr<DancingLinkHeader>> headers;
+  // Marker for the index of the root header, which is not a column
+  static constexpr std::uint32_t RootIndex = UINT32_MAX;
 };
 
 }  // namespace dlx
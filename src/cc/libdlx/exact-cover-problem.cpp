@@ -0,0 +1,41 @@
+#include "exact-cover-problem.hpp"
+
+#include <algorithm>
+
+namespace dlx {
+ExactCoverProblem::ExactCoverProblem(int num_columns, std::pmr::memory_resource *resource)
+    : num_columns(num_columns), columns(resource), row_offsets(1, 0, resource) {}
+
+auto ExactCoverProblem::addRow(std::span<const int> columns) -> int {
+  // every engine indexes its columns by these, so a column out of range or twice in a row is rejected
+  for (std::size_t index = 0; index < columns.size(); index++) {
+    if (columns[index] < 0 || columns[index] >= this->num_columns ||
+        std::find(columns.begin(), columns.begin() + static_cast<std::ptrdiff_t>(index), columns[index]) !=
+            columns.begin() + static_cast<std::ptrdiff_t>(index)) {
+      return -1;
+    }
+  }
+
+  this->columns.insert(this->columns.end(), columns.begin(), columns.end());
+  this->row_offsets.push_back(static_cast<int>(this->columns.size()));
+  return this->getNumRows() - 1;
+}
+
+auto ExactCoverProblem::addRow(std::initializer_list<int> columns) -> int {
+  return this->addRow(std::span<const int>(columns.begin(), columns.size()));
+}
+
+auto ExactCoverProblem::getNumColumns() const -> int {
+  return this->num_columns;
+}
+
+auto ExactCoverProblem::getNumRows() const -> int {
+  return static_cast<int>(this->row_offsets.size()) - 1;
+}
+
+auto ExactCoverProblem::getRow(int row) const -> std::span<const int> {
+  return {this->columns.data() + this->row_offsets[row],
+          static_cast<std::size_t>(this->row_offsets[row + 1] - this->row_offsets[row])};
+}
+
+}  // namespace dlx
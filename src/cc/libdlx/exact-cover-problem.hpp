@@ -0,0 +1,77 @@
+#ifndef LIBDLX_EXACT_COVER_PROBLEM_HPP_
+#define LIBDLX_EXACT_COVER_PROBLEM_HPP_
+
+#include <initializer_list>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace dlx {
+/**
+ * The ExactCoverProblem describes an exact cover problem independent of how it is solved.
+ *
+ * The problem is a matrix of 0s and 1s, with a number of columns (the conditions to cover)
+ * and a list of rows (the subsets to choose from). Each row lists the indices of the columns
+ * in which it has a 1. Rows are identified by their index in the order they were added.
+ *
+ * The description can be turned into a \link DancingLinksMatrix to be solved by
+ * \link Solver , or solved directly by the dense \link BitsetSolver . Both report
+ * solutions in terms of the row indices of this description.
+ *
+ * Rows are stored in a compressed sparse row layout: one flat vector of column indices,
+ * plus the offset at which every row starts.
+ */
+class ExactCoverProblem {
+ public:
+  /**
+   * Constructs a new problem with the given number of columns and no rows.
+   *
+   * \param resource The memory resource from which the description is allocated.
+   */
+  explicit ExactCoverProblem(int num_columns, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Adds a row with a 1 in each of the given columns, each in the range 0..getNumColumns()-1
+   * and listed once.
+   *
+   * \return the index of the new row, or -1 if a column is out of range or listed twice,
+   *         in which case no row is added.
+   */
+  auto addRow(std::span<const int> columns) -> int;
+
+  /**
+   * Adds a row with a 1 in each of the given columns, see \link addRow(std::span<const int>) .
+   *
+   * \return the index of the new row, or -1 if the columns are invalid.
+   */
+  auto addRow(std::initializer_list<int> columns) -> int;
+
+  /**
+   * Returns the number of columns.
+   */
+  [[nodiscard]] auto getNumColumns() const -> int;
+
+  /**
+   * Returns the number of rows.
+   */
+  [[nodiscard]] auto getNumRows() const -> int;
+
+  /**
+   * Returns the columns in which the given row has a 1, in the order they were added.
+   */
+  [[nodiscard]] auto getRow(int row) const -> std::span<const int>;
+
+ private:
+  // The number of columns
+  int num_columns;
+
+  // The column indices of all rows, concatenated
+  std::pmr::vector<int> columns;
+
+  // The offset in columns at which every row starts, plus a final end offset
+  std::pmr::vector<int> row_offsets;
+};
+
+}  // namespace dlx
+
+#endif  // LIBDLX_EXACT_COVER_PROBLEM_HPP_
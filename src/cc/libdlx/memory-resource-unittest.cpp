@@ -0,0 +1,94 @@
+#include "memory-resource.hpp"
+
+#include "dancing-links-matrix.hpp"
+#include "gtest/gtest.h"
+#include "solver.hpp"
+
+namespace dlx {
+namespace {
+
+/**
+ * Test: counting resource counts allocations made via makePmrUnique
+ */
+TEST(MemoryResource, CountingMakePmrUnique) {
+  CountingMemoryResource resource;
+
+  {
+    auto value = makePmrUnique<int>(&resource, 42);
+    EXPECT_EQ(42, *value);
+    EXPECT_EQ(1, resource.getAllocations());
+    EXPECT_EQ(0, resource.getDeallocations());
+    EXPECT_EQ(sizeof(int), resource.getBytesAllocated());
+  }
+
+  EXPECT_EQ(1, resource.getDeallocations());
+
+  resource.reset();
+  EXPECT_EQ(0, resource.getAllocations());
+  EXPECT_EQ(0, resource.getDeallocations());
+  EXPECT_EQ(0, resource.getBytesAllocated());
+}
+
+/**
+ * Test: a matrix and its solver allocate all headers, nodes and solutions from the given resource
+ */
+TEST(MemoryResource, MatrixAllocatesFromResource) {
+  CountingMemoryResource resource;
+
+  {
+    auto matrix = std::make_unique<DancingLinksMatrix>(&resource);
+    EXPECT_EQ(&resource, matrix->getMemoryResource());
+
+    // root header is allocated from the resource
+    EXPECT_EQ(1, resource.getAllocations());
+
+    // Basic example from https://en.wikipedia.org/wiki/Exact_cover
+    auto *header1 = matrix->newHeader();
+    auto *header2 = matrix->newHeader();
+    DancingLinkNode::makeRow(header1->newNode(), header2->newNode());
+    const std::size_t allocations = resource.getAllocations();
+    EXPECT_LT(1, allocations);
+
+    Solver solver(std::move(matrix));
+    auto result = solver.solve();
+
+    EXPECT_TRUE(result.has_value());
+    if (result.has_value()) {
+      EXPECT_EQ(&resource, result.value().get_allocator().resource());
+    }
+    EXPECT_LT(allocations, resource.getAllocations());
+  }
+
+  // everything is returned to the resource upon destruction
+  EXPECT_EQ(resource.getAllocations(), resource.getDeallocations());
+}
+
+/**
+ * Test: a clone of a matrix built from a description copies all headers and nodes in a single allocation
+ */
+TEST(MemoryResource, CloneAllocatesOnce) {
+  ExactCoverProblem problem(3);
+  problem.addRow({0});
+  problem.addRow({1, 2});
+  problem.addRow({0, 1});
+  problem.addRow({2});
+  DancingLinksMatrix matrix(problem);
+
+  CountingMemoryResource resource;
+  {
+    auto replica = matrix.clone(&resource);
+    EXPECT_EQ(&resource, replica->getMemoryResource());
+    EXPECT_EQ(matrix.getNumNodes(), replica->getNumNodes());
+
+    // one buffer for all headers and nodes, and one lookup for the rows
+    EXPECT_EQ(2, resource.getAllocations());
+
+    Solver solver(std::move(replica));
+    EXPECT_TRUE(solver.solve().has_value());
+  }
+
+  EXPECT_EQ(resource.getAllocations(), resource.getDeallocations());
+}
+
+}  // namespace
+}  // namespace dlx
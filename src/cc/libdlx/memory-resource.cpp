@@ -0,0 +1,41 @@
+#include "memory-resource.hpp"
+
+namespace dlx {
+
+CountingMemoryResource::CountingMemoryResource(std::pmr::memory_resource *upstream)
+    : upstream(upstream), allocations(0), deallocations(0), bytes_allocated(0) {}
+
+auto CountingMemoryResource::getAllocations() const -> std::size_t {
+  return this->allocations;
+}
+
+auto CountingMemoryResource::getDeallocations() const -> std::size_t {
+  return this->deallocations;
+}
+
+auto CountingMemoryResource::getBytesAllocated() const -> std::size_t {
+  return this->bytes_allocated;
+}
+
+void CountingMemoryResource::reset() {
+  this->allocations = 0;
+  this->deallocations = 0;
+  this->bytes_allocated = 0;
+}
+
+auto CountingMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) -> void * {
+  this->allocations++;
+  this->bytes_allocated += bytes;
+  return this->upstream->allocate(bytes, alignment);
+}
+
+void CountingMemoryResource::do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) {
+  this->deallocations++;
+  this->upstream->deallocate(pointer, bytes, alignment);
+}
+
+auto CountingMemoryResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept -> bool {
+  return this == &other;
+}
+
+}  // namespace dlx
\ No newline at end of file
@@ -0,0 +1,111 @@
+#ifndef LIBDLX_MEMORY_RESOURCE_HPP_
+#define LIBDLX_MEMORY_RESOURCE_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace dlx {
+
+/**
+ * Deleter for objects allocated from a std::pmr::memory_resource via \link makePmrUnique() .
+ *
+ * The deleter remembers the memory resource the object was allocated from, so that
+ * the object is destroyed and its memory is returned to that same resource.
+ */
+template <typename T>
+class PmrDeleter {
+ public:
+  /**
+   * Constructs a deleter returning memory to the given resource.
+   */
+  explicit PmrDeleter(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      : resource(resource) {}
+
+  /**
+   * Destroys the given object and deallocates its memory.
+   */
+  void operator()(T *object) const {
+    object->~T();
+    this->resource->deallocate(object, sizeof(T), alignof(T));
+  }
+
+ private:
+  // The memory resource the object was allocated from
+  std::pmr::memory_resource *resource;
+};
+
+/**
+ * An owning pointer to an object allocated from a std::pmr::memory_resource.
+ */
+template <typename T>
+using PmrUniquePtr = std::unique_ptr<T, PmrDeleter<T>>;
+
+/**
+ * Allocates and constructs a new object of type T from the given memory resource.
+ *
+ * This is the std::pmr counterpart of std::make_unique(). The returned pointer owns
+ * the object and returns its memory to the given resource upon destruction.
+ */
+template <typename T, typename... Args>
+auto makePmrUnique(std::pmr::memory_resource *resource, Args &&...args) -> PmrUniquePtr<T> {
+  void *memory = resource->allocate(sizeof(T), alignof(T));
+  try {
+    return PmrUniquePtr<T>(new (memory) T(std::forward<Args>(args)...), PmrDeleter<T>(resource));
+  } catch (...) {
+    resource->deallocate(memory, sizeof(T), alignof(T));
+    throw;
+  }
+}
+
+/**
+ * A memory resource that forwards to an upstream resource while counting allocations.
+ *
+ * This resource is used to report how many allocations building and solving an
+ * exact cover problem takes, for example to verify that a puzzle is built and
+ * solved entirely inside a per-puzzle arena such as std::pmr::monotonic_buffer_resource.
+ */
+class CountingMemoryResource : public std::pmr::memory_resource {
+ public:
+  /**
+   * Constructs a new counting resource forwarding to the given upstream resource.
+   */
+  explicit CountingMemoryResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+  /**
+   * Returns the number of allocations made via this resource.
+   */
+  [[nodiscard]] auto getAllocations() const -> std::size_t;
+
+  /**
+   * Returns the number of deallocations made via this resource.
+   */
+  [[nodiscard]] auto getDeallocations() const -> std::size_t;
+
+  /**
+   * Returns the total number of bytes allocated via this resource.
+   */
+  [[nodiscard]] auto getBytesAllocated() const -> std::size_t;
+
+  /**
+   * Resets all counters to zero.
+   */
+  void reset();
+
+ private:
+  // The resource to which all requests are forwarded
+  std::pmr::memory_resource *upstream;
+
+  // Counters for the requests made via this resource
+  std::size_t allocations, deallocations, bytes_allocated;
+
+  auto do_allocate(std::size_t bytes, std::size_t alignment) -> void * override;
+  void do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+  [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource &other) const noexcept -> bool override;
+};
+
+}  // namespace dlx
+
+#endif  // LIBDLX_MEMORY_RESOURCE_HPP_
\ No newline at end of file
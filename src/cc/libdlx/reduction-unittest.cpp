@@ -0,0 +1,162 @@
+#include "reduction.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test-problems.hpp"
+
+namespace dlx {
+namespace {
+
+/**
+ * Test: rows that are the only row of a column are covered, and are part of the solution
+ */
+TEST(DLXReduction, ForcedRows) {
+  // A = {0,1}, B = {1,2}, C = {2}, D = {3}: A is the only row of column 0, covering it leaves
+  // only C for column 2, and D is the only row of column 3
+  ExactCoverProblem problem(4);
+  problem.addRow({0, 1});
+  problem.addRow({1, 2});
+  problem.addRow({2});
+  problem.addRow({3});
+
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+  auto reduction = reduce(solver);
+
+  EXPECT_EQ(4, reduction.columns_before);
+  EXPECT_EQ(0, reduction.columns_after);
+  EXPECT_EQ(4, reduction.rows_before);
+  EXPECT_EQ(0, reduction.rows_after);
+  EXPECT_EQ(3, reduction.forced_rows);
+  EXPECT_FALSE(reduction.infeasible);
+
+  // the solution is complete without searching
+  EXPECT_EQ((std::vector<std::vector<int>>{{0, 2, 3}}), enumerate(solver));
+  EXPECT_EQ(0, solver.getNodes());
+}
+
+/**
+ * Test: rows outside a dominated column are removed, and the dominating column is dropped
+ */
+TEST(DLXReduction, DominatedColumns) {
+  // every row of column 0 also covers column 1, so row {1,3} can never be chosen,
+  // and column 1 is covered along with column 0
+  ExactCoverProblem problem(4);
+  problem.addRow({0, 1});
+  problem.addRow({0, 1, 2});
+  problem.addRow({1, 3});
+  problem.addRow({2, 3});
+  problem.addRow({2});
+  problem.addRow({3});
+
+  // the reduction may change the order in which the search finds the solutions
+  Solver reference(std::make_unique<DancingLinksMatrix>(problem));
+  auto expected = enumerate(reference);
+  std::ranges::sort(expected);
+
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+  auto reduction = reduce(solver);
+
+  EXPECT_EQ(1, reduction.removed_rows);
+  EXPECT_EQ(1, reduction.dropped_columns);
+  EXPECT_EQ(0, reduction.forced_rows);
+  EXPECT_EQ(3, reduction.columns_after);
+  EXPECT_EQ(5, reduction.rows_after);
+  EXPECT_TRUE(DancingLinksMatrix::isDropped(solver.getMatrix()->getRow(0)->getRight()->getHeader()));
+
+  auto found = enumerate(solver);
+  std::ranges::sort(found);
+  EXPECT_EQ(expected, found);
+  EXPECT_EQ(3, expected.size());
+}
+
+/**
+ * Test: a column left without rows makes the problem infeasible
+ */
+TEST(DLXReduction, Infeasible) {
+  // covering {0,1} leaves no row for column 2
+  ExactCoverProblem problem(3);
+  problem.addRow({0, 1});
+  problem.addRow({1, 2});
+
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+  auto reduction = reduce(solver);
+
+  EXPECT_TRUE(reduction.infeasible);
+  EXPECT_EQ(1, reduction.forced_rows);
+  EXPECT_FALSE(solver.next());
+}
+
+/**
+ * Test: a solver whose search was started is left unchanged
+ */
+TEST(DLXReduction, StartedSearch) {
+  ExactCoverProblem problem(4);
+  problem.addRow({0, 1});
+  problem.addRow({1, 2});
+  problem.addRow({2});
+  problem.addRow({3});
+
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+  ASSERT_TRUE(solver.next());
+  EXPECT_FALSE(solver.isFresh());
+
+  auto reduction = reduce(solver);
+  EXPECT_EQ(0, reduction.columns_before);
+  EXPECT_EQ(0, reduction.forced_rows);
+  EXPECT_EQ(0, reduction.removed_rows);
+  EXPECT_FALSE(reduction.infeasible);
+
+  // the search resumes as without the reduction
+  EXPECT_FALSE(solver.next());
+  EXPECT_EQ(1, solver.getSolutions());
+}
+
+/**
+ * Test: a reduced solver enumerates the same solutions as without reduction, after covering
+ * an input row, on random problems
+ */
+TEST(DLXReduction, SameSolutions) {
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> column_distribution(0, 7);
+  std::uniform_int_distribution<int> size_distribution(1, 3);
+
+  int reduced = 0;
+  for (int instance = 0; instance < 200; instance++) {
+    ExactCoverProblem problem(8);
+    for (int row = 0; row < 14; row++) {
+      std::vector<int> columns;
+      for (int i = size_distribution(random); i > 0; i--) {
+        columns.push_back(column_distribution(random));
+      }
+      std::ranges::sort(columns);
+      auto end = std::ranges::unique(columns).begin();
+      columns.erase(end, columns.end());
+      problem.addRow(columns);
+    }
+
+    Solver reference(std::make_unique<DancingLinksMatrix>(problem));
+    Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+    const bool covered = reference.coverRow(reference.getMatrix()->getRow(0));
+    ASSERT_EQ(covered, solver.coverRow(solver.getMatrix()->getRow(0)));
+
+    auto reduction = reduce(solver);
+    EXPECT_LE(reduction.columns_after, reduction.columns_before);
+    EXPECT_LE(reduction.rows_after, reduction.rows_before);
+    reduced += reduction.columns_after < reduction.columns_before ? 1 : 0;
+
+    auto expected = enumerate(reference);
+    auto found = enumerate(solver);
+    std::ranges::sort(expected);
+    std::ranges::sort(found);
+    ASSERT_EQ(expected, found) << "instance " << instance;
+  }
+
+  EXPECT_LT(0, reduced);
+}
+
+}  // namespace
+}  // namespace dlx
@@ -0,0 +1,188 @@
+#include "reduction.hpp"
+
+#include <vector>
+
+namespace dlx {
+namespace {
+/**
+ * Count the columns in the header row, which excludes covered and dropped columns.
+ */
+auto countColumns(DancingLinksMatrix &matrix) -> int {
+  int columns = 0;
+  auto *root = matrix.getRoot();
+  for (auto *header = root->getRight()->getHeader();
+       header != root;
+       header = header->getRight()->getHeader()) {
+    columns++;
+  }
+  return columns;
+}
+
+/**
+ * Count the rows not hidden by covering or removal. Every such row is in at least one column of
+ * the header row, and it is counted in the first of those columns by index.
+ */
+auto countRows(DancingLinksMatrix &matrix) -> int {
+  int rows = 0;
+  auto *root = matrix.getRoot();
+  for (auto *header = root->getRight()->getHeader();
+       header != root;
+       header = header->getRight()->getHeader()) {
+    for (auto *row = header->getDown(); row != header; row = row->getDown()) {
+      bool first = true;
+      for (auto *node = row->getRight(); node != row && first; node = node->getRight()) {
+        auto *other = node->getHeader();
+        first = DancingLinksMatrix::isDropped(other) || other->getIndex() > header->getIndex();
+      }
+      rows += first ? 1 : 0;
+    }
+  }
+  return rows;
+}
+
+/**
+ * Get if the row of the given node has a node in the given column.
+ */
+auto inColumn(DancingLinkNode *row, DancingLinkHeader *header) -> bool {
+  auto *node = row;
+  do {
+    if (node->getHeader() == header) {
+      return true;
+    }
+    node = node->getRight();
+  } while (node != row);
+  return false;
+}
+
+/**
+ * Unlink all nodes of the row of the given node from their columns for good.
+ */
+void removeRow(DancingLinkNode *row) {
+  auto *node = row;
+  do {
+    node->removeVertical();
+    node->getHeader()->decCount();
+    node = node->getRight();
+  } while (node != row);
+}
+
+/**
+ * Cover every column that has a single row left with that row, until no such column remains.
+ *
+ * \return if any row was covered. A column without rows stops the scan, see Reduction::infeasible .
+ */
+auto coverForcedRows(Solver &solver, Reduction &result) -> bool {
+  bool changed = false;
+  auto *root = solver.getMatrix()->getRoot();
+  for (auto *header = root->getRight()->getHeader(); header != root;) {
+    if (header->getCount() == 0) {
+      result.infeasible = true;
+      return changed;
+    }
+
+    if (header->getCount() == 1) {
+      // the row cannot conflict with the rows covered before, as it is still active
+      solver.coverRow(header->getDown());
+      result.forced_rows++;
+      changed = true;
+
+      // covering changes the header row around this column, so scan it from the start again
+      header = root->getRight()->getHeader();
+      continue;
+    }
+
+    header = header->getRight()->getHeader();
+  }
+  return changed;
+}
+
+/**
+ * Remove the rows and drop the columns dominated by another column.
+ *
+ * \return if any row was removed, or any column dropped.
+ */
+auto removeDominated(DancingLinksMatrix &matrix, Reduction &result) -> bool {
+  bool changed = false;
+
+  // for every column, the number of rows it shares with the column at hand
+  std::pmr::vector<int> shared(static_cast<std::size_t>(matrix.getNumColumns()), 0, matrix.getMemoryResource());
+  std::pmr::vector<DancingLinkHeader *> touched(matrix.getMemoryResource());
+  std::pmr::vector<DancingLinkHeader *> dominated(matrix.getMemoryResource());
+
+  auto *root = matrix.getRoot();
+  for (auto *header = root->getRight()->getHeader();
+       header != root;
+       header = header->getRight()->getHeader()) {
+    // a column without rows makes the problem infeasible, which is left to coverForcedRows()
+    if (header->getCount() == 0) {
+      continue;
+    }
+
+    // the columns sharing all rows of this column dominate it
+    for (auto *row = header->getDown(); row != header; row = row->getDown()) {
+      for (auto *node = row->getRight(); node != row; node = node->getRight()) {
+        auto *other = node->getHeader();
+        if (!DancingLinksMatrix::isDropped(other) && shared[other->getIndex()]++ == 0) {
+          touched.push_back(other);
+        }
+      }
+    }
+    for (auto *other : touched) {
+      if (shared[other->getIndex()] == header->getCount()) {
+        dominated.push_back(other);
+      }
+      shared[other->getIndex()] = 0;
+    }
+    touched.clear();
+
+    // remove the rows of the dominating columns outside this column, then drop those columns.
+    // Dropping unlinks them from the header row, but not this column or the links around it.
+    for (auto *other : dominated) {
+      for (auto *row = other->getDown(); row != other;) {
+        auto *next = row->getDown();
+        if (!inColumn(row, header)) {
+          removeRow(row);
+          result.removed_rows++;
+        }
+        row = next;
+      }
+
+      matrix.dropColumn(other);
+      result.dropped_columns++;
+      changed = true;
+    }
+    dominated.clear();
+  }
+
+  return changed;
+}
+}  // namespace
+
+auto reduce(Solver &solver) -> Reduction {
+  // removing rows under a started search would corrupt the rows it has covered
+  if (!solver.isFresh()) {
+    return {};
+  }
+
+  auto &matrix = *solver.getMatrix();
+
+  Reduction result;
+  result.columns_before = countColumns(matrix);
+  result.rows_before = countRows(matrix);
+
+  // each pass shrinks the matrix, so this stops after at most one pass per column
+  bool changed = true;
+  while (changed) {
+    changed = coverForcedRows(solver, result);
+    if (result.infeasible) {
+      break;
+    }
+    changed = removeDominated(matrix, result) || changed;
+  }
+
+  result.columns_after = countColumns(matrix);
+  result.rows_after = countRows(matrix);
+  return result;
+}
+
+}  // namespace dlx
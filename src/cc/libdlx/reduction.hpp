@@ -0,0 +1,54 @@
+#ifndef LIBDLX_REDUCTION_HPP_
+#define LIBDLX_REDUCTION_HPP_
+
+#include "solver.hpp"
+
+namespace dlx {
+/**
+ * The outcome of reducing the matrix of a solver, see \link reduce() .
+ */
+struct Reduction {
+  // Number of active columns and rows before and after the reduction
+  int columns_before = 0;
+  int columns_after = 0;
+  int rows_before = 0;
+  int rows_after = 0;
+
+  // Number of rows forced into the solution
+  int forced_rows = 0;
+
+  // Number of rows removed as dominated, and of columns dropped as dominated
+  int removed_rows = 0;
+  int dropped_columns = 0;
+
+  // Whether a column was left without any rows, so that the problem has no solution
+  bool infeasible = false;
+};
+
+/**
+ * Shrink the matrix of the given solver before searching, after its givens have been covered.
+ *
+ * The following reductions are repeated until none applies (ref: Knuth, "Dancing links",
+ * The Art of Computer Programming, Volume 4B, on preprocessing exact cover problems):
+ *  - Forced rows: a column with a single row left can only be covered by that row, so the row
+ *    is covered via \link Solver::coverRow() and is part of every solution found afterwards.
+ *  - Dominated rows: if every row of column c also covers column d, then a row of d that is not
+ *    in c can never be chosen, as it would leave c without rows. Such rows are removed.
+ *  - Dominated columns: afterwards, d has the same rows as c, so covering c covers d as well.
+ *    Column d is dropped via \link DancingLinksMatrix::dropColumn() , so it is never searched.
+ *
+ * Removed rows are unlinked from their columns for good: they cannot be covered afterwards, and
+ * the solver enumerates the same solutions as without the reduction. Work units and checkpoints
+ * of a reduced solver are only valid for solvers that ran the same reduction.
+ *
+ * The reduction stops at a column without any rows, which makes the problem infeasible.
+ * It only applies to a solver whose search has not been started, see \link Solver::isFresh() ;
+ * any other solver is left unchanged.
+ *
+ * \return how much the matrix shrank, or an empty Reduction if the search was started.
+ */
+auto reduce(Solver &solver) -> Reduction;
+
+}  // namespace dlx
+
+#endif  // LIBDLX_REDUCTION_HPP_
@@ -0,0 +1,98 @@
+#include "search-trace.hpp"
+
+#include <memory>
+#include <sstream>
+#include <tuple>
+
+#include "gtest/gtest.h"
+#include "solver.hpp"
+
+namespace dlx {
+namespace {
+
+/**
+ * Test Helper: trace a full search over X = {0,1,2} with rows
+ *  0 = {0}, 1 = {1,2}, 2 = {0,1}, 3 = {2}
+ * having solutions {0,1} and {2,3}.
+ */
+auto traceTwoSolutions(std::size_t capacity) -> std::string {
+  ExactCoverProblem problem(3);
+  problem.addRow({0});
+  problem.addRow({1, 2});
+  problem.addRow({0, 1});
+  problem.addRow({2});
+
+  std::ostringstream output;
+  {
+    SearchTrace trace(output, capacity);
+    Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+    solver.setTrace(&trace);
+    while (solver.next()) {
+    }
+    EXPECT_EQ(4, solver.getNodes());
+  }
+  return output.str();
+}
+
+/**
+ * Test: every decision is recorded in order, and read back from the binary trace
+ */
+TEST(DLXSearchTrace, Record) {
+  std::istringstream input(traceTwoSolutions(3));
+  auto events = readTrace(input);
+  ASSERT_TRUE(events.has_value());
+
+  const std::vector<std::tuple<int, TraceOutcome, std::uint32_t, std::uint32_t, std::uint32_t>> expected = {
+      {0, TraceOutcome::Select, 0, 2, NoRow},    {0, TraceOutcome::Try, 0, 2, 0},
+      {1, TraceOutcome::Select, 1, 1, NoRow},    {1, TraceOutcome::Try, 1, 1, 1},
+      {2, TraceOutcome::Solution, NoRow, 0, NoRow},
+      {1, TraceOutcome::Backtrack, 1, 1, NoRow}, {0, TraceOutcome::Try, 0, 2, 2},
+      {1, TraceOutcome::Select, 2, 1, NoRow},    {1, TraceOutcome::Try, 2, 1, 3},
+      {2, TraceOutcome::Solution, NoRow, 0, NoRow},
+      {1, TraceOutcome::Backtrack, 2, 1, NoRow}, {0, TraceOutcome::Backtrack, 0, 2, NoRow},
+  };
+
+  ASSERT_EQ(expected.size(), events->size());
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    const auto &event = events->at(i);
+    EXPECT_EQ(expected[i], std::make_tuple(static_cast<int>(event.depth), event.outcome, event.column, event.count, event.row))
+        << "event " << i;
+  }
+}
+
+/**
+ * Test: a summary reports branching per depth, and estimates the tree size
+ */
+TEST(DLXSearchTrace, Summarize) {
+  std::istringstream input(traceTwoSolutions(DefaultTraceCapacity));
+  auto events = readTrace(input);
+  ASSERT_TRUE(events.has_value());
+
+  auto summary = summarizeTrace(events.value());
+  ASSERT_EQ(2, summary.depths.size());
+  EXPECT_EQ(1, summary.depths[0].selections);
+  EXPECT_EQ(2, summary.depths[0].tries);
+  EXPECT_EQ(2, summary.depths[1].selections);
+  EXPECT_EQ(2, summary.depths[1].candidates);
+  EXPECT_DOUBLE_EQ(1.0, summary.depths[1].branching());
+  EXPECT_EQ(4, summary.nodes);
+  EXPECT_EQ(2, summary.solutions);
+
+  // an exhaustive search is estimated at its actual size
+  EXPECT_DOUBLE_EQ(4.0, summary.estimated_nodes);
+
+  std::ostringstream table;
+  writeTraceSummary(table, summary);
+  EXPECT_NE(std::string::npos, table.str().find("estimated tree size: 4"));
+}
+
+/**
+ * Test: input that is not a trace is rejected
+ */
+TEST(DLXSearchTrace, Invalid) {
+  std::istringstream input("not a trace");
+  EXPECT_FALSE(readTrace(input).has_value());
+}
+
+}  // namespace
+}  // namespace dlx
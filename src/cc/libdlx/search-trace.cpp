@@ -0,0 +1,132 @@
+#include "search-trace.hpp"
+
+#include <array>
+#include <iomanip>
+#include <type_traits>
+
+namespace dlx {
+
+static_assert(std::is_trivially_copyable_v<TraceEvent> && sizeof(TraceEvent) == 16,
+              "trace events are written as fixed-size records");
+
+/**
+ * The magic bytes starting every trace, followed by the version and the size of an event
+ */
+constexpr std::array<char, 8> TraceMagic = {'D', 'L', 'X', 'T', 'R', 'A', 'C', 'E'};
+constexpr std::uint32_t TraceVersion = 1;
+
+/**
+ * Column width of the human-readable summary
+ */
+constexpr int SummaryColumnWidth = 12;
+
+SearchTrace::SearchTrace(std::ostream &output, std::size_t capacity)
+    : output(output), events(capacity == 0 ? 1 : capacity), size(0) {
+  const std::array<std::uint32_t, 2> header = {TraceVersion, sizeof(TraceEvent)};
+  this->output.write(TraceMagic.data(), TraceMagic.size());
+  this->output.write(reinterpret_cast<const char *>(header.data()), sizeof(header));
+}
+
+SearchTrace::~SearchTrace() {
+  this->flush();
+}
+
+void SearchTrace::flush() {
+  this->output.write(reinterpret_cast<const char *>(this->events.data()),
+                     static_cast<std::streamsize>(this->size * sizeof(TraceEvent)));
+  this->output.flush();
+  this->size = 0;
+}
+
+auto readTrace(std::istream &input) -> std::optional<std::vector<TraceEvent>> {
+  std::array<char, TraceMagic.size()> magic{};
+  std::array<std::uint32_t, 2> header{};
+  input.read(magic.data(), magic.size());
+  input.read(reinterpret_cast<char *>(header.data()), sizeof(header));
+
+  if (!input || magic != TraceMagic || header[0] != TraceVersion || header[1] != sizeof(TraceEvent)) {
+    return std::nullopt;
+  }
+
+  // read whole events until the end, ignoring a partially written last event
+  std::vector<TraceEvent> events;
+  TraceEvent event{};
+  while (input.read(reinterpret_cast<char *>(&event), sizeof(event))) {
+    events.push_back(event);
+  }
+  return events;
+}
+
+auto DepthStatistics::branching() const -> double {
+  return this->selections == 0 ? 0.0 : static_cast<double>(this->tries) / static_cast<double>(this->selections);
+}
+
+auto summarizeTrace(std::span<const TraceEvent> events) -> TraceSummary {
+  TraceSummary summary;
+
+  for (const TraceEvent &event : events) {
+    if (event.outcome == TraceOutcome::Solution) {
+      summary.solutions++;
+      continue;
+    }
+    if (event.outcome == TraceOutcome::Restart) {
+      summary.restarts++;
+      continue;
+    }
+
+    if (event.depth >= summary.depths.size()) {
+      summary.depths.resize(event.depth + 1);
+    }
+    auto &depth = summary.depths[event.depth];
+
+    switch (event.outcome) {
+      case TraceOutcome::Select:
+        depth.selections++;
+        depth.candidates += event.count;
+        if (event.count == 0) {
+          depth.dead_ends++;
+        }
+        break;
+      case TraceOutcome::Try:
+        depth.tries++;
+        summary.nodes++;
+        break;
+      case TraceOutcome::Backtrack:
+      case TraceOutcome::Solution:
+      case TraceOutcome::Restart:
+        break;
+    }
+  }
+
+  // the estimated number of nodes at the next level is the product of the mean branching so far
+  double level_nodes = 1.0;
+  for (const auto &depth : summary.depths) {
+    level_nodes *= depth.branching();
+    summary.estimated_nodes += level_nodes;
+  }
+
+  return summary;
+}
+
+void writeTraceSummary(std::ostream &output, const TraceSummary &summary) {
+  output << std::left << std::setw(SummaryColumnWidth) << "depth" << std::right;
+  for (const char *column : {"selections", "tries", "candidates", "dead ends", "branching"}) {
+    output << std::setw(SummaryColumnWidth) << column;
+  }
+  output << '\n';
+
+  for (std::size_t level = 0; level < summary.depths.size(); level++) {
+    const auto &depth = summary.depths[level];
+    output << std::left << std::setw(SummaryColumnWidth) << level << std::right
+           << std::setw(SummaryColumnWidth) << depth.selections
+           << std::setw(SummaryColumnWidth) << depth.tries
+           << std::setw(SummaryColumnWidth) << depth.candidates
+           << std::setw(SummaryColumnWidth) << depth.dead_ends
+           << std::setw(SummaryColumnWidth) << std::fixed << std::setprecision(2) << depth.branching() << '\n';
+  }
+
+  output << "nodes: " << summary.nodes << ", solutions: " << summary.solutions << ", restarts: " << summary.restarts
+         << ", estimated tree size: " << std::fixed << std::setprecision(0) << summary.estimated_nodes << '\n';
+}
+
+}  // namespace dlx
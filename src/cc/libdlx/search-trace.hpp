@@ -0,0 +1,184 @@
+#ifndef LIBDLX_SEARCH_TRACE_HPP_
+#define LIBDLX_SEARCH_TRACE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dlx {
+/**
+ * The kinds of search decisions recorded in a \link TraceEvent .
+ */
+enum class TraceOutcome : std::uint8_t {
+  // A column was selected for covering, having count candidate rows
+  Select,
+
+  // A row of the selected column was tried as part of the partial solution
+  Try,
+
+  // Every row of the selected column was tried, so the search backtracks
+  Backtrack,
+
+  // A solution was found
+  Solution,
+
+  // A randomized search restarted from the top level, see Solver::randomize()
+  Restart
+};
+
+/**
+ * A single search decision, as recorded by \link SearchTrace .
+ *
+ * Events are fixed-size records, written to the trace file as is.
+ */
+struct TraceEvent {
+  // The search level at which the decision was made, starting at 0
+  std::uint16_t depth;
+
+  // The kind of decision
+  TraceOutcome outcome;
+
+  std::uint8_t reserved;
+
+  // The column selected at this level, see DancingLinkNode::getIndex()
+  std::uint32_t column;
+
+  // The number of candidate rows of the selected column
+  std::uint32_t count;
+
+  // The row tried, if its data element holds an (int) row index; NoRow otherwise
+  std::uint32_t row;
+};
+
+/**
+ * Marker for an unknown column or row in a \link TraceEvent .
+ */
+constexpr std::uint32_t NoRow = UINT32_MAX;
+
+/**
+ * Number of events buffered by a \link SearchTrace before writing them, if not specified
+ */
+constexpr std::size_t DefaultTraceCapacity = 4096;
+
+/**
+ * A SearchTrace records the decisions of a \link Solver into a binary trace,
+ * for offline profiling of slow searches, see \link summarizeTrace() .
+ *
+ * Events are appended to a fixed-size buffer, which is written out as a whole when full,
+ * so recording an event is a store and an increment. The trace starts with a small file
+ * header, followed by the events in native byte order.
+ *
+ * Tracing is opt-in per solver, see \link Solver::setTrace() .
+ */
+class SearchTrace {
+ public:
+  /**
+   * Constructs a new trace writing to the given stream, which must outlive this trace.
+   *
+   * \param capacity The number of events buffered before they are written.
+   */
+  explicit SearchTrace(std::ostream &output, std::size_t capacity = DefaultTraceCapacity);
+
+  SearchTrace(const SearchTrace &) = delete;
+  SearchTrace(SearchTrace &&) = delete;
+  auto operator=(const SearchTrace &) -> SearchTrace & = delete;
+  auto operator=(SearchTrace &&) -> SearchTrace & = delete;
+
+  /**
+   * Writes the remaining buffered events.
+   */
+  ~SearchTrace();
+
+  /**
+   * Records a single event.
+   */
+  void record(const TraceEvent &event) {
+    this->events[this->size++] = event;
+    if (this->size == this->events.size()) {
+      this->flush();
+    }
+  }
+
+  /**
+   * Writes all buffered events to the stream.
+   */
+  void flush();
+
+ private:
+  // The stream the trace is written to
+  std::ostream &output;
+
+  // The buffered events, of which the first size are in use
+  std::vector<TraceEvent> events;
+  std::size_t size;
+};
+
+/**
+ * Reads the events of a binary trace, as written by \link SearchTrace .
+ *
+ * \return the events, or std::nullopt if the input is not a trace.
+ */
+auto readTrace(std::istream &input) -> std::optional<std::vector<TraceEvent>>;
+
+/**
+ * The decisions made at a single search level, see \link TraceSummary .
+ */
+struct DepthStatistics {
+  // Number of columns selected at this level
+  std::uint64_t selections = 0;
+
+  // Number of rows tried at this level, i.e., the search nodes at the next level
+  std::uint64_t tries = 0;
+
+  // Sum of the candidate counts of the selected columns
+  std::uint64_t candidates = 0;
+
+  // Number of columns selected without any candidate row
+  std::uint64_t dead_ends = 0;
+
+  /**
+   * The mean number of rows tried per selected column.
+   */
+  [[nodiscard]] auto branching() const -> double;
+};
+
+/**
+ * Per-level branching statistics of a recorded search, see \link summarizeTrace() .
+ */
+struct TraceSummary {
+  // The statistics per search level, starting at level 0
+  std::vector<DepthStatistics> depths;
+
+  // Number of search nodes (rows tried), and solutions found
+  std::uint64_t nodes = 0;
+  std::uint64_t solutions = 0;
+
+  // Number of restarts of a randomized search
+  std::uint64_t restarts = 0;
+
+  // Estimated number of nodes of the complete search tree, see summarizeTrace()
+  double estimated_nodes = 0;
+};
+
+/**
+ * Summarizes the given events into per-level branching statistics.
+ *
+ * The size of the complete search tree is estimated from the mean branching factor b(d)
+ * per level as b(0) + b(0)b(1) + b(0)b(1)b(2) + ... (ref: Knuth, "Estimating the efficiency
+ * of backtrack programs", 1975). For an exhaustive search this is close to the recorded
+ * number of nodes; for a search stopped at its first solution, it estimates the cost of
+ * enumerating all solutions.
+ */
+auto summarizeTrace(std::span<const TraceEvent> events) -> TraceSummary;
+
+/**
+ * Writes a human-readable table of the given summary.
+ */
+void writeTraceSummary(std::ostream &output, const TraceSummary &summary);
+
+}  // namespace dlx
+
+#endif  // LIBDLX_SEARCH_TRACE_HPP_
@@ -1,6 +1,12 @@
 #include "solver.hpp"
 
+#include <algorithm>
+#include <memory_resource>
+#include <ranges>
+#include <set>
+
 #include "gtest/gtest.h"
+#include "test-problems.hpp"
 
 namespace dlx {
 namespace {
@@ -52,5 +58,305 @@ TEST(DLXSolver, Basic) {
   }
 }
 
+/**
+ * Test Helper: create a matrix with two solutions over X = {1,2,3}:
+ *  A = {1}, B = {2,3}, C = {1,2}, D = {3}
+ * Solutions are {A,B} and {C,D}.
+ */
+auto createTwoSolutionMatrix() -> std::unique_ptr<DancingLinksMatrix> {
+  std::unique_ptr<DancingLinksMatrix> matrix = std::make_unique<DancingLinksMatrix>();
+
+  auto *header1 = matrix->newHeader();
+  auto *header2 = matrix->newHeader();
+  auto *header3 = matrix->newHeader();
+
+  auto *node_a1 = header1->newNode();
+  node_a1->setData('A');
+
+  auto *node_b2 = header2->newNode();
+  auto *node_b3 = header3->newNode();
+  DancingLinkNode::makeRow(node_b2, node_b3);
+  node_b2->setData('B');
+  node_b3->setData('B');
+
+  auto *node_c1 = header1->newNode();
+  auto *node_c2 = header2->newNode();
+  DancingLinkNode::makeRow(node_c1, node_c2);
+  node_c1->setData('C');
+  node_c2->setData('C');
+
+  auto *node_d3 = header3->newNode();
+  node_d3->setData('D');
+
+  return matrix;
+}
+
+/**
+ * Test Helper: the row names in a solution, in solution order
+ */
+auto rowNames(const Solution &solution) -> std::string {
+  std::string names;
+  for (auto *node : solution) {
+    names += static_cast<char>(node->getData());
+  }
+  return names;
+}
+
+/**
+ * Test: next() enumerates every solution once, then reports exhaustion
+ */
+TEST(DLXSolver, Next) {
+  Solver solver(createTwoSolutionMatrix());
+
+  EXPECT_TRUE(solver.next());
+  EXPECT_EQ("AB", rowNames(solver.getSolution()));
+  EXPECT_EQ(2, solver.getNodes());
+
+  EXPECT_TRUE(solver.next());
+  EXPECT_EQ("CD", rowNames(solver.getSolution()));
+  EXPECT_EQ(4, solver.getNodes());
+
+  EXPECT_FALSE(solver.next());
+  EXPECT_FALSE(solver.next());
+  EXPECT_EQ(4, solver.getNodes());
+}
+
+/**
+ * Test: solutions() lazily yields solutions, and can be limited to the first K
+ */
+TEST(DLXSolver, Solutions) {
+  Solver solver(createTwoSolutionMatrix());
+
+  std::vector<std::string> found;
+  for (const Solution &solution : solver.solutions() | std::views::take(1)) {
+    found.push_back(rowNames(solution));
+  }
+  EXPECT_EQ(std::vector<std::string>{"AB"}, found);
+
+  // the range resumes where the previous iteration stopped
+  for (const Solution &solution : solver.solutions()) {
+    found.push_back(rowNames(solution));
+  }
+  EXPECT_EQ((std::vector<std::string>{"AB", "CD"}), found);
+}
+
+/**
+ * Test: covered rows are part of every enumerated solution
+ */
+TEST(DLXSolver, NextWithCoveredRow) {
+  auto matrix = createTwoSolutionMatrix();
+  auto *root = matrix->getRoot();
+
+  // cover D = {3}, the last row in column 3
+  auto *node_d3 = root->getLeft()->getUp();
+
+  Solver solver(std::move(matrix));
+  EXPECT_TRUE(solver.coverRow(node_d3));
+
+  EXPECT_TRUE(solver.next());
+  EXPECT_EQ("DC", rowNames(solver.getSolution()));
+  EXPECT_FALSE(solver.next());
+}
+
+/**
+ * Test: a row conflicting with a covered row is rejected, leaving the matrix intact
+ */
+TEST(DLXSolver, ConflictingCoveredRow) {
+  auto matrix = createTwoSolutionMatrix();
+  auto *root = matrix->getRoot();
+
+  // D = {3} is the last row in column 3, and B = {2,3} the first
+  auto *node_d3 = root->getLeft()->getUp();
+  auto *node_b3 = root->getLeft()->getDown();
+
+  Solver solver(std::move(matrix));
+  EXPECT_TRUE(solver.coverRow(node_d3));
+  EXPECT_FALSE(solver.coverRow(node_b3));
+  EXPECT_FALSE(solver.coverRow(node_d3));
+
+  // the rejected rows did not affect the search
+  EXPECT_TRUE(solver.next());
+  EXPECT_EQ("DC", rowNames(solver.getSolution()));
+  EXPECT_FALSE(solver.next());
+}
+
+/**
+ * Test: a replica suspended at a solution resumes independently from the original
+ */
+TEST(DLXSolver, CloneAtSolution) {
+  Solver solver(createTwoSolutionMatrix());
+  EXPECT_TRUE(solver.next());
+
+  auto replica = solver.clone();
+  EXPECT_EQ("AB", rowNames(replica->getSolution()));
+  EXPECT_NE(solver.getSolution().front(), replica->getSolution().front());
+
+  EXPECT_TRUE(solver.next());
+  EXPECT_EQ("CD", rowNames(solver.getSolution()));
+  EXPECT_FALSE(solver.next());
+
+  // the original's backtracking left the replica untouched
+  EXPECT_TRUE(replica->next());
+  EXPECT_EQ("CD", rowNames(replica->getSolution()));
+  EXPECT_FALSE(replica->next());
+}
+
+/**
+ * Test: a replica keeps covered rows and header counts, and outlives the original
+ */
+TEST(DLXSolver, CloneWithCoveredRow) {
+  auto matrix = createTwoSolutionMatrix();
+  auto *root = matrix->getRoot();
+  auto *node_d3 = root->getLeft()->getUp();
+  auto *node_b3 = root->getLeft()->getDown();
+
+  auto solver = std::make_unique<Solver>(std::move(matrix));
+  EXPECT_TRUE(solver->coverRow(node_d3));
+
+  std::pmr::monotonic_buffer_resource arena;
+  auto replica = solver->clone(&arena);
+  auto *replica_root = replica->getMatrix()->getRoot();
+
+  // column 3 is covered, and covering D removed B from column 2
+  auto *header1 = replica_root->getRight()->getHeader();
+  auto *header2 = header1->getRight()->getHeader();
+  EXPECT_EQ(replica_root->getLeft(), header2);
+  EXPECT_EQ(2, header1->getCount());
+  EXPECT_EQ(1, header2->getCount());
+  EXPECT_FALSE(replica->coverRow(replica->getMatrix()->mapNode(node_b3)));
+
+  solver.reset();
+  EXPECT_TRUE(replica->next());
+  EXPECT_EQ("DC", rowNames(replica->getSolution()));
+  EXPECT_FALSE(replica->next());
+}
+
+/**
+ * Test: a randomized search enumerates every solution once, whatever the seed
+ */
+TEST(DLXSolver, Randomized) {
+  std::set<std::string> first_found;
+  for (std::uint64_t seed = 0; seed < 16; seed++) {
+    Solver solver(createTwoSolutionMatrix());
+    solver.randomize(seed, 1);
+
+    std::vector<std::string> found;
+    while (solver.next()) {
+      auto names = rowNames(solver.getSolution());
+      std::sort(names.begin(), names.end());
+      found.push_back(names);
+    }
+    ASSERT_EQ(2, found.size());
+    first_found.insert(found.front());
+
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ((std::vector<std::string>{"AB", "CD"}), found) << "seed " << seed;
+  }
+
+  // the order of the search depends on the seed
+  EXPECT_EQ(2, first_found.size());
+}
+
+/**
+ * Test: restarts neither lose solutions nor hide that there is none
+ */
+TEST(DLXSolver, RandomizedRestarts) {
+  // X = {0,1,2} cannot be covered by pairs only
+  ExactCoverProblem problem(3);
+  problem.addRow({0, 1});
+  problem.addRow({1, 2});
+  problem.addRow({0, 2});
+
+  Solver unsolvable(std::make_unique<DancingLinksMatrix>(problem));
+  unsolvable.randomize(7, 1);
+  EXPECT_FALSE(unsolvable.next());
+  EXPECT_LT(0, unsolvable.getRestarts());
+
+  // with {2} added, {0,1} + {2} is the only solution
+  problem.addRow({2});
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+  solver.randomize(7, 1);
+  ASSERT_TRUE(solver.next());
+  EXPECT_EQ(2, solver.getSolution().size());
+  EXPECT_FALSE(solver.next());
+}
+
+/**
+ * Test: rows of a fixed arity are searched by the specialized path, with the same result
+ * as the generic path
+ */
+TEST(DLXSolver, FixedRowArity) {
+  // X = {0..7} with rows of four columns each, having three solutions
+  ExactCoverProblem problem(8);
+  problem.addRow({0, 1, 2, 3});
+  problem.addRow({4, 5, 6, 7});
+  problem.addRow({0, 1, 4, 5});
+  problem.addRow({2, 3, 6, 7});
+  problem.addRow({0, 2, 4, 6});
+  problem.addRow({1, 3, 5, 7});
+  problem.addRow({0, 3, 5, 6});
+
+  Solver fixed(std::make_unique<DancingLinksMatrix>(problem));
+  Solver generic(std::make_unique<DancingLinksMatrix>(problem));
+  EXPECT_EQ(FixedRowArity, fixed.getRowArity());
+  generic.useGenericRows();
+  EXPECT_EQ(VariableArity, generic.getRowArity());
+
+  auto found = enumerate(fixed);
+  EXPECT_EQ((std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4, 5}}), found);
+  EXPECT_EQ(found, enumerate(generic));
+  EXPECT_EQ(generic.getNodes(), fixed.getNodes());
+
+  // covered input rows and restarts use the generic path on the same matrix
+  Solver covered(std::make_unique<DancingLinksMatrix>(problem));
+  ASSERT_TRUE(covered.coverRow(covered.getMatrix()->getRow(2)));
+  covered.randomize(3, 1);
+  EXPECT_EQ((std::vector<std::vector<int>>{{2, 3}}), enumerate(covered));
+
+  // rows of different arity use the generic path
+  problem.addRow({0, 1});
+  EXPECT_EQ(VariableArity, Solver(std::make_unique<DancingLinksMatrix>(problem)).getRowArity());
+}
+
+/**
+ * Test: the tree size is estimated exactly if the search has no choice, and on average otherwise,
+ * leaving the matrix as it was
+ */
+TEST(DLXSolver, EstimateTreeSize) {
+  // X = {0,1,2} covered by singletons only: a single path of three nodes
+  ExactCoverProblem forced(3);
+  forced.addRow({0});
+  forced.addRow({1});
+  forced.addRow({2});
+  Solver path(std::make_unique<DancingLinksMatrix>(forced));
+  EXPECT_EQ(3.0, path.estimateTreeSize(MinEstimateProbes, 0));
+
+  // the three solutions of X = {0..7}, see FixedRowArity
+  ExactCoverProblem problem(8);
+  problem.addRow({0, 1, 2, 3});
+  problem.addRow({4, 5, 6, 7});
+  problem.addRow({0, 1, 4, 5});
+  problem.addRow({2, 3, 6, 7});
+  problem.addRow({0, 2, 4, 6});
+  problem.addRow({1, 3, 5, 7});
+  problem.addRow({0, 3, 5, 6});
+
+  Solver solver(std::make_unique<DancingLinksMatrix>(problem));
+  constexpr int Seeds = 200;
+  double total = 0;
+  for (std::uint64_t seed = 0; seed < Seeds; seed++) {
+    total += solver.estimateTreeSize(MinEstimateProbes, seed).value();
+  }
+
+  // estimating neither searched nor changed the matrix
+  EXPECT_EQ(0, solver.getNodes());
+  EXPECT_EQ((std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4, 5}}), enumerate(solver));
+  EXPECT_NEAR(static_cast<double>(solver.getNodes()), total / Seeds, 0.2 * static_cast<double>(solver.getNodes()));
+
+  // the estimate is of a fresh search only
+  EXPECT_FALSE(solver.estimateTreeSize(MinEstimateProbes, 0).has_value());
+  EXPECT_FALSE(Solver(std::make_unique<DancingLinksMatrix>(problem)).estimateTreeSize(0, 0).has_value());
+}
+
 }  // namespace
 }  // namespace dlx
\ No newline at end of file
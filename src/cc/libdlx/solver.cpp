@@ -1,86 +1,795 @@
 #include "solver.hpp"
 
+#include <algorithm>
 #include <limits>
+#include <utility>
 
 namespace dlx {
+namespace {
+/**
+ * Hint the processor to load the given node into the cache ahead of its use.
+ */
+inline void prefetch(const DancingLinkNode *node) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(node);
+#else
+  static_cast<void>(node);
+#endif
+}
+
+/**
+ * Marker for a search that is not being split
+ */
+constexpr std::size_t NoSplit = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Marker for a search without a scheduled checkpoint, or without a cancel predicate
+ */
+constexpr std::uint64_t NoCheckpoint = std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * Odd multiplier and shifts of the problem fingerprint (from the splitmix64 finalizer)
+ */
+constexpr std::uint64_t HashMultiplier = 0x9E3779B97F4A7C15ULL;
+constexpr std::uint64_t MixMultiplier = 0xBF58476D1CE4E5B9ULL;
+constexpr unsigned MixShift = 31;
+
+/**
+ * Helper method to add a word to a fingerprint.
+ */
+inline auto hashWord(std::uint64_t hash, std::uint64_t word) -> std::uint64_t {
+  return (hash ^ word) * HashMultiplier;
+}
+}  // namespace
+
 Solver::Solver(std::unique_ptr<DancingLinksMatrix> matrix)
-    : matrix(std::move(matrix)) {}
+    : matrix(std::move(matrix)),
+      solution(this->matrix->getMemoryResource()),
+      levels(this->matrix->getMemoryResource()),
+      state(SearchState::Fresh),
+      nodes(0),
+      num_solutions(0),
+      trace(nullptr),
+      starts(this->matrix->getMemoryResource()),
+      restart_unit(0),
+      restart_at(0),
+      restarts(0),
+      luby_u(1),
+      luby_v(1),
+      row_arity(this->matrix->getRowArity()),
+      split_depth(NoSplit),
+      checkpoint_at(NoCheckpoint),
+      checkpoint_interval(0),
+      cancel_at(NoCheckpoint),
+      cancel_interval(0) {}
+
+Solver::Solver(const Solver &other, std::pmr::memory_resource *resource)
+    : matrix(other.matrix->clone(resource)),
+      solution(resource),
+      levels(resource),
+      state(other.state),
+      nodes(other.nodes),
+      num_solutions(other.num_solutions),
+      trace(nullptr),
+      starts(resource),
+      random(other.random),
+      restart_unit(other.restart_unit),
+      restart_at(other.restart_at),
+      restarts(other.restarts),
+      luby_u(other.luby_u),
+      luby_v(other.luby_v),
+      row_arity(other.row_arity),
+      split_depth(NoSplit),
+      checkpoint_at(NoCheckpoint),
+      checkpoint_interval(0),
+      cancel_at(NoCheckpoint),
+      cancel_interval(0) {
+  this->solution.reserve(other.solution.size());
+  for (const auto *row : other.solution) {
+    this->solution.push_back(this->matrix->mapNode(row));
+  }
+
+  this->levels.reserve(other.levels.size());
+  for (const auto *header : other.levels) {
+    this->levels.push_back(this->matrix->mapNode(header)->getHeader());
+  }
+
+  this->starts.reserve(other.starts.size());
+  for (const auto *row : other.starts) {
+    this->starts.push_back(this->matrix->mapNode(row));
+  }
+}
+
+auto Solver::clone(std::pmr::memory_resource *resource) const -> std::unique_ptr<Solver> {
+  return std::make_unique<Solver>(*this, resource);
+}
+
+auto Solver::getMatrix() -> DancingLinksMatrix * {
+  return this->matrix.get();
+}
 
 auto Solver::solve() -> std::optional<Solution> {
-  if (this->search()) {
-    return this->solution;
+  if (this->next()) {
+    // copy using our own allocator, as a plain copy would use the default resource
+    return Solution(this->solution, this->solution.get_allocator());
   }
 
   return std::nullopt;
 }
 
-// @return if a solution is found
+// @return if a next solution is found
+auto Solver::next() -> bool {
+  if (this->row_arity == FixedRowArity) {
+    return this->search<FixedRowArity>();
+  }
+  return this->search<VariableArity>();
+}
+
+template <int Arity>
 auto Solver::search() -> bool {
-  auto *root = this->matrix->getRoot();
+  // whether to descend into a deeper level, or to backtrack and try the next row
+  bool descend = false;
 
-  // check if there are condition columns left.
-  // if not, then we found a valid solution
-  if (root->getRight() == root) {
-    // no columns left, so we have a valid solution
-    // the solution is already stored in solution as part of the cover actions
-    return true;
+  switch (this->state) {
+    case SearchState::Exhausted:
+      return false;
+    case SearchState::Fresh:
+    case SearchState::Paused:
+      descend = true;
+      break;
+    case SearchState::Found:
+      // resume by backtracking from the previously found solution
+      descend = false;
+      break;
   }
 
-  // no solution found, so we continue our search
-  // optimization: find column with lowest count
-  std::optional<DancingLinkHeader *> opt_header = this->selectHeaderColumn();
+  auto *root = this->matrix->getRoot();
 
-  // check if this is a good solution
-  if (!opt_header.has_value()) {
-    return false;
-  }
+  while (true) {
+    DancingLinkHeader *target_header = nullptr;
+    DancingLinkNode *row = nullptr;
 
-  auto *target_header = opt_header.value();
+    if (descend) {
+      // check if there are condition columns left.
+      // if not, then we found a valid solution
+      if (root->getRight() == root) {
+        // no columns left, so we have a valid solution
+        // the solution is already stored in solution as part of the cover actions
+        this->state = SearchState::Found;
+        this->num_solutions++;
+        if (this->trace != nullptr) [[unlikely]] {
+          this->traceDecision(TraceOutcome::Solution, nullptr, nullptr);
+        }
+        return true;
+      }
 
-  // cover this header column
-  Solver::cover(target_header);
+      // a split stops at its depth, reporting the rows chosen so far as a unit, see split()
+      if (this->levels.size() == this->split_depth) [[unlikely]] {
+        this->state = SearchState::Found;
+        return true;
+      }
+
+      // between two search nodes, the rows on the stack describe the search, see checkpoint()
+      if (this->nodes >= this->checkpoint_at.load(std::memory_order_relaxed)) [[unlikely]] {
+        if (!this->takeCheckpoint()) {
+          this->state = SearchState::Paused;
+          return false;
+        }
+      }
+
+      // likewise, a search that is no longer needed is paused between two search nodes
+      if (this->nodes >= this->cancel_at) [[unlikely]] {
+        this->cancel_at = this->nodes + this->cancel_interval;
+        if (this->cancel_predicate()) {
+          this->state = SearchState::Paused;
+          return false;
+        }
+      }
+
+      // until the first solution, a randomized search restarts whenever its node budget is spent
+      if (this->random.has_value() && this->state == SearchState::Fresh && this->restart_unit != 0 &&
+          this->nodes >= this->restart_at) [[unlikely]] {
+        this->restart();
+      }
+
+      // no solution found, so we continue our search
+      // optimization: find column with lowest count
+      target_header = this->selectHeaderColumn().value();
+      if (this->trace != nullptr) [[unlikely]] {
+        this->traceDecision(TraceOutcome::Select, target_header, nullptr);
+      }
+
+      // cover this header column and start with its first row,
+      // or with a random row in a randomized search
+      Solver::cover<Arity>(target_header);
+      this->levels.push_back(target_header);
+      row = target_header->getDown();
+      if (this->random.has_value()) [[unlikely]] {
+        row = this->randomRow(target_header);
+        this->starts.push_back(row);
+      }
+
+    } else {
+      // backtrack: check if there are levels left to resume
+      if (this->levels.empty()) {
+        this->state = SearchState::Exhausted;
+        return false;
+      }
+
+      // remove row from solution, so we may try with the next row
+      target_header = this->levels.back();
+      row = this->solution.back();
+      this->solution.pop_back();
+
+      // uncover all columns in row
+      Solver::uncoverOthers<Arity>(row);
+
+      row = row->getDown();
+      if (this->random.has_value()) [[unlikely]] {
+        // rows are tried cyclically from the random start, skipping over the header
+        if (row == target_header) {
+          row = row->getDown();
+        }
+        if (row == this->starts.back()) {
+          row = target_header;
+        }
+      }
+    }
+
+    // check if every row in this column has been tried
+    if (row == target_header) {
+      if (this->trace != nullptr) [[unlikely]] {
+        this->traceDecision(TraceOutcome::Backtrack, target_header, nullptr);
+      }
+
+      // uncover column and backtrack to the previous level
+      Solver::uncover<Arity>(target_header);
+      this->levels.pop_back();
+      if (this->random.has_value()) [[unlikely]] {
+        this->starts.pop_back();
+      }
+      descend = false;
+      continue;
+    }
 
-  // try every placement part of this column
-  // add it to the solution, recurse solve the smaller matrix,
-  // and backtrack if no good solution was found
-  for (auto *row = target_header->getDown(); row != target_header; row = row->getDown()) {
     // try solution with current row
+    if (this->trace != nullptr) [[unlikely]] {
+      this->traceDecision(TraceOutcome::Try, target_header, row);
+    }
     this->solution.push_back(row);
+    this->nodes++;
 
     // cover all other columns in this row
-    for (auto *node = row->getRight(); node != row; node = node->getRight()) {
-      Solver::cover(node->getHeader());
+    Solver::coverOthers<Arity>(row);
+
+    // continue the search with this row in the solution and all it's columns covered
+    descend = true;
+  }
+}
+
+auto Solver::getNodes() const -> std::uint64_t {
+  return this->nodes;
+}
+
+void Solver::randomize(std::uint64_t seed, std::uint64_t restart_unit) {
+  this->random.emplace(seed);
+  this->restart_unit = restart_unit;
+  this->luby_u = 1;
+  this->luby_v = 1;
+  this->restart_at = this->nodes + restart_unit;
+}
+
+auto Solver::getRestarts() const -> std::uint64_t {
+  return this->restarts;
+}
+
+auto Solver::randomRow(DancingLinkHeader *header) -> DancingLinkNode * {
+  auto *row = header->getDown();
+  if (header->getCount() > 1) {
+    for (auto skip = (*this->random)() % static_cast<std::uint64_t>(header->getCount()); skip > 0; skip--) {
+      row = row->getDown();
+    }
+  }
+  return row;
+}
+
+void Solver::restart() {
+  if (this->trace != nullptr) [[unlikely]] {
+    this->traceDecision(TraceOutcome::Restart, nullptr, nullptr);
+  }
+
+  // backtrack all levels at once, keeping the covered input rows
+  while (!this->levels.empty()) {
+    auto *row = this->solution.back();
+    this->solution.pop_back();
+    Solver::uncoverOthers<VariableArity>(row);
+
+    Solver::uncover<VariableArity>(this->levels.back());
+    this->levels.pop_back();
+    this->starts.pop_back();
+  }
+
+  // the next budget follows the Luby sequence 1, 1, 2, 1, 1, 2, 4, ..., see Knuth's reluctant doubling
+  if ((this->luby_u & (~this->luby_u + 1)) == this->luby_v) {
+    this->luby_u++;
+    this->luby_v = 1;
+  } else {
+    this->luby_v *= 2;
+  }
+
+  this->restarts++;
+  this->restart_at = this->nodes + (this->luby_v * this->restart_unit);
+}
+
+auto Solver::getRowArity() const -> int {
+  return this->row_arity;
+}
+
+void Solver::useGenericRows() {
+  this->row_arity = VariableArity;
+}
+
+auto Solver::split(std::size_t depth) -> std::vector<WorkUnit> {
+  std::vector<WorkUnit> units;
+  if (this->state != SearchState::Fresh || this->random.has_value()) {
+    return units;
+  }
+
+  // the rows covered before the split are not part of the prefixes
+  const auto inputs = this->solution.size();
+  const auto nodes = this->nodes;
+  const auto solutions = this->num_solutions;
+  const auto fingerprint = this->fingerprint();
+
+  this->split_depth = depth;
+  while (this->next()) {
+    WorkUnit unit;
+    unit.id = static_cast<std::uint32_t>(units.size());
+    unit.prefix = this->rowIndices(inputs);
+    unit.fingerprint = fingerprint;
+    units.push_back(std::move(unit));
+  }
+  this->split_depth = NoSplit;
+
+  // the exhausted search has backtracked every level, so it can be started afresh
+  this->state = SearchState::Fresh;
+  this->nodes = nodes;
+  this->num_solutions = solutions;
+
+  for (auto &unit : units) {
+    unit.units = static_cast<std::uint32_t>(units.size());
+  }
+  return units;
+}
+
+auto Solver::coverRows(std::span<const int> rows) -> bool {
+  return std::all_of(rows.begin(), rows.end(), [this](int row) {
+    return row >= 0 && row < this->matrix->getNumRows() && this->matrix->getRow(row) != nullptr &&
+           this->coverRow(this->matrix->getRow(row));
+  });
+}
+
+auto Solver::solveUnit(const WorkUnit &unit, bool all) -> std::optional<WorkResult> {
+  const auto inputs = this->solution.size();
+  if (this->state != SearchState::Fresh || unit.fingerprint != this->fingerprint() ||
+      !this->coverRows(unit.prefix)) {
+    return std::nullopt;
+  }
+
+  WorkResult result;
+  result.id = unit.id;
+  result.units = unit.units;
+  result.fingerprint = unit.fingerprint;
+  while (this->next()) {
+    if (result.solutions++ == 0) {
+      result.first = this->rowIndices(inputs);
+    }
+    if (!all) {
+      break;
+    }
+  }
+
+  // a subtree without any solution has been searched exhaustively as well, unless its search was paused
+  result.exhaustive = !this->isPaused() && (all || result.solutions == 0);
+  result.nodes = this->nodes;
+  return result;
+}
+
+auto Solver::rowIndices(std::size_t from) const -> std::vector<int> {
+  std::vector<int> rows;
+  rows.reserve(this->solution.size() - from);
+  for (auto it = this->solution.begin() + static_cast<std::ptrdiff_t>(from); it != this->solution.end(); it++) {
+    rows.push_back((*it)->getData());
+  }
+  return rows;
+}
+
+auto Solver::fingerprint() const -> std::uint64_t {
+  // the rows covered before the search are at the bottom of the stack, one row per level on top
+  auto inputs = this->rowIndices(0);
+  inputs.resize(this->solution.size() - this->levels.size());
+  return this->fingerprint(std::move(inputs));
+}
+
+auto Solver::fingerprint(std::vector<int> inputs) const -> std::uint64_t {
+  std::uint64_t hash = hashWord(0, static_cast<std::uint64_t>(this->matrix->getNumColumns()));
+  hash = hashWord(hash, static_cast<std::uint64_t>(this->matrix->getNumRows()));
+
+  // covering rows leaves the horizontal links of every row intact, so that its columns can be
+  // listed even if it is covered
+  for (int row = 0; row < this->matrix->getNumRows(); row++) {
+    auto *row_root = this->matrix->getRow(row);
+    hash = hashWord(hash, static_cast<std::uint64_t>(row));
+    auto *node = row_root;
+    do {
+      auto *header = node->getHeader();
+      hash = hashWord(hash, (static_cast<std::uint64_t>(header->getIndex()) << 1U) |
+                                (DancingLinksMatrix::isDropped(header) ? 1U : 0U));
+      node = node->getRight();
+    } while (node != row_root);
+  }
+
+  std::sort(inputs.begin(), inputs.end());
+  hash = hashWord(hash, inputs.size());
+  for (int row : inputs) {
+    hash = hashWord(hash, static_cast<std::uint64_t>(row));
+  }
+  return (hash ^ (hash >> MixShift)) * MixMultiplier;
+}
+
+auto Solver::getSolutions() const -> std::uint64_t {
+  return this->num_solutions;
+}
+
+auto Solver::countSolutions(std::size_t max_bytes, std::pmr::memory_resource *resource)
+    -> std::optional<CountResult> {
+  if (this->state != SearchState::Fresh) {
+    return std::nullopt;
+  }
+
+  // every level covers at least one column, so there are at most as many levels as columns
+  const auto columns = static_cast<std::size_t>(this->matrix->getNumColumns());
+  const std::size_t words = (columns + 63) / 64;
+  std::pmr::vector<std::uint64_t> keys((columns + 1) * words, 0, resource);
+  CountCache cache(words, max_bytes, resource);
+
+  CountResult result;
+  if (this->row_arity == FixedRowArity) {
+    result.solutions = this->countFrom<FixedRowArity>(cache, keys, words, result);
+  } else {
+    result.solutions = this->countFrom<VariableArity>(cache, keys, words, result);
+  }
+
+  result.subproblems = cache.size();
+  result.cache_full = cache.isFull();
+  return result;
+}
+
+template <int Arity>
+auto Solver::countFrom(CountCache &cache, std::span<std::uint64_t> keys, std::size_t words, CountResult &result)
+    -> std::uint64_t {
+  auto *root = this->matrix->getRoot();
+  if (root->getRight() == root) {
+    return 1;
+  }
+
+  // a single pass over the active columns builds the key, and selects the column with the lowest count
+  auto key = keys.first(words);
+  std::fill(key.begin(), key.end(), 0);
+  DancingLinkHeader *target_header = nullptr;
+  int min_count = std::numeric_limits<int>::max();
+  for (auto *header = root->getRight()->getHeader(); header != root; header = header->getRight()->getHeader()) {
+    key[header->getIndex() / 64] |= std::uint64_t{1} << (header->getIndex() % 64);
+    if (header->getCount() < min_count) {
+      min_count = header->getCount();
+      target_header = header;
     }
+  }
 
-    // recursive search with this row in the solution and all it's columns covered
-    if (this->search()) {
-      return true;
+  if (min_count == 0) {
+    return 0;
+  }
+  if (auto count = cache.find(key)) {
+    result.hits++;
+    return count.value();
+  }
+
+  // count the solutions of every row of the column, as search() would enumerate them
+  std::uint64_t total = 0;
+  Solver::cover<Arity>(target_header);
+  for (auto *row = target_header->getDown(); row != target_header; row = row->getDown()) {
+    result.nodes++;
+    Solver::coverOthers<Arity>(row);
+    const auto count = this->countFrom<Arity>(cache, keys.subspan(words), words, result);
+    Solver::uncoverOthers<Arity>(row);
+
+    if (count > std::numeric_limits<std::uint64_t>::max() - total) {
+      result.saturated = true;
+      total = std::numeric_limits<std::uint64_t>::max();
+    } else {
+      total += count;
     }
+  }
+  Solver::uncover<Arity>(target_header);
 
-    // remove row from solution, so we may try with the next row
+  cache.insert(key, total);
+  return total;
+}
+
+auto Solver::estimateTreeSize(int probes, std::uint64_t seed) -> std::optional<double> {
+  if (this->state != SearchState::Fresh || probes <= 0) {
+    return std::nullopt;
+  }
+
+  std::mt19937_64 generator(seed);
+  double total = 0;
+  std::uint64_t visited = 0;
+  int done = 0;
+  while (done < probes) {
+    const auto before = visited;
+    const double estimate = this->row_arity == FixedRowArity ? this->probe<FixedRowArity>(generator, visited)
+                                                             : this->probe<VariableArity>(generator, visited);
+    total += estimate;
+    done++;
+
+    // a path without any choice, estimating one node per level, is the whole tree
+    if (done == 1 && estimate == static_cast<double>(visited - before)) {
+      break;
+    }
+
+    // otherwise, stop once probing costs more than a share of the tree it estimates
+    if (done >= std::min(probes, MinEstimateProbes) && static_cast<double>(visited) * EstimateBudgetShare > total / done) {
+      break;
+    }
+  }
+  return total / done;
+}
+
+template <int Arity>
+auto Solver::probe(std::mt19937_64 &generator, std::uint64_t &visited) -> double {
+  auto *root = this->matrix->getRoot();
+  const auto inputs = this->solution.size();
+
+  // walk down a random path, until a solution or a dead end, with the rows of the path on the solution
+  double estimate = 0;
+  double width = 1;
+  while (root->getRight() != root) {
+    auto *header = this->selectHeaderColumn().value();
+    const int count = header->getCount();
+    if (count == 0) {
+      break;
+    }
+
+    // the number of nodes at the next level, if every node had as many rows as this one
+    width *= count;
+    estimate += width;
+
+    auto *row = header->getDown();
+    for (auto skip = generator() % static_cast<std::uint64_t>(count); skip > 0; skip--) {
+      row = row->getDown();
+    }
+    Solver::cover<Arity>(header);
+    Solver::coverOthers<Arity>(row);
+    this->solution.push_back(row);
+    visited++;
+  }
+
+  // backtrack the path, in the reverse order of covering
+  while (this->solution.size() > inputs) {
+    auto *row = this->solution.back();
     this->solution.pop_back();
+    Solver::uncoverOthers<Arity>(row);
+    Solver::uncover<Arity>(row->getHeader());
+  }
+  return estimate;
+}
 
-    // uncover all columns in row
-    for (auto *node = row->getLeft(); node != row; node = node->getLeft()) {
-      Solver::uncover(node->getHeader());
+auto Solver::checkpoint() const -> std::optional<Checkpoint> {
+  if (this->random.has_value()) {
+    return std::nullopt;
+  }
+
+  Checkpoint checkpoint;
+  checkpoint.num_columns = this->matrix->getNumColumns();
+  checkpoint.num_rows = this->matrix->getNumRows();
+  checkpoint.nodes = this->nodes;
+  checkpoint.solutions = this->num_solutions;
+  switch (this->state) {
+    case SearchState::Fresh:
+    case SearchState::Paused:
+      checkpoint.state = CheckpointState::Searching;
+      break;
+    case SearchState::Found:
+      checkpoint.state = CheckpointState::Found;
+      break;
+    case SearchState::Exhausted:
+      checkpoint.state = CheckpointState::Exhausted;
+      break;
+  }
+
+  // the rows covered before the search are at the bottom of the stack, one row per level on top
+  const auto inputs = this->solution.size() - this->levels.size();
+  for (std::size_t i = 0; i < this->solution.size(); i++) {
+    const int row = this->solution[i]->getData();
+    if (row == NoData) {
+      return std::nullopt;
+    }
+
+    if (i < inputs) {
+      checkpoint.inputs.push_back(row);
+    } else {
+      checkpoint.columns.push_back(static_cast<int>(this->levels[i - inputs]->getIndex()));
+      checkpoint.rows.push_back(row);
+    }
+  }
+  checkpoint.fingerprint = this->fingerprint(checkpoint.inputs);
+  return checkpoint;
+}
+
+auto Solver::resume(const Checkpoint &checkpoint) -> bool {
+  if (this->state != SearchState::Fresh || !this->solution.empty() || this->random.has_value() ||
+      checkpoint.num_columns != this->matrix->getNumColumns() || checkpoint.num_rows != this->matrix->getNumRows() ||
+      checkpoint.fingerprint != this->fingerprint(checkpoint.inputs) ||
+      checkpoint.columns.size() != checkpoint.rows.size() || !this->coverRows(checkpoint.inputs)) {
+    return false;
+  }
+
+  for (std::size_t level = 0; level < checkpoint.rows.size(); level++) {
+    const int row_index = checkpoint.rows[level];
+    if (row_index < 0 || row_index >= this->matrix->getNumRows() || this->matrix->getRow(row_index) == nullptr) {
+      return false;
     }
+
+    // find the node of the row in the column selected at this level
+    auto *row_root = this->matrix->getRow(row_index);
+    auto *row = row_root;
+    while (row->getHeader()->getIndex() != static_cast<std::uint32_t>(checkpoint.columns[level])) {
+      row = row->getRight();
+      if (row == row_root) {
+        return false;
+      }
+    }
+
+    // a row is still in the matrix as long as none of its columns is covered
+    auto *node = row;
+    do {
+      if (Solver::isCovered(node->getHeader())) {
+        return false;
+      }
+      node = node->getRight();
+    } while (node != row);
+
+    // repeat the steps of the search at this level, see search()
+    Solver::cover<VariableArity>(row->getHeader());
+    this->levels.push_back(row->getHeader());
+    this->solution.push_back(row);
+    Solver::coverOthers<VariableArity>(row);
+  }
+
+  switch (checkpoint.state) {
+    case CheckpointState::Searching:
+      this->state = SearchState::Paused;
+      break;
+    case CheckpointState::Found:
+      this->state = SearchState::Found;
+      break;
+    case CheckpointState::Exhausted:
+      if (!this->levels.empty()) {
+        return false;
+      }
+      this->state = SearchState::Exhausted;
+      break;
   }
 
-  // uncover column
-  Solver::uncover(target_header);
+  this->nodes = checkpoint.nodes;
+  this->num_solutions = checkpoint.solutions;
+  this->checkpoint_at.store(this->checkpoint_interval == 0 ? NoCheckpoint : this->nodes + this->checkpoint_interval,
+                            std::memory_order_relaxed);
+  return true;
+}
+
+void Solver::setCheckpointHandler(std::uint64_t interval, CheckpointHandler handler) {
+  this->checkpoint_interval = interval;
+  this->checkpoint_handler = std::move(handler);
+  this->checkpoint_at.store(interval == 0 ? NoCheckpoint : this->nodes + interval, std::memory_order_relaxed);
+}
+
+void Solver::setCancelPredicate(std::uint64_t interval, CancelPredicate cancelled) {
+  this->cancel_interval = interval;
+  this->cancel_predicate = std::move(cancelled);
+  this->cancel_at = interval == 0 || !this->cancel_predicate ? NoCheckpoint : this->nodes + interval;
+}
 
-  return false;
+void Solver::requestCheckpoint() {
+  this->checkpoint_at.store(0, std::memory_order_relaxed);
 }
 
-void Solver::coverRow(DancingLinkNode *row_root) {
+auto Solver::isPaused() const -> bool {
+  return this->state == SearchState::Paused;
+}
+
+auto Solver::isFresh() const -> bool {
+  return this->state == SearchState::Fresh;
+}
+
+auto Solver::takeCheckpoint() -> bool {
+  // schedule the next checkpoint first, so that a request during the handler is not lost
+  this->checkpoint_at.store(
+      this->checkpoint_interval == 0 ? NoCheckpoint : this->nodes + this->checkpoint_interval,
+      std::memory_order_relaxed);
+
+  // checkpoints of a split are of no use, as the split search is backtracked afterwards
+  if (!this->checkpoint_handler || this->split_depth != NoSplit) {
+    return true;
+  }
+
+  // the search is between two nodes, even if it was resumed from a solution
+  auto checkpoint = this->checkpoint();
+  if (!checkpoint.has_value()) {
+    return true;
+  }
+  checkpoint->state = CheckpointState::Searching;
+  return this->checkpoint_handler(checkpoint.value());
+}
+
+void Solver::setTrace(SearchTrace *trace) {
+  this->trace = trace;
+}
+
+void Solver::traceDecision(TraceOutcome outcome, DancingLinkHeader *header, DancingLinkNode *row) {
+  // a column is selected before it is pushed onto the levels, and its rows are tried on top
+  TraceEvent event{};
+  event.outcome = outcome;
+  event.column = NoRow;
+  event.row = NoRow;
+
+  if (outcome == TraceOutcome::Select || outcome == TraceOutcome::Solution || outcome == TraceOutcome::Restart) {
+    event.depth = static_cast<std::uint16_t>(this->levels.size());
+  } else {
+    event.depth = static_cast<std::uint16_t>(this->levels.size() - 1);
+  }
+
+  if (header != nullptr) {
+    event.column = header->getIndex();
+    event.count = static_cast<std::uint32_t>(header->getCount());
+  }
+
+  if (row != nullptr) {
+    if (const int index = row->getData(); index != NoData) {
+      event.row = static_cast<std::uint32_t>(index);
+    }
+  }
+
+  this->trace->record(event);
+}
+
+auto Solver::getSolution() const -> const Solution & {
+  return this->solution;
+}
+
+auto Solver::solutions() -> SolutionRange {
+  return SolutionRange(this);
+}
+
+auto Solver::coverRow(DancingLinkNode *row_root) -> bool {
+  // Check if any column of this row is already covered by a previously covered row
+  if (Solver::isCovered(row_root->getHeader())) {
+    return false;
+  }
+  for (auto *node = row_root->getRight(); node != row_root; node = node->getRight()) {
+    if (Solver::isCovered(node->getHeader())) {
+      return false;
+    }
+  }
+
   // Add placement to solution
   this->solution.push_back(row_root);
 
   // Cover every column in this row
-  Solver::cover(row_root->getHeader());
-  for (auto *node = row_root->getRight(); node != row_root; node = node->getRight()) {
-    Solver::cover(node->getHeader());
-  }
+  Solver::cover<VariableArity>(row_root->getHeader());
+  Solver::coverOthers<VariableArity>(row_root);
+
+  return true;
 }
 
 auto Solver::selectHeaderColumn() -> std::optional<DancingLinkHeader *> {
@@ -90,6 +799,21 @@ auto Solver::selectHeaderColumn() -> std::optional<DancingLinkHeader *> {
   DancingLinkHeader *target_header = nullptr;
   int minCount = std::numeric_limits<int>::max();
 
+  if (this->random.has_value()) [[unlikely]] {
+    // pick uniformly among the columns with the lowest count, via reservoir sampling
+    std::uint64_t ties = 0;
+    for (auto *header = root->getRight()->getHeader(); header != root; header = header->getRight()->getHeader()) {
+      if (header->getCount() < minCount) {
+        minCount = header->getCount();
+        target_header = header;
+        ties = 1;
+      } else if (header->getCount() == minCount && (*this->random)() % ++ties == 0) {
+        target_header = header;
+      }
+    }
+    return target_header != nullptr ? std::optional(target_header) : std::nullopt;
+  }
+
   for (auto *header = root->getRight()->getHeader();
        header != root;
        header = header->getRight()->getHeader()) {
@@ -108,6 +832,11 @@ auto Solver::selectHeaderColumn() -> std::optional<DancingLinkHeader *> {
   return std::nullopt;
 }
 
+auto Solver::isCovered(DancingLinkHeader *header) -> bool {
+  return header->getRight()->getLeft() != header;
+}
+
+template <int Arity>
 void Solver::cover(DancingLinkHeader *header) {
   // remove column header from the matrix
   // indicating this condition is satisfied
@@ -116,19 +845,41 @@ void Solver::cover(DancingLinkHeader *header) {
   // remove all rows in this column from other columns they are in
   // indicating this is no longer a way to satisfy those conditions
   for (auto *row = header->getDown(); row != header; row = row->getDown()) {
-    for (auto *node = row->getRight(); node != row; node = node->getRight()) {
-      node->removeVertical();
-      node->getHeader()->decCount();
+    if constexpr (Arity == VariableArity) {
+      for (auto *node = row->getRight(); node != row; node = node->getRight()) {
+        node->removeVertical();
+        node->getHeader()->decCount();
+      }
+    } else {
+      // fetch the next row while unlinking the other nodes of this row, in an unrolled loop
+      prefetch(row->getDown());
+      auto *node = row;
+      for (int i = 1; i < Arity; i++) {
+        node = node->getRight();
+        node->removeVertical();
+        node->getHeader()->decCount();
+      }
     }
   }
 }
 
+template <int Arity>
 void Solver::uncover(DancingLinkHeader *header) {
   // put back all rows in the column into other columns they were in
   for (auto *row = header->getUp(); row != header; row = row->getUp()) {
-    for (auto *node = row->getLeft(); node != row; node = node->getLeft()) {
-      node->reinsertVertical();
-      node->getHeader()->incCount();
+    if constexpr (Arity == VariableArity) {
+      for (auto *node = row->getLeft(); node != row; node = node->getLeft()) {
+        node->reinsertVertical();
+        node->getHeader()->incCount();
+      }
+    } else {
+      prefetch(row->getUp());
+      auto *node = row;
+      for (int i = 1; i < Arity; i++) {
+        node = node->getLeft();
+        node->reinsertVertical();
+        node->getHeader()->incCount();
+      }
     }
   }
 
@@ -136,4 +887,84 @@ void Solver::uncover(DancingLinkHeader *header) {
   header->reinsertHorizontal();
 }
 
+template <int Arity>
+void Solver::coverOthers(DancingLinkNode *row) {
+  if constexpr (Arity == VariableArity) {
+    for (auto *node = row->getRight(); node != row; node = node->getRight()) {
+      Solver::cover<Arity>(node->getHeader());
+    }
+  } else {
+    auto *node = row;
+    for (int i = 1; i < Arity; i++) {
+      node = node->getRight();
+      Solver::cover<Arity>(node->getHeader());
+    }
+  }
+}
+
+template <int Arity>
+void Solver::uncoverOthers(DancingLinkNode *row) {
+  // columns are uncovered in the reverse order of covering
+  if constexpr (Arity == VariableArity) {
+    for (auto *node = row->getLeft(); node != row; node = node->getLeft()) {
+      Solver::uncover<Arity>(node->getHeader());
+    }
+  } else {
+    auto *node = row;
+    for (int i = 1; i < Arity; i++) {
+      node = node->getLeft();
+      Solver::uncover<Arity>(node->getHeader());
+    }
+  }
+}
+
+SolutionIterator::SolutionIterator(Solver *solver)
+    : solver(solver), pending(true) {}
+
+void SolutionIterator::resolve() const {
+  if (this->pending) {
+    this->pending = false;
+    if (!this->solver->next()) {
+      // no more solutions, so become the end iterator
+      this->solver = nullptr;
+    }
+  }
+}
+
+auto SolutionIterator::operator*() const -> reference {
+  this->resolve();
+  return this->solver->getSolution();
+}
+
+auto SolutionIterator::operator->() const -> pointer {
+  this->resolve();
+  return &this->solver->getSolution();
+}
+
+auto SolutionIterator::operator++() -> SolutionIterator & {
+  this->pending = true;
+  return *this;
+}
+
+void SolutionIterator::operator++(int) {
+  ++(*this);
+}
+
+auto SolutionIterator::operator==(const SolutionIterator &other) const -> bool {
+  this->resolve();
+  other.resolve();
+  return this->solver == other.solver;
+}
+
+SolutionRange::SolutionRange(Solver *solver)
+    : solver(solver) {}
+
+auto SolutionRange::begin() const -> SolutionIterator {
+  return SolutionIterator(this->solver);
+}
+
+auto SolutionRange::end() const -> SolutionIterator {
+  return {};
+}
+
 }  // namespace dlx
\ No newline at end of file
@@ -1,10 +1,22 @@
 #ifndef LIBDLX_SOLVER_HPP_
 #define LIBDLX_SOLVER_HPP_
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
 #include <optional>
+#include <random>
+#include <span>
 #include <vector>
 
+#include "checkpoint.hpp"
+#include "count-cache.hpp"
 #include "dancing-links-matrix.hpp"
+#include "search-trace.hpp"
+#include "work-unit.hpp"
 
 namespace dlx {
 /**
@@ -21,8 +33,101 @@ namespace dlx {
  *
  * The data element from \link DancingLinkNode::getData() can be used to infer
  * the meaning or interpretation of a particular row in a given solution.
+ *
+ * A solution is allocated from the same memory resource as the matrix it was found in.
+ */
+using Solution = std::pmr::vector<DancingLinkNode *>;
+
+/**
+ * Called by the \link Solver to ask whether its search is still needed, see \link Solver::setCancelPredicate() .
+ *
+ * \return whether to cancel the search. If true, the search is paused right away.
+ */
+using CancelPredicate = std::function<bool()>;
+
+/**
+ * Number of search nodes per unit of the restart budget of a randomized search, if not specified
+ */
+constexpr std::uint64_t DefaultRestartUnit = 1024;
+
+/**
+ * Row arity for which the search is specialized, see \link Solver::getRowArity() .
+ * Every row of a Sudoku matrix has four nodes: its cell, row, column and box constraint.
+ */
+constexpr int FixedRowArity = 4;
+
+/**
+ * Share of its estimated search tree that \link Solver::estimateTreeSize() probes at most,
+ * unless the maximum number of probes is reached first
  */
-using Solution = std::vector<DancingLinkNode *>;
+constexpr int EstimateBudgetShare = 8;
+
+/**
+ * Number of probes \link Solver::estimateTreeSize() takes at least, unless the first one is exact
+ */
+constexpr int MinEstimateProbes = 16;
+
+class Solver;
+
+/**
+ * An input iterator over the solutions of a \link Solver , see \link Solver::solutions() .
+ *
+ * The search is resumed lazily: only when an advanced iterator is dereferenced or compared,
+ * the solver searches for the next solution. This way, taking the first K solutions
+ * (e.g., via std::views::take) never searches for solution K+1.
+ * Dereferencing yields a reference to the solver's current solution, which is only valid
+ * until the iterator is advanced again. A default-constructed iterator marks the end.
+ */
+class SolutionIterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = Solution;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Solution *;
+  using reference = const Solution &;
+
+  /**
+   * Constructs an end iterator.
+   */
+  SolutionIterator() = default;
+
+  /**
+   * Constructs an iterator on the next solution the given solver finds from its current state.
+   */
+  explicit SolutionIterator(Solver *solver);
+
+  auto operator*() const -> reference;
+  auto operator->() const -> pointer;
+  auto operator++() -> SolutionIterator &;
+  void operator++(int);
+  auto operator==(const SolutionIterator &other) const -> bool;
+
+ private:
+  // The solver being iterated, or nullptr for the end iterator
+  mutable Solver *solver = nullptr;
+
+  // Whether the solver still has to search for the solution this iterator points to
+  mutable bool pending = false;
+
+  /**
+   * Helper method to search for the next solution if still pending.
+   */
+  void resolve() const;
+};
+
+/**
+ * A range over the solutions of a \link Solver , see \link Solver::solutions() .
+ */
+class SolutionRange {
+ public:
+  explicit SolutionRange(Solver *solver);
+
+  [[nodiscard]] auto begin() const -> SolutionIterator;
+  [[nodiscard]] auto end() const -> SolutionIterator;
+
+ private:
+  Solver *solver;
+};
 
 /**
  * The Solver implements the Alogrithm X for solving an exact cover problem.
@@ -56,6 +161,20 @@ using Solution = std::vector<DancingLinkNode *>;
  *     - \link Solver::uncover() The uncover operation efficiently reinserts a row to the matrix
  *       when the algorithm backtracks to select a different row for a candidate partial solution.
  *       Uncover relies on the efficient O(1) reinsert operations in \link DancingLinkNode.
+ *
+ * If every row of the matrix has FixedRowArity nodes, the search runs a copy of cover and uncover
+ * specialized for that arity: the walk over the other nodes of a row is unrolled, and the next row
+ * is prefetched while the current one is unlinked. Other matrices use the generic path, which
+ * follows the links of every row until it returns to the row's first node.
+ *
+ * The search is implemented with an explicit stack instead of recursion, so that it can be
+ * suspended at every solution and resumed afterwards. Via \link Solver::next() or
+ * \link Solver::solutions() , solutions are produced one at a time as they are found,
+ * in memory bounded by the number of columns, however many solutions exist.
+ *
+ * The same explicit stack makes the search checkpointable: at any node, the rows on the stack
+ * describe where the search is, see \link Solver::checkpoint() . A long-running search can
+ * thereby be resumed in a new process, see \link Solver::resume() .
  */
 class Solver {
  public:
@@ -67,6 +186,28 @@ class Solver {
    */
   explicit Solver(std::unique_ptr<DancingLinksMatrix> matrix);
 
+  /**
+   * Constructs a replica of the given solver in its current state.
+   *
+   * The matrix is cloned (see \link DancingLinksMatrix::clone() ), and the partial solution
+   * and search levels are mapped onto the clone. Both solvers continue independently from
+   * the same point: e.g., after covering the givens of a puzzle, or while suspended at a solution.
+   *
+   * \param resource The memory resource from which the replica is allocated.
+   */
+  Solver(const Solver &other, std::pmr::memory_resource *resource);
+
+  /**
+   * Get a replica of this solver in its current state, see the copy constructor above.
+   */
+  [[nodiscard]] auto clone(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const
+      -> std::unique_ptr<Solver>;
+
+  /**
+   * Get the matrix modelling the exact cover problem.
+   */
+  auto getMatrix() -> DancingLinksMatrix *;
+
   /**
    * Solve for the provided matrix using an Alogrithm X implementation.
    *
@@ -75,29 +216,365 @@ class Solver {
    */
   auto solve() -> std::optional<Solution>;
 
+  /**
+   * Resume the search until the next solution is found.
+   *
+   * The first call starts the search; every further call backtracks from the previous
+   * solution and continues where the search left off. No solution is reported twice.
+   *
+   * \return if a next solution was found, available via \link getSolution() .
+   *         If false, all solutions have been enumerated.
+   */
+  auto next() -> bool;
+
+  /**
+   * Get the solution found by the last successful call to \link next() .
+   *
+   * The reference is only valid until the search is resumed.
+   */
+  [[nodiscard]] auto getSolution() const -> const Solution &;
+
+  /**
+   * Get a lazy range over all (remaining) solutions, see \link next() .
+   *
+   * For example, to process the first K solutions:
+   *   for (const Solution &solution : solver.solutions() | std::views::take(K)) { ... }
+   */
+  auto solutions() -> SolutionRange;
+
   /**
    * Cover a given row, marking it as predetermined input to the exact cover solution.
    *
    * Before finding a solution, one can setup a partial solution to use as a starting point.
+   * Rows can only be covered before the search is started.
+   *
+   * A row conflicts with the partial solution if any of its columns is already covered.
+   * Covering such a row would corrupt the matrix, so it is detected in O(1) per column
+   * beforehand, and rejected.
+   *
+   * \return if the row could be covered. If false, the problem has no solution with the
+   *         current partial solution; the matrix is unchanged.
+   */
+  auto coverRow(DancingLinkNode *row_root) -> bool;
+
+  /**
+   * Get the number of search nodes visited so far, i.e., the number of rows tried
+   * as part of a candidate partial solution. Covered input rows are not counted.
+   */
+  [[nodiscard]] auto getNodes() const -> std::uint64_t;
+
+  /**
+   * Record every search decision into the given trace, or stop tracing if nullptr.
+   *
+   * Without a trace, the search only checks a pointer per decision.
+   * The trace must outlive the search, or be unset before it is destroyed.
+   */
+  void setTrace(SearchTrace *trace);
+
+  /**
+   * Switch to a randomized search with the given seed, before the search is started.
+   *
+   * Ties between columns with the lowest count are broken uniformly at random, and the rows
+   * of a column are tried starting at a random row. Hard instances are thereby less likely to
+   * hit the same unlucky order every time.
+   *
+   * Until the first solution is found, the search restarts from the covered input rows
+   * whenever its node budget is spent. Budgets follow the Luby sequence (1, 1, 2, 1, 1, 2, 4, ...)
+   * times restart_unit nodes (ref: Luby, Sinclair and Zuckerman, "Optimal speedup of Las Vegas
+   * algorithms", 1993). As budgets grow without bound, an unsolvable problem is still
+   * reported as such. After the first solution, the remaining solutions are enumerated
+   * without restarts, so that none is reported twice.
+   *
+   * \param restart_unit Number of search nodes per unit of the restart budget, or 0 to never restart.
+   */
+  void randomize(std::uint64_t seed, std::uint64_t restart_unit = DefaultRestartUnit);
+
+  /**
+   * Get the number of restarts of a randomized search so far, see \link randomize() .
+   */
+  [[nodiscard]] auto getRestarts() const -> std::uint64_t;
+
+  /**
+   * Get the row arity the search is specialized for, or VariableArity for the generic path.
+   * See \link DancingLinksMatrix::getRowArity() .
+   */
+  [[nodiscard]] auto getRowArity() const -> int;
+
+  /**
+   * Use the generic search path, regardless of the row arity of the matrix.
+   * Both paths find the same solutions in the same order; this is meant for comparing them.
+   */
+  void useGenericRows();
+
+  /**
+   * Split the search into units, one for every node at the given depth of the search tree,
+   * before the search is started. See \link WorkUnit .
+   *
+   * The search is run up to the given depth, and the rows chosen above it are recorded in
+   * search order. A solution found above the split depth becomes a unit of its own. Afterwards,
+   * all levels are backtracked, so that the solver can still be searched as a whole.
+   *
+   * Rows are recorded by their data element, so the matrix must have been built from an
+   * \link ExactCoverProblem description. Rows covered before the split are not part of the
+   * units: each process searching a unit is expected to cover the same rows first, which is
+   * checked via the fingerprint of every unit, see \link fingerprint() .
+   * A randomized search, see \link randomize() , cannot be split.
+   */
+  auto split(std::size_t depth) -> std::vector<WorkUnit>;
+
+  /**
+   * Cover the rows with the given indices, see \link coverRow() and \link DancingLinksMatrix::getRow() .
+   *
+   * \return if every row could be covered. If false, some rows may have been covered already,
+   *         so the solver should be discarded.
+   */
+  auto coverRows(std::span<const int> rows) -> bool;
+
+  /**
+   * Search only the subtree of the given unit, by covering its prefix before the search is started.
+   *
+   * \param all Whether to enumerate all solutions of the subtree, or to stop at the first.
+   * \return the result, or std::nullopt if the unit does not belong to this problem:
+   *         its fingerprint differs, or its prefix conflicts with the covered rows.
+   */
+  auto solveUnit(const WorkUnit &unit, bool all) -> std::optional<WorkResult>;
+
+  /**
+   * Get a fingerprint of the problem searched: a hash of the columns of every row of the matrix,
+   * of the columns dropped from it (see \link reduce() ), and of the rows covered before the
+   * search, in any order.
+   *
+   * Work units and checkpoints carry the fingerprint of their problem, so that a unit, result or
+   * checkpoint of another problem, even one of the same size, is rejected instead of being counted.
+   */
+  [[nodiscard]] auto fingerprint() const -> std::uint64_t;
+
+  /**
+   * Get the number of solutions found so far, see \link next() .
+   */
+  [[nodiscard]] auto getSolutions() const -> std::uint64_t;
+
+  /**
+   * Count all solutions before the search is started, memoizing the count of every subproblem
+   * by its set of active columns, see \link CountCache .
+   *
+   * The search visits every distinct subproblem once, instead of once per partial solution
+   * leading to it, so its cost is tied to the number of distinct subproblems rather than to the
+   * number of solutions. Once the cache is full, further subproblems are counted by plain
+   * backtracking, so the count is exact regardless of the memory given. Afterwards, the matrix
+   * is back in its state before counting, and the search can still be started.
+   *
+   * \param max_bytes The memory the cache may grow to.
+   * \param resource The memory resource the cache and its keys are allocated from. As the cache
+   *                 drops its table whenever it grows, this should release memory on deallocation,
+   *                 unlike the std::pmr::monotonic_buffer_resource a matrix is often built in.
+   * \return the count, or std::nullopt if the search was already started.
+   */
+  auto countSolutions(std::size_t max_bytes = DefaultCountCacheBytes,
+                      std::pmr::memory_resource *resource = std::pmr::new_delete_resource())
+      -> std::optional<CountResult>;
+
+  /**
+   * Estimate the size of the search tree before the search is started, i.e., the number of
+   * search nodes visited when enumerating all solutions, via Knuth's Monte-Carlo estimator
+   * (ref: Knuth, "Estimating the efficiency of backtrack programs", 1975).
+   *
+   * Each probe walks a single random path from the root down: at every level, it selects
+   * the column the search would select, and follows one of its rows at random. With the
+   * number of rows d_1, d_2, ... along the path, the probe estimates the tree size as
+   * d_1 + d_1 d_2 + d_1 d_2 d_3 + ..., an unbiased estimate averaged over all probes.
+   * Each probe costs a single path, so a few probes are cheap even for huge trees, but
+   * their average varies considerably from seed to seed on unbalanced trees.
+   * As most probes underestimate an unbalanced tree, a few probes cannot tell a small tree
+   * from a large one: after MinEstimateProbes probes, probing stops once the nodes on all
+   * paths so far exceed 1 / EstimateBudgetShare of the estimate, so that larger trees are
+   * probed more often. A first path without any choice is the whole tree, e.g. for a Sudoku
+   * solved by forced placements alone, so it is not probed any further. Afterwards, the
+   * matrix is back in its state before estimating.
+   *
+   * \param probes The maximum number of random paths to average over.
+   * \param seed The seed of the random row choices.
+   * \return the estimate, or std::nullopt if the search was already started or probes is not positive.
+   */
+  auto estimateTreeSize(int probes, std::uint64_t seed) -> std::optional<double>;
+
+  /**
+   * Get a checkpoint of the search in its current state, see \link Checkpoint .
+   *
+   * Rows are recorded by their data element, so the matrix must have been built from an
+   * \link ExactCoverProblem description. A randomized search, see \link randomize() ,
+   * cannot be checkpointed.
+   *
+   * \return the checkpoint, or std::nullopt if the search cannot be checkpointed.
+   */
+  [[nodiscard]] auto checkpoint() const -> std::optional<Checkpoint>;
+
+  /**
+   * Restore the search from a checkpoint, before the search is started and before any row is
+   * covered: the checkpoint holds the rows covered before its search as well.
+   *
+   * Afterwards, \link next() continues exactly where the checkpointed search stopped, and
+   * the node and solution counts continue from those of the checkpoint.
+   *
+   * \return if the checkpoint could be restored. If false, it does not belong to this problem
+   *         (e.g., the matrix has another size or fingerprint, see \link fingerprint() , or a row
+   *         conflicts with the rows before it),
+   *         and some rows may have been covered already, so the solver should be discarded.
+   */
+  auto resume(const Checkpoint &checkpoint) -> bool;
+
+  /**
+   * Hand a checkpoint to the given handler every interval search nodes, and whenever requested
+   * via \link requestCheckpoint() . If the handler returns false, the search is paused: \link next()
+   * returns false, \link isPaused() returns true, and calling \link next() again continues.
+   *
+   * Checkpoints are taken between two search nodes. Until then, the search only compares its
+   * node count per node. The handler is called on the searching thread, so a slow handler
+   * stalls the search; see \link saveCheckpoint() for a small, atomic write.
+   *
+   * \param interval Number of search nodes between checkpoints, or 0 to only checkpoint on request.
+   */
+  void setCheckpointHandler(std::uint64_t interval, CheckpointHandler handler);
+
+  /**
+   * Request a checkpoint at the next search node, see \link setCheckpointHandler() .
+   *
+   * This is safe to call from another thread, or from a signal handler.
+   */
+  void requestCheckpoint();
+
+  /**
+   * Ask the given predicate every interval search nodes whether the search is still needed.
+   * If the predicate returns true, the search is paused as by the checkpoint handler:
+   * \link next() returns false, \link isPaused() returns true, and calling \link next() again continues.
+   *
+   * Unlike \link setCheckpointHandler() , no checkpoint is taken, so this is cheap enough for
+   * frequent checks, such as whether another thread already found what the search is looking for.
+   *
+   * \param interval Number of search nodes between calls of the predicate, or 0 to never call it.
+   */
+  void setCancelPredicate(std::uint64_t interval, CancelPredicate cancelled);
+
+  /**
+   * Get if the search was paused by the checkpoint handler or the cancel predicate,
+   * see \link setCheckpointHandler() and \link setCancelPredicate() .
    */
-  void coverRow(DancingLinkNode *row_root);
+  [[nodiscard]] auto isPaused() const -> bool;
+
+  /**
+   * Get if the search has not been started yet, so that the matrix is still in its state before solving.
+   */
+  [[nodiscard]] auto isFresh() const -> bool;
 
  private:
+  /**
+   * The state of the resumable search.
+   */
+  enum class SearchState : std::uint8_t {
+    // The search has not been started yet
+    Fresh,
+
+    // The search is suspended at a solution
+    Found,
+
+    // The search is suspended between two search nodes, see setCheckpointHandler(), setCancelPredicate()
+    // and resume()
+    Paused,
+
+    // All solutions have been enumerated
+    Exhausted
+  };
+
   // The matrix modelling the exact cover problem
   std::unique_ptr<DancingLinksMatrix> matrix;
 
   // The (partial) solution constructed during solving
   Solution solution;
 
+  // The column covered at each search level, in order.
+  // The row tried at each level is the matching entry at the end of solution.
+  std::pmr::vector<DancingLinkHeader *> levels;
+
+  // The state of the resumable search
+  SearchState state;
+
+  // The number of search nodes visited, and solutions found, so far
+  std::uint64_t nodes;
+  std::uint64_t num_solutions;
+
+  // The trace recording search decisions, or nullptr if not tracing
+  SearchTrace *trace;
+
+  // The row each level of a randomized search started at, as its rows are tried cyclically
+  std::pmr::vector<DancingLinkNode *> starts;
+
+  // The random generator of a randomized search, or std::nullopt for the deterministic search
+  std::optional<std::mt19937_64> random;
+
+  // The restart schedule: nodes per unit, the node count at which to restart next,
+  // the number of restarts so far, and the Luby sequence state
+  std::uint64_t restart_unit;
+  std::uint64_t restart_at;
+  std::uint64_t restarts;
+  std::uint64_t luby_u, luby_v;
+
+  // The row arity the search is specialized for, or VariableArity
+  int row_arity;
+
+  // The depth at which the search stops to report a work unit, see split()
+  std::size_t split_depth;
+
+  // The node count at which to take the next checkpoint, the number of nodes between checkpoints,
+  // and the handler the checkpoints are handed to, see setCheckpointHandler()
+  std::atomic<std::uint64_t> checkpoint_at;
+  std::uint64_t checkpoint_interval;
+  CheckpointHandler checkpoint_handler;
+
+  // The node count at which to call the cancel predicate next, the number of nodes between calls,
+  // and the predicate, see setCancelPredicate()
+  std::uint64_t cancel_at;
+  std::uint64_t cancel_interval;
+  CancelPredicate cancel_predicate;
+
+  /**
+   * Helper method to get the row indices of the current (partial) solution, from the given level on.
+   */
+  [[nodiscard]] auto rowIndices(std::size_t from) const -> std::vector<int>;
+
+  /**
+   * Helper method to get the fingerprint of the matrix with the given rows covered before the search,
+   * see fingerprint().
+   */
+  [[nodiscard]] auto fingerprint(std::vector<int> inputs) const -> std::uint64_t;
+
   /**
-   * Algorithm X Step function in the solving algorithm.
+   * Helper method to hand a checkpoint to the checkpoint handler, and schedule the next one.
    *
-   * This function implements one recursive call, implementing the steps documented above
-   * and calling search() recursively till a solution is found.
+   * \return whether to continue the search.
+   */
+  auto takeCheckpoint() -> bool;
+
+  /**
+   * The memoized count behind \link countSolutions() , specialized for rows of the given arity.
+   * Returns the (saturated) number of exact covers of the active columns.
    *
-   * \return if a solution has been found
-   * \post if return is true, then this->solution holds a valid solution.
+   * \param keys Scratch space for the active column bitset of every level, of words per level.
    */
+  template <int Arity>
+  auto countFrom(CountCache &cache, std::span<std::uint64_t> keys, std::size_t words, CountResult &result)
+      -> std::uint64_t;
+
+  /**
+   * A single probe of \link estimateTreeSize() , specialized for rows of the given arity.
+   * The nodes on its path are added to visited.
+   */
+  template <int Arity>
+  auto probe(std::mt19937_64 &generator, std::uint64_t &visited) -> double;
+
+  /**
+   * The search behind \link next() , specialized for rows of the given arity.
+   */
+  template <int Arity>
   auto search() -> bool;
 
   /**
@@ -106,11 +583,35 @@ class Solver {
    */
   auto selectHeaderColumn() -> std::optional<DancingLinkHeader *>;
 
+  /**
+   * Helper method to record a search decision at the current level into the trace.
+   */
+  void traceDecision(TraceOutcome outcome, DancingLinkHeader *header, DancingLinkNode *row);
+
+  /**
+   * Helper method to pick a random row of the given column, or the header if it has no rows.
+   */
+  auto randomRow(DancingLinkHeader *header) -> DancingLinkNode *;
+
+  /**
+   * Helper method to backtrack to the covered input rows and set the next restart budget.
+   */
+  void restart();
+
+  /**
+   * Helper method to check if the given column is covered, i.e., removed from the header row.
+   * The neighbours of a removed header no longer link back to it.
+   */
+  static auto isCovered(DancingLinkHeader *header) -> bool;
+
   /**
    * The cover operation efficiently removes a row from the matrix
    * upon including such a row in a candidate partial solution.
    * Cover relies on the efficient O(1) remove operations in \link DancingLinkNode.
+   *
+   * Every row in the column must have Arity nodes, unless Arity is VariableArity.
    */
+  template <int Arity>
   static void cover(DancingLinkHeader *header);
 
   /**
@@ -118,7 +619,17 @@ class Solver {
    * when the algorithm backtracks to select a different row for a candidate partial solution.
    * Uncover relies on the efficient O(1) reinsert operations in \link DancingLinkNode.
    */
+  template <int Arity>
   static void uncover(DancingLinkHeader *header);
+
+  /**
+   * Helper method to cover the columns of all nodes in the given row other than itself,
+   * and its reverse to uncover them again.
+   */
+  template <int Arity>
+  static void coverOthers(DancingLinkNode *row);
+  template <int Arity>
+  static void uncoverOthers(DancingLinkNode *row);
 };
 
 }  // namespace dlx
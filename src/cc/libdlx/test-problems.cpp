@@ -0,0 +1,41 @@
+#include "test-problems.hpp"
+
+#include <algorithm>
+
+namespace dlx {
+auto describeTwoSolutionProblem() -> ExactCoverProblem {
+  ExactCoverProblem problem(3);
+  problem.addRow({0});
+  problem.addRow({1, 2});
+  problem.addRow({0, 1});
+  problem.addRow({2});
+  return problem;
+}
+
+auto describeChainProblem(int num_columns) -> ExactCoverProblem {
+  ExactCoverProblem problem(num_columns);
+  for (int column = 0; column < num_columns; column++) {
+    problem.addRow({column});
+    if (column + 1 < num_columns) {
+      problem.addRow({column, column + 1});
+    }
+    if (column + 2 < num_columns) {
+      problem.addRow({column, column + 1, column + 2});
+    }
+  }
+  return problem;
+}
+
+auto enumerate(Solver &solver) -> std::vector<std::vector<int>> {
+  std::vector<std::vector<int>> found;
+  while (solver.next()) {
+    std::vector<int> rows;
+    for (auto *row : solver.getSolution()) {
+      rows.push_back(row->getData());
+    }
+    std::sort(rows.begin(), rows.end());
+    found.push_back(rows);
+  }
+  return found;
+}
+}  // namespace dlx
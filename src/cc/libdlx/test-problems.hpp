@@ -0,0 +1,38 @@
+#ifndef LIBDLX_TEST_PROBLEMS_HPP_
+#define LIBDLX_TEST_PROBLEMS_HPP_
+
+#include <vector>
+
+#include "exact-cover-problem.hpp"
+#include "solver.hpp"
+
+namespace dlx {
+/**
+ * Test Helper: describe a problem with two solutions over X = {1,2,3}:
+ *  A = {1}, B = {2,3}, C = {1,2}, D = {3}
+ * Solutions are {A,B} and {C,D}, i.e. rows {0,1} and {2,3}.
+ *
+ * Only for the unit tests of this library.
+ */
+auto describeTwoSolutionProblem() -> ExactCoverProblem;
+
+/**
+ * Test Helper: describe X = {0..n-1} covered by rows of single columns, pairs and triples of
+ * neighbours. Its number of solutions grows exponentially with n, while its subproblems grow
+ * linearly, and rows are hidden from and restored to many columns during the search.
+ *
+ * Only for the unit tests of this library.
+ */
+auto describeChainProblem(int num_columns) -> ExactCoverProblem;
+
+/**
+ * Test Helper: enumerate all solutions of a solver over the matrix of an ExactCoverProblem,
+ * as the sorted row indices of every solution, in the order they are found.
+ *
+ * Only for the unit tests of this library.
+ */
+auto enumerate(Solver &solver) -> std::vector<std::vector<int>>;
+
+}  // namespace dlx
+
+#endif  // LIBDLX_TEST_PROBLEMS_HPP_
@@ -0,0 +1,168 @@
+#include "work-unit.hpp"
+
+#include <memory>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "solver.hpp"
+
+namespace dlx {
+namespace {
+
+/**
+ * Test Helper: X = {0..5} covered by rows of pairs and single columns, having many solutions.
+ */
+auto createProblem() -> ExactCoverProblem {
+  ExactCoverProblem problem(6);
+  for (int column = 0; column < 6; column++) {
+    problem.addRow({column});
+    if (column + 1 < 6) {
+      problem.addRow({column, column + 1});
+    }
+  }
+  problem.addRow({0, 5});
+  return problem;
+}
+
+/**
+ * Test: the units of a split, searched separately, together find every solution once
+ */
+TEST(DLXWorkUnit, SplitAndMerge) {
+  auto problem = createProblem();
+
+  Solver sequential(std::make_unique<DancingLinksMatrix>(problem));
+  auto expected = sequential.solveUnit(WorkUnit{0, 1, {}, sequential.fingerprint()}, true);
+  ASSERT_TRUE(expected.has_value());
+  ASSERT_LT(1, expected->solutions);
+
+  for (std::size_t depth = 0; depth < 4; depth++) {
+    Solver splitter(std::make_unique<DancingLinksMatrix>(problem));
+    auto units = splitter.split(depth);
+    ASSERT_FALSE(units.empty());
+    EXPECT_EQ(0, splitter.getNodes());
+
+    // every unit travels through its text format to a fresh solver, as to another process
+    std::vector<WorkResult> results;
+    for (const auto &unit : units) {
+      std::stringstream unit_file;
+      writeWorkUnit(unit_file, unit);
+      auto loaded = readWorkUnit(unit_file);
+      ASSERT_TRUE(loaded.has_value());
+      EXPECT_EQ(unit.prefix, loaded->prefix);
+      EXPECT_EQ(sequential.fingerprint(), loaded->fingerprint);
+
+      Solver worker(std::make_unique<DancingLinksMatrix>(problem));
+      auto result = worker.solveUnit(loaded.value(), true);
+      ASSERT_TRUE(result.has_value());
+
+      std::stringstream result_file;
+      writeWorkResult(result_file, result.value());
+      results.push_back(readWorkResult(result_file).value());
+    }
+
+    // merged in reverse order, and with a duplicate
+    std::vector<WorkResult> shuffled(results.rbegin(), results.rend());
+    shuffled.push_back(results.front());
+    auto merged = mergeResults(shuffled);
+    ASSERT_TRUE(merged.has_value());
+    EXPECT_TRUE(merged->exhaustive) << "depth " << depth;
+    EXPECT_TRUE(merged->missing.empty());
+    EXPECT_EQ(expected->solutions, merged->solutions) << "depth " << depth;
+    EXPECT_EQ(expected->first, merged->first) << "depth " << depth;
+    EXPECT_EQ(sequential.fingerprint(), merged->fingerprint);
+
+    // the nodes above the split depth are visited by the splitter instead
+    EXPECT_GE(expected->nodes, merged->nodes);
+    if (depth == 0) {
+      EXPECT_EQ(expected->nodes, merged->nodes);
+    }
+
+    // the splitter can still be searched as a whole
+    EXPECT_EQ(expected->first, splitter.solveUnit(WorkUnit{0, 1, {}, splitter.fingerprint()}, false)->first);
+  }
+}
+
+/**
+ * Test: missing results, and a search stopped at its first solution, are not exhaustive
+ */
+TEST(DLXWorkUnit, Incomplete) {
+  auto problem = createProblem();
+  Solver splitter(std::make_unique<DancingLinksMatrix>(problem));
+  auto units = splitter.split(1);
+  ASSERT_LT(2, units.size());
+
+  Solver worker(std::make_unique<DancingLinksMatrix>(problem));
+  auto first = worker.solveUnit(units[1], false);
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(1, first->solutions);
+  EXPECT_FALSE(first->exhaustive);
+
+  std::vector<WorkResult> results = {first.value()};
+  auto merged = mergeResults(results);
+  ASSERT_TRUE(merged.has_value());
+  EXPECT_FALSE(merged->exhaustive);
+  EXPECT_EQ(units.size() - 1, merged->missing.size());
+  EXPECT_EQ(0, merged->missing.front());
+  EXPECT_FALSE(mergeResults({})->exhaustive);
+
+  // a prefix conflicting with the covered rows does not belong to the problem
+  Solver conflicting(std::make_unique<DancingLinksMatrix>(problem));
+  EXPECT_FALSE(conflicting.solveUnit(WorkUnit{0, 1, {0, 1}, conflicting.fingerprint()}, true).has_value());
+
+  std::istringstream invalid("dlx-unit 2 3 2 0\n0 1\n");
+  EXPECT_FALSE(readWorkUnit(invalid).has_value());
+}
+
+/**
+ * Test: units and results of another problem or another split are rejected
+ */
+TEST(DLXWorkUnit, Mismatch) {
+  auto problem = createProblem();
+  Solver splitter(std::make_unique<DancingLinksMatrix>(problem));
+  auto units = splitter.split(1);
+  ASSERT_LT(2, units.size());
+
+  // a problem of the same size, with another row
+  ExactCoverProblem other(6);
+  for (int row = 0; row < problem.getNumRows(); row++) {
+    auto columns = problem.getRow(row);
+    if (row + 1 == problem.getNumRows()) {
+      other.addRow({1, 4});
+    } else {
+      other.addRow(columns);
+    }
+  }
+  Solver stranger(std::make_unique<DancingLinksMatrix>(other));
+  EXPECT_NE(splitter.fingerprint(), stranger.fingerprint());
+  EXPECT_FALSE(stranger.solveUnit(units[0], true).has_value());
+
+  // the same problem with a row covered before the search
+  Solver covered(std::make_unique<DancingLinksMatrix>(problem));
+  ASSERT_TRUE(covered.coverRows(std::vector<int>{0}));
+  EXPECT_NE(splitter.fingerprint(), covered.fingerprint());
+
+  std::vector<WorkResult> results;
+  for (const auto &unit : units) {
+    Solver worker(std::make_unique<DancingLinksMatrix>(problem));
+    results.push_back(worker.solveUnit(unit, true).value());
+  }
+  ASSERT_TRUE(mergeResults(results).has_value());
+
+  // a result of a split into another number of units
+  auto deeper = results;
+  deeper.back().units++;
+  EXPECT_FALSE(mergeResults(deeper).has_value());
+
+  // a result of another problem
+  auto foreign = results;
+  foreign.back().fingerprint = stranger.fingerprint();
+  EXPECT_FALSE(mergeResults(foreign).has_value());
+
+  // a unit out of range
+  auto out_of_range = results;
+  out_of_range.back().id = out_of_range.back().units;
+  EXPECT_FALSE(mergeResults(out_of_range).has_value());
+}
+
+}  // namespace
+}  // namespace dlx
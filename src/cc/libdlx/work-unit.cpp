@@ -0,0 +1,127 @@
+#include "work-unit.hpp"
+
+#include <string>
+
+namespace dlx {
+
+/**
+ * The tags starting every unit and result, followed by the format version
+ */
+constexpr const char *UnitTag = "dlx-unit";
+constexpr const char *ResultTag = "dlx-result";
+constexpr int WorkUnitVersion = 2;
+
+namespace {
+/**
+ * Helper method to write row indices on a single line.
+ */
+void writeRows(std::ostream &output, std::span<const int> rows) {
+  for (std::size_t i = 0; i < rows.size(); i++) {
+    output << (i == 0 ? "" : " ") << rows[i];
+  }
+  output << '\n';
+}
+
+/**
+ * Helper method to read row indices from the rest of the input.
+ *
+ * \return if all remaining input consists of row indices.
+ */
+auto readRows(std::istream &input, std::vector<int> &rows) -> bool {
+  int row = 0;
+  while (input >> row) {
+    if (row < 0) {
+      return false;
+    }
+    rows.push_back(row);
+  }
+  return input.eof();
+}
+
+/**
+ * Helper method to read and check the tag and version of a unit or result.
+ */
+auto readTag(std::istream &input, const char *expected) -> bool {
+  std::string tag;
+  int version = 0;
+  return (input >> tag >> version) && tag == expected && version == WorkUnitVersion;
+}
+
+}  // namespace
+
+void writeWorkUnit(std::ostream &output, const WorkUnit &unit) {
+  output << UnitTag << ' ' << WorkUnitVersion << ' ' << unit.id << ' ' << unit.units << ' ' << unit.fingerprint
+         << '\n';
+  writeRows(output, unit.prefix);
+}
+
+auto readWorkUnit(std::istream &input) -> std::optional<WorkUnit> {
+  WorkUnit unit;
+  if (!readTag(input, UnitTag) || !(input >> unit.id >> unit.units >> unit.fingerprint) || unit.id >= unit.units ||
+      !readRows(input, unit.prefix)) {
+    return std::nullopt;
+  }
+  return unit;
+}
+
+void writeWorkResult(std::ostream &output, const WorkResult &result) {
+  output << ResultTag << ' ' << WorkUnitVersion << ' ' << result.id << ' ' << result.units << ' '
+         << result.fingerprint << ' ' << (result.exhaustive ? 1 : 0) << ' ' << result.solutions << ' ' << result.nodes << '\n';
+  writeRows(output, result.first);
+}
+
+auto readWorkResult(std::istream &input) -> std::optional<WorkResult> {
+  WorkResult result;
+  if (!readTag(input, ResultTag) ||
+      !(input >> result.id >> result.units >> result.fingerprint >> result.exhaustive >> result.solutions >> result.nodes) ||
+      result.id >= result.units || !readRows(input, result.first)) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+auto mergeResults(std::span<const WorkResult> results) -> std::optional<MergedResult> {
+  MergedResult merged;
+  merged.exhaustive = !results.empty();
+  if (results.empty()) {
+    return merged;
+  }
+
+  // all results must stem from the same split, as the counts of different splits do not add up
+  const std::uint32_t units = results.front().units;
+  merged.fingerprint = results.front().fingerprint;
+  for (const auto &result : results) {
+    if (result.units != units || result.fingerprint != merged.fingerprint || result.id >= units) {
+      return std::nullopt;
+    }
+  }
+
+  // index the results by unit, ignoring duplicates
+  std::vector<const WorkResult *> by_unit(units, nullptr);
+  for (const auto &result : results) {
+    if (by_unit[result.id] == nullptr) {
+      by_unit[result.id] = &result;
+    }
+  }
+
+  for (std::uint32_t id = 0; id < units; id++) {
+    const auto *result = by_unit[id];
+    if (result == nullptr) {
+      merged.missing.push_back(id);
+      merged.exhaustive = false;
+      continue;
+    }
+
+    merged.solutions += result->solutions;
+    merged.nodes += result->nodes;
+    merged.exhaustive = merged.exhaustive && result->exhaustive;
+    if (merged.solutions == result->solutions && result->solutions > 0) {
+      // the lowest unit with a solution
+      merged.first = result->first;
+    }
+  }
+
+  return merged;
+}
+
+}  // namespace dlx
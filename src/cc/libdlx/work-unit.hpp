@@ -0,0 +1,123 @@
+#ifndef LIBDLX_WORK_UNIT_HPP_
+#define LIBDLX_WORK_UNIT_HPP_
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace dlx {
+/**
+ * A subtree of the search for an exact cover, to be searched on its own, see \link Solver::split() .
+ *
+ * A unit is identified by the rows chosen at every search level above the split depth.
+ * The subtrees of all units of a split are disjoint, and together they hold every solution.
+ * Units only refer to rows by their index in the \link ExactCoverProblem description,
+ * so that any process building the same matrix can search them. The fingerprint of the problem,
+ * see \link Solver::fingerprint() , rejects a unit searched by a process building another matrix.
+ */
+struct WorkUnit {
+  // Position of this unit in its split, starting at 0
+  std::uint32_t id = 0;
+
+  // Number of units in the split
+  std::uint32_t units = 0;
+
+  // The row indices chosen above the split depth, from the top level down
+  std::vector<int> prefix;
+
+  // The fingerprint of the problem split, see Solver::fingerprint()
+  std::uint64_t fingerprint = 0;
+};
+
+/**
+ * The outcome of searching a single \link WorkUnit , see \link Solver::solveUnit() .
+ */
+struct WorkResult {
+  // The unit searched, see WorkUnit
+  std::uint32_t id = 0;
+  std::uint32_t units = 0;
+  std::uint64_t fingerprint = 0;
+
+  // Whether the whole subtree was searched, so that solutions counts all its solutions
+  bool exhaustive = false;
+
+  // Number of solutions found, and search nodes visited
+  std::uint64_t solutions = 0;
+  std::uint64_t nodes = 0;
+
+  // The row indices of the first solution found, including the prefix but not the rows covered
+  // before the search; empty if none was found
+  std::vector<int> first;
+};
+
+/**
+ * The results of all units of a split combined, see \link mergeResults() .
+ */
+struct MergedResult {
+  // Number of solutions found, and search nodes visited, over all units
+  std::uint64_t solutions = 0;
+  std::uint64_t nodes = 0;
+
+  // Whether every unit was searched exhaustively, so that solutions is the total count
+  bool exhaustive = true;
+
+  // The first solution of the lowest unit having one, being the first solution of the whole search
+  std::vector<int> first;
+
+  // The units of the split without a result
+  std::vector<std::uint32_t> missing;
+
+  // The fingerprint of the problem split, see Solver::fingerprint()
+  std::uint64_t fingerprint = 0;
+};
+
+/**
+ * Writes a unit in a line-based text format:
+ *
+ *   dlx-unit <version> <id> <units> <fingerprint>
+ *   <row> <row> ...
+ */
+void writeWorkUnit(std::ostream &output, const WorkUnit &unit);
+
+/**
+ * Reads a unit, as written by \link writeWorkUnit() .
+ *
+ * \return the unit, or std::nullopt if the input is not a unit.
+ */
+auto readWorkUnit(std::istream &input) -> std::optional<WorkUnit>;
+
+/**
+ * Writes a result in a line-based text format:
+ *
+ *   dlx-result <version> <id> <units> <fingerprint> <exhaustive> <solutions> <nodes>
+ *   <row> <row> ...
+ *
+ * where the second line lists the first solution found.
+ */
+void writeWorkResult(std::ostream &output, const WorkResult &result);
+
+/**
+ * Reads a result, as written by \link writeWorkResult() .
+ *
+ * \return the result, or std::nullopt if the input is not a result.
+ */
+auto readWorkResult(std::istream &input) -> std::optional<WorkResult>;
+
+/**
+ * Combines the results of the units of a split, in any order.
+ *
+ * Solution and node counts are summed. As units are numbered in search order, the first solution
+ * of the unit with the lowest id is the solution a single search would have found first.
+ * Units without a result are reported missing, and a duplicate result of a unit is counted once.
+ * Without any result, the number of units is unknown, so the merge is not exhaustive.
+ *
+ * \return the merged result, or std::nullopt if the results do not belong to the same split:
+ *         they disagree on the number of units or on the fingerprint, or a unit is out of range.
+ */
+auto mergeResults(std::span<const WorkResult> results) -> std::optional<MergedResult>;
+
+}  // namespace dlx
+
+#endif  // LIBDLX_WORK_UNIT_HPP_
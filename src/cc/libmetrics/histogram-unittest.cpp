@@ -0,0 +1,111 @@
+#include "histogram.hpp"
+
+#include "gtest/gtest.h"
+
+namespace metrics {
+namespace {
+
+/**
+ * Test: an empty histogram reports zeros
+ */
+TEST(Histogram, Empty) {
+  Histogram histogram;
+
+  EXPECT_EQ(0, histogram.getCount());
+  EXPECT_EQ(0, histogram.getMin());
+  EXPECT_EQ(0, histogram.getMax());
+  EXPECT_EQ(0, histogram.getPercentile(50));
+}
+
+/**
+ * Test: small values are recorded exactly
+ */
+TEST(Histogram, ExactSmallValues) {
+  Histogram histogram;
+  for (std::uint64_t value = 1; value <= 100; value++) {
+    histogram.record(value);
+  }
+
+  EXPECT_EQ(100, histogram.getCount());
+  EXPECT_EQ(5050, histogram.getSum());
+  EXPECT_EQ(1, histogram.getMin());
+  EXPECT_EQ(100, histogram.getMax());
+  EXPECT_EQ(50, histogram.getPercentile(50));
+  EXPECT_EQ(90, histogram.getPercentile(90));
+  EXPECT_EQ(99, histogram.getPercentile(99));
+  EXPECT_EQ(100, histogram.getPercentile(100));
+  EXPECT_EQ(10, histogram.getCountAtOrBelow(10));
+}
+
+/**
+ * Test: percentiles of large values are reported close to the recorded values
+ */
+TEST(Histogram, RelativeError) {
+  Histogram histogram;
+  for (std::uint64_t value = 1000; value <= 1000000; value += 1000) {
+    histogram.record(value);
+  }
+
+  auto p50 = static_cast<double>(histogram.getPercentile(50));
+  EXPECT_NEAR(500000, p50, 5000);
+  EXPECT_LE(500000, p50);
+
+  auto p99 = static_cast<double>(histogram.getPercentile(99));
+  EXPECT_NEAR(990000, p99, 9900);
+
+  EXPECT_EQ(1000000, histogram.getPercentile(100));
+  EXPECT_EQ(1000000, histogram.getMax());
+}
+
+/**
+ * Test: a bucket spans less than 1/64 of its lowest value, e.g. [8192, 8319]
+ */
+TEST(Histogram, RelativeErrorBound) {
+  for (int exponent = Histogram::SubBucketBits; exponent < 64; exponent++) {
+    const std::uint64_t lower = std::uint64_t{1} << exponent;
+    const std::uint64_t width = lower / 64;
+
+    // the highest value of the bucket of lower is counted with it, the next value is not
+    Histogram histogram;
+    histogram.record(lower + width - 1);
+    EXPECT_EQ(1, histogram.getCountAtOrBelow(lower)) << lower;
+    histogram.record(lower + width);
+    EXPECT_EQ(1, histogram.getCountAtOrBelow(lower)) << lower;
+    EXPECT_LT(64 * (width - 1), lower);
+  }
+
+  Histogram histogram;
+  histogram.record(8191);
+  histogram.record(8192);
+  histogram.record(8319);
+  histogram.record(8320);
+  EXPECT_EQ(3, histogram.getCountAtOrBelow(8192));
+  EXPECT_EQ(3, histogram.getCountAtOrBelow(8319));
+  EXPECT_EQ(4, histogram.getCountAtOrBelow(8320));
+
+  EXPECT_EQ(8319, Histogram::getBucketUpperBound(8192));
+  EXPECT_EQ(8319, Histogram::getBucketUpperBound(8319));
+  EXPECT_EQ(8447, Histogram::getBucketUpperBound(8320));
+  EXPECT_EQ(100, Histogram::getBucketUpperBound(100));
+}
+
+/**
+ * Test: merging histograms combines their distributions
+ */
+TEST(Histogram, Merge) {
+  Histogram first;
+  Histogram second;
+  first.record(10);
+  second.record(20);
+  second.record(30);
+
+  first.merge(second);
+
+  EXPECT_EQ(3, first.getCount());
+  EXPECT_EQ(10, first.getMin());
+  EXPECT_EQ(30, first.getMax());
+  EXPECT_EQ(20, first.getPercentile(50));
+}
+
+}  // namespace
+}  // namespace metrics
@@ -0,0 +1,119 @@
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace metrics {
+
+/**
+ * Values below this limit are recorded exactly, one bucket per value.
+ */
+constexpr std::uint64_t SubBucketCount = std::uint64_t{1} << Histogram::SubBucketBits;
+
+/**
+ * Every power-of-two range above SubBucketCount is split into this many buckets.
+ */
+constexpr std::uint64_t HalfSubBucketCount = SubBucketCount / 2;
+
+/**
+ * Total number of buckets needed to cover all 64-bit values.
+ */
+constexpr std::size_t NumBuckets = SubBucketCount + (64 - Histogram::SubBucketBits) * HalfSubBucketCount;
+
+Histogram::Histogram()
+    : counts(NumBuckets, 0), count(0), sum(0), min(std::numeric_limits<std::uint64_t>::max()), max(0) {}
+
+auto Histogram::bucketIndex(std::uint64_t value) -> std::size_t {
+  if (value < SubBucketCount) {
+    return value;
+  }
+
+  // the value lies in [2^(SubBucketBits - 1 + shift), 2^(SubBucketBits + shift)),
+  // which is split into HalfSubBucketCount buckets of width 2^shift
+  const int shift = std::bit_width(value) - Histogram::SubBucketBits;
+  const std::uint64_t sub_bucket = (value >> shift) - HalfSubBucketCount;
+  return SubBucketCount + (shift - 1) * HalfSubBucketCount + sub_bucket;
+}
+
+auto Histogram::bucketUpperBound(std::size_t index) -> std::uint64_t {
+  if (index < SubBucketCount) {
+    return index;
+  }
+
+  const std::uint64_t shift = ((index - SubBucketCount) / HalfSubBucketCount) + 1;
+  const std::uint64_t sub_bucket = ((index - SubBucketCount) % HalfSubBucketCount) + HalfSubBucketCount;
+  const std::uint64_t lower_bound = sub_bucket << shift;
+  return lower_bound + ((std::uint64_t{1} << shift) - 1);
+}
+
+void Histogram::record(std::uint64_t value) {
+  this->counts[bucketIndex(value)]++;
+  this->count++;
+  this->sum += value;
+  this->min = std::min(this->min, value);
+  this->max = std::max(this->max, value);
+}
+
+void Histogram::merge(const Histogram &other) {
+  for (std::size_t i = 0; i < NumBuckets; i++) {
+    this->counts[i] += other.counts[i];
+  }
+  this->count += other.count;
+  this->sum += other.sum;
+  this->min = std::min(this->min, other.min);
+  this->max = std::max(this->max, other.max);
+}
+
+auto Histogram::getCount() const -> std::uint64_t {
+  return this->count;
+}
+
+auto Histogram::getSum() const -> std::uint64_t {
+  return this->sum;
+}
+
+auto Histogram::getMin() const -> std::uint64_t {
+  return this->count == 0 ? 0 : this->min;
+}
+
+auto Histogram::getMax() const -> std::uint64_t {
+  return this->max;
+}
+
+auto Histogram::getPercentile(double percentile) const -> std::uint64_t {
+  if (this->count == 0) {
+    return 0;
+  }
+
+  // the rank of the value at the given percentile, at least the first value
+  const double clamped = std::clamp(percentile, 0.0, 100.0);
+  const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(this->count))));
+
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < NumBuckets; i++) {
+    seen += this->counts[i];
+    if (seen >= rank) {
+      // never report beyond the exactly tracked extremes
+      return std::clamp(bucketUpperBound(i), this->getMin(), this->max);
+    }
+  }
+
+  return this->max;
+}
+
+auto Histogram::getCountAtOrBelow(std::uint64_t value) const -> std::uint64_t {
+  std::uint64_t seen = 0;
+  const std::size_t last = bucketIndex(value);
+  for (std::size_t i = 0; i <= last; i++) {
+    seen += this->counts[i];
+  }
+  return seen;
+}
+
+auto Histogram::getBucketUpperBound(std::uint64_t value) -> std::uint64_t {
+  return bucketUpperBound(bucketIndex(value));
+}
+
+}  // namespace metrics
@@ -0,0 +1,104 @@
+#ifndef LIBMETRICS_HISTOGRAM_HPP_
+#define LIBMETRICS_HISTOGRAM_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace metrics {
+/**
+ * A Histogram records a distribution of non-negative integer values, such as latencies
+ * in nanoseconds, with bounded relative error.
+ *
+ * The histogram uses the log-linear bucketing of HDR histograms
+ * (ref: http://hdrhistogram.org/): values below 2^SubBucketBits are recorded exactly,
+ * and every larger power-of-two range is split into 2^(SubBucketBits - 1) equally sized
+ * buckets. With SubBucketBits = 7, a bucket of [2^k, 2^(k+1)) is 2^k / 64 wide, so the
+ * highest value of a bucket exceeds any value in it by less than 1/64 (about 1.6%) over the
+ * full 64-bit range, at a fixed memory cost and O(1) per recorded value. For example, 8192
+ * falls in the bucket [8192, 8319].
+ *
+ * Percentiles are reported as the highest value equivalent to the bucket the percentile
+ * falls in, so they never under-report. The minimum and maximum are tracked exactly.
+ */
+class Histogram {
+ public:
+  /**
+   * Constructs a new empty histogram.
+   */
+  Histogram();
+
+  /**
+   * Records a single value.
+   */
+  void record(std::uint64_t value);
+
+  /**
+   * Adds all values recorded in the other histogram to this histogram.
+   */
+  void merge(const Histogram &other);
+
+  /**
+   * Returns the number of recorded values.
+   */
+  [[nodiscard]] auto getCount() const -> std::uint64_t;
+
+  /**
+   * Returns the sum of all recorded values.
+   */
+  [[nodiscard]] auto getSum() const -> std::uint64_t;
+
+  /**
+   * Returns the smallest recorded value, or 0 if no value was recorded.
+   */
+  [[nodiscard]] auto getMin() const -> std::uint64_t;
+
+  /**
+   * Returns the largest recorded value, or 0 if no value was recorded.
+   */
+  [[nodiscard]] auto getMax() const -> std::uint64_t;
+
+  /**
+   * Returns the value at the given percentile (0..100), or 0 if no value was recorded.
+   */
+  [[nodiscard]] auto getPercentile(double percentile) const -> std::uint64_t;
+
+  /**
+   * Returns the number of recorded values less than or equal to the given value.
+   *
+   * The count is exact when the value is the upper bound of a bucket, see \link getBucketUpperBound() ,
+   * and otherwise includes the values in the bucket containing value.
+   */
+  [[nodiscard]] auto getCountAtOrBelow(std::uint64_t value) const -> std::uint64_t;
+
+  /**
+   * Returns the highest value of the bucket containing the given value: the value itself below
+   * 2^SubBucketBits, and less than 1/64 above it otherwise.
+   */
+  static auto getBucketUpperBound(std::uint64_t value) -> std::uint64_t;
+
+  /**
+   * Number of bits used for exactly recorded values, see above.
+   */
+  static constexpr int SubBucketBits = 7;
+
+ private:
+  // Recorded counts per bucket
+  std::vector<std::uint64_t> counts;
+
+  // Summary statistics
+  std::uint64_t count, sum, min, max;
+
+  /**
+   * Helper method to find the bucket index for a value.
+   */
+  static auto bucketIndex(std::uint64_t value) -> std::size_t;
+
+  /**
+   * Helper method to find the highest value recorded in a bucket.
+   */
+  static auto bucketUpperBound(std::size_t index) -> std::uint64_t;
+};
+
+}  // namespace metrics
+
+#endif  // LIBMETRICS_HISTOGRAM_HPP_
@@ -0,0 +1,51 @@
+#include "perf-counters.hpp"
+
+#include "gtest/gtest.h"
+
+namespace metrics {
+namespace {
+
+/**
+ * Test: counters can be used whether or not perf events are available
+ */
+TEST(PerfCounters, StartStop) {
+  PerfCounters counters;
+
+  counters.start();
+  volatile std::uint64_t sum = 0;
+  for (int i = 0; i < 100000; i++) {
+    sum = sum + i;
+  }
+  PerfSample sample = counters.stop();
+
+  for (int i = 0; i < NumPerfEvents; i++) {
+    auto event = static_cast<PerfEvent>(i);
+    if (!counters.isAvailable(event)) {
+      // unavailable events are reported as zero
+      EXPECT_EQ(0, sample.get(event));
+    }
+  }
+
+  if (counters.isAvailable(PerfEvent::Instructions)) {
+    EXPECT_LT(100000, sample.get(PerfEvent::Instructions));
+  }
+}
+
+/**
+ * Test: samples accumulate
+ */
+TEST(PerfCounters, SampleSum) {
+  PerfSample first;
+  first.counts = {1, 2, 3, 4, 5};
+  PerfSample second;
+  second.counts = {10, 20, 30, 40, 50};
+
+  first += second;
+
+  EXPECT_EQ(11, first.get(PerfEvent::Cycles));
+  EXPECT_EQ(55, first.get(PerfEvent::BranchMisses));
+  EXPECT_STREQ("llc-misses", perfEventName(PerfEvent::LastLevelCacheMisses));
+}
+
+}  // namespace
+}  // namespace metrics
@@ -0,0 +1,149 @@
+#include "perf-counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace metrics {
+
+auto perfEventName(PerfEvent event) -> const char * {
+  switch (event) {
+    case PerfEvent::Cycles:
+      return "cycles";
+    case PerfEvent::Instructions:
+      return "instructions";
+    case PerfEvent::L1DataMisses:
+      return "l1d-misses";
+    case PerfEvent::LastLevelCacheMisses:
+      return "llc-misses";
+    case PerfEvent::BranchMisses:
+      return "branch-misses";
+  }
+  return "unknown";
+}
+
+auto PerfSample::get(PerfEvent event) const -> std::uint64_t {
+  return this->counts[static_cast<int>(event)];
+}
+
+auto PerfSample::operator+=(const PerfSample &other) -> PerfSample & {
+  for (int i = 0; i < NumPerfEvents; i++) {
+    this->counts[i] += other.counts[i];
+  }
+  return *this;
+}
+
+#ifdef __linux__
+
+/**
+ * Helper method to open a counter for the calling thread on any CPU.
+ *
+ * \return the counter file descriptor, or -1 if the counter is unavailable
+ */
+auto openCounter(std::uint32_t type, std::uint64_t config) -> int {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+/**
+ * Helper method to build the config value for a hardware cache event.
+ */
+constexpr auto cacheEvent(std::uint64_t cache, std::uint64_t operation, std::uint64_t result) -> std::uint64_t {
+  const int OperationShift = 8;
+  const int ResultShift = 16;
+  return cache | (operation << OperationShift) | (result << ResultShift);
+}
+
+PerfCounters::PerfCounters()
+    : descriptors{
+          openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+          openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+          openCounter(PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)),
+          openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+          openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES),
+      } {}
+
+PerfCounters::~PerfCounters() {
+  for (int descriptor : this->descriptors) {
+    if (descriptor >= 0) {
+      close(descriptor);
+    }
+  }
+}
+
+void PerfCounters::start() {
+  for (int descriptor : this->descriptors) {
+    if (descriptor >= 0) {
+      ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+auto PerfCounters::stop() -> PerfSample {
+  PerfSample sample;
+
+  for (int i = 0; i < NumPerfEvents; i++) {
+    if (this->descriptors[i] < 0) {
+      continue;
+    }
+
+    ioctl(this->descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+
+    // read format: value, time enabled, time running
+    std::array<std::uint64_t, 3> values{};
+    if (read(this->descriptors[i], values.data(), sizeof(values)) != sizeof(values)) {
+      continue;
+    }
+
+    // scale for the time the counter was multiplexed out
+    auto [value, enabled, running] = values;
+    if (running > 0 && running < enabled) {
+      value = static_cast<std::uint64_t>(static_cast<double>(value) * static_cast<double>(enabled) / static_cast<double>(running));
+    }
+    sample.counts[i] = value;
+  }
+
+  return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters()
+    : descriptors{-1, -1, -1, -1, -1} {}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+auto PerfCounters::stop() -> PerfSample {
+  return {};
+}
+
+#endif
+
+auto PerfCounters::isAvailable() const -> bool {
+  for (int descriptor : this->descriptors) {
+    if (descriptor >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto PerfCounters::isAvailable(PerfEvent event) const -> bool {
+  return this->descriptors[static_cast<int>(event)] >= 0;
+}
+
+}  // namespace metrics
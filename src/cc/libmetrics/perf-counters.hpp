@@ -0,0 +1,116 @@
+#ifndef LIBMETRICS_PERF_COUNTERS_HPP_
+#define LIBMETRICS_PERF_COUNTERS_HPP_
+
+#include <array>
+#include <cstdint>
+
+namespace metrics {
+/**
+ * The hardware events counted by \link PerfCounters .
+ */
+enum class PerfEvent : std::uint8_t {
+  // CPU cycles
+  Cycles,
+
+  // Retired instructions
+  Instructions,
+
+  // Level 1 data cache read misses
+  L1DataMisses,
+
+  // Last level cache misses
+  LastLevelCacheMisses,
+
+  // Mispredicted branches
+  BranchMisses
+};
+
+/**
+ * Number of hardware events in \link PerfEvent .
+ */
+constexpr int NumPerfEvents = 5;
+
+/**
+ * Returns a short, human-readable name for the given hardware event.
+ */
+auto perfEventName(PerfEvent event) -> const char *;
+
+/**
+ * A sample of hardware event counts, indexed by \link PerfEvent .
+ */
+struct PerfSample {
+  // Event counts, indexed by PerfEvent
+  std::array<std::uint64_t, NumPerfEvents> counts{};
+
+  /**
+   * Returns the count for the given hardware event.
+   */
+  [[nodiscard]] auto get(PerfEvent event) const -> std::uint64_t;
+
+  /**
+   * Adds the counts of the other sample to this sample.
+   */
+  auto operator+=(const PerfSample &other) -> PerfSample &;
+};
+
+/**
+ * PerfCounters reads hardware performance counters of the calling thread.
+ *
+ * The counters are based on the Linux perf_event_open interface.
+ * Each event is opened separately, so that events which are not supported by the
+ * hardware (e.g., inside a virtual machine) or not permitted (see
+ * /proc/sys/kernel/perf_event_paranoid) do not prevent reading the other events.
+ * If an event is unavailable, its count is always zero and \link isAvailable()
+ * reports so. On platforms other than Linux, no event is available.
+ *
+ * Usage: call start() before and stop() after the code section to measure.
+ * Kernel and hypervisor activity is excluded from the counts.
+ */
+class PerfCounters {
+ public:
+  /**
+   * Opens the hardware counters for the calling thread.
+   */
+  PerfCounters();
+
+  /**
+   * Closes the hardware counters.
+   */
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  auto operator=(const PerfCounters &) -> PerfCounters & = delete;
+  PerfCounters(PerfCounters &&) = delete;
+  auto operator=(PerfCounters &&) -> PerfCounters & = delete;
+
+  /**
+   * Returns if at least one hardware event is available.
+   */
+  [[nodiscard]] auto isAvailable() const -> bool;
+
+  /**
+   * Returns if the given hardware event is available.
+   */
+  [[nodiscard]] auto isAvailable(PerfEvent event) const -> bool;
+
+  /**
+   * Resets and starts all available counters.
+   */
+  void start();
+
+  /**
+   * Stops all available counters and returns the counts since the last start().
+   *
+   * If the kernel had to multiplex counters, the counts are scaled to the full
+   * time the counters were enabled.
+   */
+  auto stop() -> PerfSample;
+
+ private:
+  // File descriptor per event, or -1 if the event is unavailable.
+  std::array<int, NumPerfEvents> descriptors;
+};
+
+}  // namespace metrics
+
+#endif  // LIBMETRICS_PERF_COUNTERS_HPP_
@@ -0,0 +1,57 @@
+#include "prometheus.hpp"
+
+#include <array>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace metrics {
+namespace {
+
+/**
+ * Test: counters are written with their HELP and TYPE lines, and escaped labels
+ */
+TEST(Prometheus, Counter) {
+  std::ostringstream output;
+  PrometheusWriter writer(output);
+
+  writer.family("sudoku_puzzles_total", MetricType::Counter, "Puzzles processed.");
+  writer.sample("sudoku_puzzles_total", {{"size", "9x9"}, {"outcome", "solved"}}, 3);
+  writer.sample("sudoku_puzzles_total", {{"path", "a\"b\\c\n"}}, 0.5);
+  writer.sample("sudoku_up", {}, 1);
+
+  EXPECT_EQ(R"(# HELP sudoku_puzzles_total Puzzles processed.
+# TYPE sudoku_puzzles_total counter
+sudoku_puzzles_total{size="9x9",outcome="solved"} 3
+sudoku_puzzles_total{path="a\"b\\c\n"} 0.5
+sudoku_up 1
+)",
+            output.str());
+}
+
+/**
+ * Test: histograms are written as cumulative buckets, scaled to the exposed unit
+ */
+TEST(Prometheus, Histogram) {
+  Histogram histogram;
+  for (std::uint64_t value : {1000, 2000, 2000, 50000}) {
+    histogram.record(value);
+  }
+
+  std::ostringstream output;
+  PrometheusWriter writer(output);
+  const std::array<std::uint64_t, 3> bounds = {1000, 10000, 100000};
+  writer.histogram("latency_seconds", {{"size", "4x4"}}, histogram, bounds, 1e6);
+
+  EXPECT_EQ(R"(latency_seconds_bucket{size="4x4",le="0.001"} 1
+latency_seconds_bucket{size="4x4",le="0.01"} 3
+latency_seconds_bucket{size="4x4",le="0.1"} 4
+latency_seconds_bucket{size="4x4",le="+Inf"} 4
+latency_seconds_sum{size="4x4"} 0.055
+latency_seconds_count{size="4x4"} 4
+)",
+            output.str());
+}
+
+}  // namespace
+}  // namespace metrics
@@ -0,0 +1,111 @@
+#include "prometheus.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+
+namespace metrics {
+
+/**
+ * Buffer size for formatting a double, enough for the shortest round-trip representation
+ */
+constexpr std::size_t NumberBufferSize = 32;
+
+PrometheusWriter::PrometheusWriter(std::ostream &output) : output(output) {}
+
+void PrometheusWriter::family(std::string_view name, MetricType type, std::string_view help) {
+  const char *type_name = "untyped";
+  switch (type) {
+    case MetricType::Counter:
+      type_name = "counter";
+      break;
+    case MetricType::Gauge:
+      type_name = "gauge";
+      break;
+    case MetricType::Histogram:
+      type_name = "histogram";
+      break;
+  }
+
+  this->output << "# HELP " << name << ' ' << help << '\n';
+  this->output << "# TYPE " << name << ' ' << type_name << '\n';
+}
+
+void PrometheusWriter::sample(std::string_view name, std::initializer_list<Label> labels, double value) {
+  this->writeSample(name, "", labels, nullptr, value);
+}
+
+void PrometheusWriter::histogram(std::string_view name, std::initializer_list<Label> labels,
+                                 const Histogram &histogram, std::span<const std::uint64_t> bounds, double unit) {
+  std::array<char, NumberBufferSize> buffer{};
+
+  for (std::uint64_t bound : bounds) {
+    auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), static_cast<double>(bound) / unit);
+    const Label bucket{"le", std::string_view(buffer.data(), end - buffer.data())};
+    this->writeSample(name, "_bucket", labels, &bucket, static_cast<double>(histogram.getCountAtOrBelow(bound)));
+  }
+
+  const Label infinity{"le", "+Inf"};
+  this->writeSample(name, "_bucket", labels, &infinity, static_cast<double>(histogram.getCount()));
+  this->writeSample(name, "_sum", labels, nullptr, static_cast<double>(histogram.getSum()) / unit);
+  this->writeSample(name, "_count", labels, nullptr, static_cast<double>(histogram.getCount()));
+}
+
+void PrometheusWriter::writeSample(std::string_view name, std::string_view suffix, std::initializer_list<Label> labels,
+                                   const Label *extra, double value) {
+  this->output << name << suffix;
+
+  if (labels.size() != 0 || extra != nullptr) {
+    char separator = '{';
+    auto write_label = [this, &separator](const Label &label) {
+      this->output << separator << label.name << "=\"";
+      // label values escape backslash, double-quote and line feed
+      for (char token : label.value) {
+        switch (token) {
+          case '\\':
+            this->output << "\\\\";
+            break;
+          case '"':
+            this->output << "\\\"";
+            break;
+          case '\n':
+            this->output << "\\n";
+            break;
+          default:
+            this->output << token;
+        }
+      }
+      this->output << '"';
+      separator = ',';
+    };
+
+    for (const Label &label : labels) {
+      write_label(label);
+    }
+    if (extra != nullptr) {
+      write_label(*extra);
+    }
+    this->output << '}';
+  }
+
+  this->output << ' ';
+  this->writeNumber(value);
+  this->output << '\n';
+}
+
+void PrometheusWriter::writeNumber(double value) {
+  if (std::isinf(value)) {
+    this->output << (value > 0 ? "+Inf" : "-Inf");
+    return;
+  }
+  if (std::isnan(value)) {
+    this->output << "NaN";
+    return;
+  }
+
+  std::array<char, NumberBufferSize> buffer{};
+  auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+  this->output << std::string_view(buffer.data(), end - buffer.data());
+}
+
+}  // namespace metrics
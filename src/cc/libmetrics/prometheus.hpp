@@ -0,0 +1,94 @@
+#ifndef LIBMETRICS_PROMETHEUS_HPP_
+#define LIBMETRICS_PROMETHEUS_HPP_
+
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <span>
+#include <string_view>
+
+#include "histogram.hpp"
+
+namespace metrics {
+/**
+ * A label of a Prometheus sample, such as size="9x9".
+ */
+struct Label {
+  std::string_view name;
+  std::string_view value;
+};
+
+/**
+ * The types of Prometheus metric families written by \link PrometheusWriter .
+ */
+enum class MetricType : std::uint8_t {
+  // A monotonically increasing value, reset only when the process restarts
+  Counter,
+
+  // A value that can go up and down
+  Gauge,
+
+  // Cumulative bucket counts together with the sum and count of observed values
+  Histogram
+};
+
+/**
+ * A PrometheusWriter writes metrics in the Prometheus text exposition format
+ * (ref: https://prometheus.io/docs/instrumenting/exposition_formats/).
+ *
+ * Every metric family starts with \link family() , followed by its samples.
+ * The writer only formats; collecting the values is left to the caller, so that
+ * recording stays as cheap as incrementing a counter or a \link Histogram .
+ */
+class PrometheusWriter {
+ public:
+  /**
+   * Constructs a new writer to the given stream, which must outlive this writer.
+   */
+  explicit PrometheusWriter(std::ostream &output);
+
+  /**
+   * Writes the HELP and TYPE lines introducing a metric family.
+   */
+  void family(std::string_view name, MetricType type, std::string_view help);
+
+  /**
+   * Writes a single sample of a counter or gauge.
+   */
+  void sample(std::string_view name, std::initializer_list<Label> labels, double value);
+
+  /**
+   * Writes the samples of a histogram: a cumulative _bucket sample for each upper bound and +Inf,
+   * followed by the _sum and _count samples.
+   *
+   * Bucket counts are derived from the log-linear buckets of the given \link Histogram ,
+   * see \link Histogram::getCountAtOrBelow() . They are exact for bounds that are the highest value
+   * of a bucket, see \link Histogram::getBucketUpperBound() ; any other bound counts the whole
+   * bucket containing it, i.e. values up to 1/64 (about 1.6%) above the bound.
+   *
+   * \param bounds The upper bounds of the buckets, in the unit of the recorded values, ascending.
+   * \param unit The number of recorded units per exposed unit, e.g. 1e9 for
+   *             nanoseconds exposed as seconds.
+   */
+  void histogram(std::string_view name, std::initializer_list<Label> labels, const Histogram &histogram,
+                 std::span<const std::uint64_t> bounds, double unit = 1.0);
+
+ private:
+  // The stream to write to
+  std::ostream &output;
+
+  /**
+   * Helper method to write a sample line, with an optional extra label such as le="+Inf".
+   */
+  void writeSample(std::string_view name, std::string_view suffix, std::initializer_list<Label> labels,
+                   const Label *extra, double value);
+
+  /**
+   * Helper method to write a number in the shortest form that reads back exactly.
+   */
+  void writeNumber(double value);
+};
+
+}  // namespace metrics
+
+#endif  // LIBMETRICS_PROMETHEUS_HPP_
@@ -0,0 +1,44 @@
+#include "difficulty.hpp"
+
+#include "gtest/gtest.h"
+#include "test-puzzles.hpp"
+
+namespace sudoku {
+namespace {
+
+/**
+ * Test: the residual problem of the example Sudoku is measured, and it costs less than the empty grid
+ */
+TEST(SudokuDifficulty, Estimate) {
+  auto puzzle = createPuzzle(SudokuSize::Four, {"4__1", "_13_", "_41_", "1__3"});
+  auto difficulty = estimateDifficulty(puzzle);
+  ASSERT_TRUE(difficulty.has_value());
+
+  // every given covers one cell, row, column and box constraint of the 4 * 16 constraints
+  EXPECT_EQ(8, difficulty.value().givens);
+  EXPECT_EQ(32, difficulty.value().columns);
+  EXPECT_LT(0, difficulty.value().rows);
+  EXPECT_LT(0, difficulty.value().tree_size);
+
+  auto empty = estimateDifficulty(Puzzle(SudokuSize::Four));
+  ASSERT_TRUE(empty.has_value());
+  EXPECT_EQ(0, empty.value().givens);
+  EXPECT_EQ(64, empty.value().columns);
+  EXPECT_EQ(64, empty.value().rows);
+  EXPECT_LT(difficulty.value().cost(), empty.value().cost());
+
+  // the same seed yields the same estimate
+  EXPECT_EQ(empty.value().tree_size, estimateDifficulty(Puzzle(SudokuSize::Four)).value().tree_size);
+}
+
+/**
+ * Test: conflicting givens are reported instead of an estimate
+ */
+TEST(SudokuDifficulty, Conflict) {
+  auto conflict = estimateDifficulty(createPuzzle(SudokuSize::Four, {"44__", "____", "____", "____"}));
+  ASSERT_FALSE(conflict.has_value());
+  EXPECT_EQ(InputError::Conflict, conflict.error());
+}
+
+}  // namespace
+}  // namespace sudoku
@@ -0,0 +1,27 @@
+#include "difficulty.hpp"
+
+#include <memory>
+#include <memory_resource>
+
+#include "solver.hpp"
+
+namespace sudoku {
+
+auto estimateDifficulty(const Puzzle &puzzle, int probes, std::uint64_t seed) -> Expected<Difficulty, InputError> {
+  std::pmr::monotonic_buffer_resource arena;
+  auto problem = SudokuMatrix::describe(puzzle, &arena);
+  if (!problem.has_value()) {
+    return Unexpected(problem.error());
+  }
+
+  Difficulty difficulty;
+  difficulty.givens = static_cast<int>(problem.value().givens.size());
+  difficulty.columns = problem.value().problem.getNumColumns();
+  difficulty.rows = problem.value().problem.getNumRows();
+
+  Solver solver(std::make_unique<SudokuMatrix>(problem.value(), &arena));
+  difficulty.tree_size = solver.estimateTreeSize(probes, seed).value_or(0);
+  return difficulty;
+}
+
+}  // namespace sudoku
@@ -0,0 +1,58 @@
+#ifndef LIBSUDOKU_DIFFICULTY_HPP_
+#define LIBSUDOKU_DIFFICULTY_HPP_
+
+#include <cstdint>
+
+#include "expected.hpp"
+#include "puzzle.hpp"
+#include "sudoku-matrix.hpp"
+
+namespace sudoku {
+/**
+ * Maximum number of random probes of the search tree per estimate, if not specified
+ */
+constexpr int DefaultProbes = 64;
+
+/**
+ * A cheap estimate of the cost of solving a Sudoku, taken before solving it,
+ * see \link estimateDifficulty() .
+ */
+struct Difficulty {
+  // The number of givens
+  int givens = 0;
+
+  // The number of columns and rows of the residual matrix, left after applying the givens
+  int columns = 0;
+  int rows = 0;
+
+  // The estimated number of search nodes to enumerate all solutions, see dlx::Solver::estimateTreeSize()
+  double tree_size = 0;
+
+  /**
+   * Returns the estimated cost of solving the Sudoku, in search nodes: those of the search tree,
+   * plus one per residual row for building the matrix, so that trivial puzzles still compare by size.
+   */
+  [[nodiscard]] auto cost() const -> double {
+    return this->tree_size + this->rows;
+  }
+};
+
+/**
+ * Estimates the cost of solving a Sudoku without solving it.
+ *
+ * The givens are applied to get the residual exact cover problem, see \link SudokuMatrix::describe() ,
+ * and its search tree is probed along a few random paths, see dlx::Solver::estimateTreeSize() .
+ * This costs about as much as building the matrix plus one search path per probe, a small fraction of
+ * solving a hard puzzle. The estimate is meant to rank puzzles, e.g. to schedule the most expensive
+ * ones first: it estimates the whole tree, while a search for the first solution may stop early.
+ *
+ * \param probes The maximum number of random paths to probe.
+ * \param seed The seed of the random paths, so that an estimate can be repeated.
+ * \return the estimate, or an error if the givens of the puzzle are out of range or conflict.
+ */
+auto estimateDifficulty(const Puzzle &puzzle, int probes = DefaultProbes, std::uint64_t seed = 0)
+    -> Expected<Difficulty, InputError>;
+
+}  // namespace sudoku
+
+#endif  // LIBSUDOKU_DIFFICULTY_HPP_
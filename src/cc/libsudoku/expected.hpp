@@ -0,0 +1,129 @@
+#ifndef LIBSUDOKU_EXPECTED_HPP_
+#define LIBSUDOKU_EXPECTED_HPP_
+
+#include <utility>
+#include <variant>
+
+namespace sudoku {
+/**
+ * Wraps an error value, to construct an \link Expected holding an error.
+ *
+ * This is a minimal counterpart of C++23 std::unexpected.
+ */
+template <typename E>
+class Unexpected {
+ public:
+  explicit Unexpected(E error)
+      : value(std::move(error)) {}
+
+  /**
+   * Get the wrapped error.
+   */
+  [[nodiscard]] auto error() const -> const E & {
+    return this->value;
+  }
+
+ private:
+  E value;
+};
+
+/**
+ * Holds either a value of type T, or an error of type E describing why there is no value.
+ *
+ * This is a minimal counterpart of C++23 std::expected, so that failures such as malformed
+ * input are reported as plain return values instead of exceptions. Checking the result is
+ * a branch, so failing is as cheap as succeeding; there is no unwinding involved.
+ *
+ *   auto result = parse(...);
+ *   if (!result) {
+ *     report(result.error());
+ *   }
+ *   use(*result);
+ */
+template <typename T, typename E>
+class Expected {
+ public:
+  Expected(T value)  // NOLINT(google-explicit-constructor)
+      : storage(std::in_place_index<0>, std::move(value)) {}
+
+  Expected(Unexpected<E> error)  // NOLINT(google-explicit-constructor)
+      : storage(std::in_place_index<1>, error.error()) {}
+
+  /**
+   * Returns if this holds a value, rather than an error.
+   */
+  [[nodiscard]] auto has_value() const -> bool {
+    return this->storage.index() == 0;
+  }
+
+  explicit operator bool() const {
+    return this->has_value();
+  }
+
+  /**
+   * Get the value. Only valid if \link has_value() .
+   */
+  auto value() -> T & {
+    return std::get<0>(this->storage);
+  }
+
+  [[nodiscard]] auto value() const -> const T & {
+    return std::get<0>(this->storage);
+  }
+
+  auto operator*() -> T & {
+    return *std::get_if<0>(&this->storage);
+  }
+
+  auto operator->() -> T * {
+    return std::get_if<0>(&this->storage);
+  }
+
+  /**
+   * Get the error. Only valid if not \link has_value() .
+   */
+  [[nodiscard]] auto error() const -> const E & {
+    return *std::get_if<1>(&this->storage);
+  }
+
+ private:
+  std::variant<T, E> storage;
+};
+
+/**
+ * Holds either nothing (success), or an error of type E describing the failure.
+ */
+template <typename E>
+class Expected<void, E> {
+ public:
+  Expected() = default;
+
+  Expected(Unexpected<E> error)  // NOLINT(google-explicit-constructor)
+      : failed(true), failure(error.error()) {}
+
+  /**
+   * Returns if this represents success, rather than an error.
+   */
+  [[nodiscard]] auto has_value() const -> bool {
+    return !this->failed;
+  }
+
+  explicit operator bool() const {
+    return this->has_value();
+  }
+
+  /**
+   * Get the error. Only valid if not \link has_value() .
+   */
+  [[nodiscard]] auto error() const -> const E & {
+    return this->failure;
+  }
+
+ private:
+  bool failed = false;
+  E failure{};
+};
+
+}  // namespace sudoku
+
+#endif  // LIBSUDOKU_EXPECTED_HPP_
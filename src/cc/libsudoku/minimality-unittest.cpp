@@ -0,0 +1,72 @@
+#include "minimality.hpp"
+
+#include "gtest/gtest.h"
+#include "test-puzzles.hpp"
+
+namespace sudoku {
+namespace {
+
+/**
+ * Test: every given of the example Sudoku can be left out on its own, on any number of threads
+ */
+TEST(SudokuMinimality, Redundant) {
+  auto puzzle = createPuzzle(SudokuSize::Four, {"4__1", "_13_", "_41_", "1__3"});
+
+  for (unsigned threads : {1U, 3U, 0U}) {
+    auto minimality = checkMinimality(puzzle, threads);
+    ASSERT_TRUE(minimality.has_value());
+    EXPECT_TRUE(minimality.value().isUnique());
+    EXPECT_FALSE(minimality.value().isMinimal());
+
+    // all givens, in row-by-row order
+    const auto &redundant = minimality.value().redundant;
+    ASSERT_EQ(8, redundant.size()) << threads << " threads";
+    EXPECT_EQ(1, redundant.front().row);
+    EXPECT_EQ(1, redundant.front().column);
+    EXPECT_EQ(4, redundant.front().number);
+    EXPECT_EQ(4, redundant.back().row);
+    EXPECT_EQ(4, redundant.back().column);
+    EXPECT_EQ(3, redundant.back().number);
+  }
+}
+
+/**
+ * Test: no given of a minimal Sudoku can be left out
+ */
+TEST(SudokuMinimality, Minimal) {
+  auto minimality = checkMinimality(createPuzzle(SudokuSize::Four, {"4_2_", "2___", "____", "___3"}), 2);
+  ASSERT_TRUE(minimality.has_value());
+  EXPECT_TRUE(minimality.value().isMinimal());
+
+  // a Sudoku with 17 givens, the fewest for a unique 9x9 solution, is minimal
+  auto seventeen = checkMinimality(createPuzzle(SudokuSize::Nine, {"_______1_", "4________", "_2_______",
+                                                                   "____5_4_7", "__8___3__", "__1_9____",
+                                                                   "3__4__2__", "_5_1_____", "___8_6___"}),
+                                   4);
+  ASSERT_TRUE(seventeen.has_value());
+  EXPECT_TRUE(seventeen.value().isMinimal());
+}
+
+/**
+ * Test: the givens of a Sudoku without a unique solution are not checked
+ */
+TEST(SudokuMinimality, NotUnique) {
+  auto empty = checkMinimality(Puzzle(SudokuSize::Four));
+  ASSERT_TRUE(empty.has_value());
+  EXPECT_EQ(2, empty.value().solutions);
+  EXPECT_FALSE(empty.value().isUnique());
+  EXPECT_TRUE(empty.value().redundant.empty());
+
+  // no number fits the last cell of the first row
+  auto unsolvable = checkMinimality(createPuzzle(SudokuSize::Four, {"123_", "___4", "____", "____"}));
+  ASSERT_TRUE(unsolvable.has_value());
+  EXPECT_EQ(0, unsolvable.value().solutions);
+  EXPECT_FALSE(unsolvable.value().isMinimal());
+
+  auto conflict = checkMinimality(createPuzzle(SudokuSize::Four, {"11__", "____", "____", "____"}));
+  ASSERT_FALSE(conflict.has_value());
+  EXPECT_EQ(InputError::Conflict, conflict.error());
+}
+
+}  // namespace
+}  // namespace sudoku
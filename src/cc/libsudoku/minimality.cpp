@@ -0,0 +1,108 @@
+#include "minimality.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <thread>
+
+#include "solver.hpp"
+
+namespace sudoku {
+namespace {
+/**
+ * Number of solutions that tells a unique solution apart from several
+ */
+constexpr int UniquenessLimit = 2;
+
+/**
+ * Count the solutions of a replica of the base solver with the given givens set, up to UniquenessLimit.
+ * The given with index skip is left out, if any.
+ *
+ * \return the count, or an error if the givens conflict.
+ */
+auto countWithout(const Solver &base, std::span<const Placement> givens, std::size_t skip,
+                  std::pmr::memory_resource *resource) -> Expected<int, InputError> {
+  auto replica = base.clone(resource);
+  for (std::size_t index = 0; index < givens.size(); index++) {
+    if (index == skip) {
+      continue;
+    }
+
+    const auto &given = givens[index];
+    auto input = replica->setInput(given.row, given.column, given.number);
+    if (!input.has_value()) {
+      return Unexpected(input.error());
+    }
+  }
+
+  int solutions = 0;
+  while (solutions < UniquenessLimit && replica->next()) {
+    solutions++;
+  }
+  return solutions;
+}
+}  // namespace
+
+auto checkMinimality(const Puzzle &puzzle, unsigned threads) -> Expected<Minimality, InputError> {
+  const int digits = static_cast<int>(puzzle.getSudokuSize());
+  const auto cells = puzzle.getCells();
+
+  std::vector<Placement> givens;
+  for (int cell = 0; cell < digits * digits; cell++) {
+    if (cells[cell] != Puzzle::EmptyCell) {
+      givens.push_back(Placement{(cell / digits) + 1, (cell % digits) + 1, cells[cell]});
+    }
+  }
+
+  // the matrix of the empty grid is built once, and each check searches a replica of it
+  const Solver base(std::make_unique<SudokuMatrix>(puzzle.getSudokuSize()));
+
+  Minimality minimality;
+  {
+    std::pmr::monotonic_buffer_resource arena;
+    auto solutions = countWithout(base, givens, givens.size(), &arena);
+    if (!solutions.has_value()) {
+      return Unexpected(solutions.error());
+    }
+    minimality.solutions = solutions.value();
+  }
+
+  if (!minimality.isUnique()) {
+    return minimality;
+  }
+
+  // the givens are independent checks, claimed one at a time by the threads
+  std::vector<char> redundant(givens.size(), 0);
+  std::atomic<std::size_t> next_given(0);
+  auto check = [&]() {
+    std::pmr::monotonic_buffer_resource arena;
+    for (auto index = next_given.fetch_add(1); index < givens.size(); index = next_given.fetch_add(1)) {
+      // the givens were consistent with all of them set, so they are without one of them
+      redundant[index] = countWithout(base, givens, index, &arena).value() == 1 ? 1 : 0;
+      arena.release();
+    }
+  };
+
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  threads = std::min(threads, static_cast<unsigned>(givens.size()));
+
+  std::vector<std::jthread> workers;
+  for (unsigned thread = 1; thread < threads; thread++) {
+    workers.emplace_back(check);
+  }
+  check();
+  workers.clear();
+
+  for (std::size_t index = 0; index < givens.size(); index++) {
+    if (redundant[index] != 0) {
+      minimality.redundant.push_back(givens[index]);
+    }
+  }
+  return minimality;
+}
+
+}  // namespace sudoku
@@ -0,0 +1,54 @@
+#ifndef LIBSUDOKU_MINIMALITY_HPP_
+#define LIBSUDOKU_MINIMALITY_HPP_
+
+#include <vector>
+
+#include "expected.hpp"
+#include "placement.hpp"
+#include "puzzle.hpp"
+#include "sudoku-matrix.hpp"
+
+namespace sudoku {
+/**
+ * The result of checking which givens of a Sudoku are necessary, see \link checkMinimality() .
+ */
+struct Minimality {
+  // The number of solutions of the Sudoku, counted up to 2
+  int solutions = 0;
+
+  // The givens that can be removed while keeping the solution unique, in row-by-row order.
+  // Only checked if the Sudoku has a unique solution.
+  std::vector<Placement> redundant;
+
+  /**
+   * Returns if the Sudoku has exactly one solution.
+   */
+  [[nodiscard]] auto isUnique() const -> bool {
+    return this->solutions == 1;
+  }
+
+  /**
+   * Returns if the Sudoku has a unique solution, and removing any given makes it non-unique.
+   */
+  [[nodiscard]] auto isMinimal() const -> bool {
+    return this->isUnique() && this->redundant.empty();
+  }
+};
+
+/**
+ * Checks for every given of a Sudoku with a unique solution whether it is redundant, i.e.,
+ * whether the solution stays unique without it.
+ *
+ * The matrix of the empty grid is built once. Each check searches a replica of it, see
+ * \link Solver::clone() , with all other givens set, and counts at most 2 solutions: as the
+ * solution of the Sudoku remains a solution, the given is redundant if no second one exists.
+ * The checks are spread across threads, each allocating its replicas from its own arena.
+ *
+ * \param threads The number of threads, or 0 for the number of hardware threads.
+ * \return the result, or an error if the givens of the puzzle are out of range or conflict.
+ */
+auto checkMinimality(const Puzzle &puzzle, unsigned threads = 0) -> Expected<Minimality, InputError>;
+
+}  // namespace sudoku
+
+#endif  // LIBSUDOKU_MINIMALITY_HPP_
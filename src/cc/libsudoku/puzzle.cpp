@@ -0,0 +1,25 @@
+#include "puzzle.hpp"
+
+namespace sudoku {
+Puzzle::Puzzle(SudokuSize digit_range)
+    : digit_range(digit_range),
+      grid(static_cast<std::size_t>(digit_range) * static_cast<std::size_t>(digit_range), EmptyCell) {}
+
+auto Puzzle::getSudokuSize() const -> SudokuSize {
+  return this->digit_range;
+}
+
+auto Puzzle::getCellValue(int row, int column) const -> int {
+  int index = (row - 1) * static_cast<int>(this->digit_range) + column - 1;
+  return this->grid[index];
+}
+
+void Puzzle::setCellValue(int row, int column, int number) {
+  int index = (row - 1) * static_cast<int>(this->digit_range) + column - 1;
+  this->grid[index] = number;
+}
+
+auto Puzzle::getCells() const -> std::span<const int> {
+  return this->grid;
+}
+}  // namespace sudoku
@@ -0,0 +1,65 @@
+#ifndef LIBSUDOKU_PUZZLE_HPP_
+#define LIBSUDOKU_PUZZLE_HPP_
+
+#include <span>
+#include <vector>
+
+#include "sudoku-math.hpp"
+
+namespace sudoku {
+/**
+ * A partially filled Sudoku grid, as given as input to the Sudoku Solver.
+ *
+ * This puzzle defines a grid of size digit_range x digit_range where each cell
+ * is either empty or filled in with a given number in the range 1..digit_range.
+ */
+class Puzzle {
+ public:
+  /**
+   * Constructs a new puzzle of the given size with all cells empty.
+   */
+  explicit Puzzle(SudokuSize digit_range);
+
+  /**
+   * Get the size of the puzzle grid.
+   */
+  [[nodiscard]] auto getSudokuSize() const -> SudokuSize;
+
+  /**
+   * Get the number at the given sudoku grid cell, or EmptyCell if the cell is empty.
+   *
+   * \param row A row (1..digit_range) in the sudoku grid
+   * \param column A column (1..digit_range) in the sudoku grid
+   */
+  [[nodiscard]] auto getCellValue(int row, int column) const -> int;
+
+  /**
+   * Set the number at the given sudoku grid cell, or EmptyCell to clear the cell.
+   *
+   * \param row A row (1..digit_range) in the sudoku grid
+   * \param column A column (1..digit_range) in the sudoku grid
+   * \param number A number (1..digit_range) or EmptyCell
+   */
+  void setCellValue(int row, int column, int number);
+
+  /**
+   * Get all cells of the puzzle grid, row by row, with EmptyCell for empty cells.
+   */
+  [[nodiscard]] auto getCells() const -> std::span<const int>;
+
+  /**
+   * The value of an empty cell.
+   */
+  static constexpr int EmptyCell = 0;
+
+ private:
+  // The size of the puzzle grid
+  SudokuSize digit_range;
+
+  // The puzzle grid itself as a one-dimensional row-by-row vector.
+  std::vector<int> grid;
+};
+
+}  // namespace sudoku
+
+#endif  // LIBSUDOKU_PUZZLE_HPP_
@@ -1,23 +1,43 @@
-
 #include "solution.hpp"
 
 namespace sudoku {
-Solution::Solution(SudokuSize digit_range, const std::vector<Placement> &raw_solution)
-    : digit_range(digit_range) {
-  grid.reserve(static_cast<int64_t>(digit_range) * static_cast<int64_t>(digit_range));
-
-  for (auto placement : raw_solution) {
-    int index = (placement.row - 1) * static_cast<int>(digit_range) + placement.column - 1;
-    grid[index] = placement.number;
-  }
-}
+Solution::Solution(SudokuSize digit_range, std::pmr::memory_resource *resource)
+    : digit_range(digit_range),
+      grid(static_cast<std::size_t>(digit_range) * static_cast<std::size_t>(digit_range), 0, resource) {}
 
 auto Solution::getSudokuSize() const -> SudokuSize {
   return this->digit_range;
 }
 
-auto Solution::getCellValue(int row, int column) -> int {
+auto Solution::getCellValue(int row, int column) const -> int {
   int index = (row - 1) * static_cast<int>(this->digit_range) + column - 1;
   return grid[index];
 }
-}  // namespace sudoku
\ No newline at end of file
+
+auto Solution::getDigits() -> std::span<std::uint8_t> {
+  return this->grid;
+}
+
+auto Solution::getDigits() const -> std::span<const std::uint8_t> {
+  return this->grid;
+}
+
+void decodeRows(SudokuSize digit_range, std::span<const int> rows, std::span<std::uint8_t> digits) {
+  const int digits_per_cell = static_cast<int>(digit_range);
+
+  // row index = cell * digit_range + (number - 1), see indexForNode()
+  for (int row : rows) {
+    digits[row / digits_per_cell] = static_cast<std::uint8_t>((row % digits_per_cell) + 1);
+  }
+}
+
+void decodeRows(SudokuSize digit_range, std::span<const int> rows, std::span<const int> placements,
+                std::span<std::uint8_t> digits) {
+  const int digits_per_cell = static_cast<int>(digit_range);
+
+  for (int row : rows) {
+    const int placement = placements[row];
+    digits[placement / digits_per_cell] = static_cast<std::uint8_t>((placement % digits_per_cell) + 1);
+  }
+}
+}  // namespace sudoku
@@ -1,9 +1,11 @@
 #ifndef LIBSUDOKU_SOLUTION_HPP_
 #define LIBSUDOKU_SOLUTION_HPP_
 
+#include <cstdint>
+#include <memory_resource>
+#include <span>
 #include <vector>
 
-#include "placement.hpp"
 #include "sudoku-math.hpp"
 
 namespace sudoku {
@@ -13,13 +15,19 @@ namespace sudoku {
  * This solution is produced by the Sudoku Solver and defines a grid of size
  * digit_range x digit_range with every cell filled in with a number
  * in the range 1..digit_range such that all Sudoku rules are observed.
+ *
+ * The grid is stored as digit_range^2 bytes, row by row, in the same layout as
+ * written by \link decodeRows() and \link Solver::getSolution(std::span<std::uint8_t>) .
  */
 class Solution {
  public:
   /**
-   * Constructor converting a set of placements to an easy-to-access sudoku solution grid.
+   * Constructs a solution grid of the given size with all cells set to 0,
+   * to be filled in via \link getDigits() .
+   *
+   * \param resource The memory resource from which the solution grid is allocated.
    */
-  explicit Solution(SudokuSize digit_range, const std::vector<Placement> &raw_solution);
+  explicit Solution(SudokuSize digit_range, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
   /**
    * Get the size of the solution grid.
@@ -32,16 +40,44 @@ class Solution {
    * \param row A row (1..digit_range) in the sudoku grid
    * \param column A column (1..digit_range) in the sudoku grid
    */
-  auto getCellValue(int row, int column) -> int;
+  [[nodiscard]] auto getCellValue(int row, int column) const -> int;
+
+  /**
+   * Get the digits of all cells, row by row.
+   */
+  auto getDigits() -> std::span<std::uint8_t>;
+  [[nodiscard]] auto getDigits() const -> std::span<const std::uint8_t>;
 
  private:
   // The size of the solution grid
   SudokuSize digit_range;
 
   // The solution grid itself as a one-dimensional row-by-row vector.
-  std::vector<int> grid;
+  std::pmr::vector<std::uint8_t> grid;
 };
 
+/**
+ * Decodes the rows of an exact cover solution into the digits of a Sudoku grid.
+ *
+ * Each row is the index of a placement in a \link SudokuMatrix , see \link placementForIndex() .
+ * The number of each placement is written to its cell in digits, row by row, without any
+ * intermediate allocation. Cells not covered by any row are left unchanged.
+ *
+ * \param digits The grid to write to, of at least digit_range^2 cells.
+ */
+void decodeRows(SudokuSize digit_range, std::span<const int> rows, std::span<std::uint8_t> digits);
+
+/**
+ * Decodes the rows of a residual exact cover solution into the digits of a Sudoku grid.
+ *
+ * Each row is the index of a row in the problem of a \link SudokuProblem , whose placement is
+ * looked up in placements, see \link SudokuProblem::placements .
+ *
+ * \param digits The grid to write to, of at least digit_range^2 cells.
+ */
+void decodeRows(SudokuSize digit_range, std::span<const int> rows, std::span<const int> placements,
+                std::span<std::uint8_t> digits);
+
 }  // namespace sudoku
 
 #endif  // LIBSUDOKU_SOLUTION_HPP_
\ No newline at end of file
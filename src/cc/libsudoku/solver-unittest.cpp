@@ -1,6 +1,14 @@
 #include "solver.hpp"
 
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <set>
+
 #include "gtest/gtest.h"
+#include "src/cc/libdlx/bitset-solver.hpp"
+#include "src/cc/libdlx/memory-resource.hpp"
+#include "test-puzzles.hpp"
 
 namespace sudoku {
 namespace {
@@ -8,7 +16,7 @@ namespace {
 /**
  * Test Helper: create a small example soduku problem to be solved
  */
-auto createSmallSudoku() -> std::unique_ptr<Solver> {
+auto createSmallSudoku(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) -> std::unique_ptr<Solver> {
   // Setup the matrix for the following Sudoku:
   //  4 _ _ 1
   //  _ 1 3 _
@@ -16,7 +24,7 @@ auto createSmallSudoku() -> std::unique_ptr<Solver> {
   //  1 _ _ 3
 
   // Define input
-  auto matrix = std::make_unique<SudokuMatrix>(SudokuSize::Four);
+  auto matrix = std::make_unique<SudokuMatrix>(SudokuSize::Four, resource);
   auto solver = std::make_unique<Solver>(std::move(matrix));
 
   solver->setInput(1, 1, 4);
@@ -63,5 +71,239 @@ TEST(SudokuSolver, Small) {
   }
 }
 
+/**
+ * Test: build and solve an example sudoku entirely inside a monotonic arena
+ */
+TEST(SudokuSolver, Arena) {
+  std::pmr::monotonic_buffer_resource arena;
+  dlx::CountingMemoryResource resource(&arena);
+
+  auto solver = createSmallSudoku(&resource);
+  auto result = solver->solve();
+
+  // all matrix, solution and grid allocations went through the arena
+  EXPECT_LT(0, resource.getAllocations());
+
+  EXPECT_TRUE(result.has_value());
+  if (result.has_value()) {
+    EXPECT_EQ(4, result.value()->getCellValue(1, 1));
+    EXPECT_EQ(3, result.value()->getCellValue(1, 2));
+  }
+}
+
+/**
+ * Test: enumerate all solutions of an empty sudoku, decoding only the first
+ */
+TEST(SudokuSolver, Enumerate) {
+  Solver solver(std::make_unique<SudokuMatrix>(SudokuSize::Four));
+
+  // an empty 4x4 sudoku has 288 solutions
+  int count = 0;
+  while (solver.next()) {
+    if (count == 0) {
+      auto solution = solver.getSolution();
+      EXPECT_EQ(SudokuSize::Four, solution->getSudokuSize());
+    }
+    count++;
+  }
+
+  EXPECT_EQ(288, count);
+}
+
+/**
+ * Test: a randomized search with frequent restarts still enumerates every solution once
+ */
+TEST(SudokuSolver, Randomized) {
+  Solver solver(std::make_unique<SudokuMatrix>(SudokuSize::Four));
+  solver.randomize(42, 2);
+
+  std::set<std::array<std::uint8_t, 16>> solutions;
+  std::array<std::uint8_t, 16> digits{};
+  while (solver.next()) {
+    solver.getSolution(digits);
+    solutions.insert(digits);
+  }
+
+  EXPECT_EQ(288, solutions.size());
+}
+
+/**
+ * Test: decode a solution into a caller-provided grid, unless it is too small, and via the Solution wrapper
+ */
+TEST(SudokuSolver, Decode) {
+  auto solver = createSmallSudoku();
+  ASSERT_TRUE(solver->next());
+
+  std::array<std::uint8_t, 16> digits{};
+  EXPECT_TRUE(solver->getSolution(digits));
+  EXPECT_EQ((std::array<std::uint8_t, 16>{4, 3, 2, 1, 2, 1, 3, 4, 3, 4, 1, 2, 1, 2, 4, 3}), digits);
+
+  // a grid too small for every cell is rejected, and left unchanged
+  std::array<std::uint8_t, 15> small{};
+  EXPECT_FALSE(solver->getSolution(small));
+  EXPECT_EQ((std::array<std::uint8_t, 15>{}), small);
+
+  // the wrapper holds the same grid, with every cell in bounds
+  auto solution = solver->getSolution();
+  ASSERT_EQ(16, solution->getDigits().size());
+  EXPECT_TRUE(std::equal(digits.begin(), digits.end(), solution->getDigits().begin()));
+  EXPECT_EQ(3, solution->getCellValue(4, 4));
+}
+
+/**
+ * Test: out of range inputs are rejected without touching the matrix
+ */
+TEST(SudokuSolver, InputOutOfRange) {
+  Solver solver(std::make_unique<SudokuMatrix>(SudokuSize::Four));
+
+  EXPECT_TRUE(solver.setInput(1, 1, 4).has_value());
+
+  auto result = solver.setInput(1, 2, 5);
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(InputError::OutOfRange, result.error());
+  EXPECT_FALSE(solver.setInput(0, 1, 1).has_value());
+  EXPECT_FALSE(solver.setInput(1, 5, 1).has_value());
+
+  // the matrix is unchanged, so the sudoku still has solutions
+  EXPECT_TRUE(solver.solve().has_value());
+}
+
+/**
+ * Test: conflicting inputs are reported without touching the matrix
+ */
+TEST(SudokuSolver, InputConflict) {
+  Solver solver(std::make_unique<SudokuMatrix>(SudokuSize::Four));
+
+  EXPECT_TRUE(solver.setInput(1, 1, 4).has_value());
+
+  // same number in the same row, column and box; and a second number in the same cell
+  for (auto placement : {Placement{1, 2, 4}, Placement{3, 1, 4}, Placement{2, 2, 4}, Placement{1, 1, 3}}) {
+    auto result = solver.setInput(placement.row, placement.column, placement.number);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(InputError::Conflict, result.error());
+  }
+
+  // the matrix is unchanged, so the sudoku still has solutions
+  EXPECT_TRUE(solver.solve().has_value());
+}
+
+/**
+ * Test Helper: the example sudoku of createSmallSudoku() as a puzzle
+ */
+auto createSmallPuzzle() -> Puzzle {
+  return createPuzzle(SudokuSize::Four, {"4__1", "_13_", "_41_", "1__3"});
+}
+
+/**
+ * Test: a residual matrix built from the givens only holds the open rows and columns
+ */
+TEST(SudokuSolver, Residual) {
+  auto problem = SudokuMatrix::describe(createSmallPuzzle());
+  ASSERT_TRUE(problem.has_value());
+
+  // 8 empty cells, with 1 or 2 numbers not yet used in their row, column and box;
+  // 8 open cells, and 8 open numbers in rows, columns and boxes each
+  EXPECT_EQ(8, problem->givens.size());
+  EXPECT_EQ(12, problem->problem.getNumRows());
+  EXPECT_EQ(32, problem->problem.getNumColumns());
+
+  // the residual matrix yields the same, single solution as the full matrix
+  Solver solver(std::make_unique<SudokuMatrix>(problem.value()));
+  auto expected = createSmallSudoku()->solve();
+  ASSERT_TRUE(solver.next());
+  EXPECT_TRUE(std::ranges::equal(expected.value()->getDigits(), solver.getSolution()->getDigits()));
+  EXPECT_FALSE(solver.next());
+}
+
+/**
+ * Test: residual matrices reject conflicting givens, and inputs eliminated by the givens
+ */
+TEST(SudokuSolver, ResidualConflict) {
+  auto puzzle = createSmallPuzzle();
+  puzzle.setCellValue(1, 2, 4);
+  auto result = SudokuMatrix::fromPuzzle(puzzle);
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(InputError::Conflict, result.error());
+
+  // an empty puzzle enumerates the same solutions as the full matrix
+  auto empty = SudokuMatrix::fromPuzzle(Puzzle(SudokuSize::Four));
+  ASSERT_TRUE(empty.has_value());
+  Solver solver(std::move(empty.value()));
+
+  EXPECT_TRUE(solver.setInput(1, 1, 4).has_value());
+  EXPECT_EQ(InputError::Conflict, solver.setInput(1, 2, 4).error());
+
+  int count = 0;
+  while (solver.next()) {
+    count++;
+  }
+  EXPECT_EQ(288 / 4, count);
+}
+
+/**
+ * Test: solve the example sudoku with the bitset engine from the same description
+ */
+TEST(SudokuSolver, Bitset) {
+  dlx::BitsetSolver solver(SudokuMatrix::describe(SudokuSize::Four));
+
+  // cover the same givens as createSmallSudoku()
+  for (auto placement : {Placement{1, 1, 4}, Placement{1, 4, 1}, Placement{2, 2, 1}, Placement{2, 3, 3},
+                         Placement{3, 2, 4}, Placement{3, 3, 1}, Placement{4, 1, 1}, Placement{4, 4, 3}}) {
+    EXPECT_TRUE(solver.coverRow(indexForNode(SudokuSize::Four, placement.row, placement.column, placement.number)));
+  }
+
+  // the bitset engine finds the same solution as the dancing links engine
+  auto expected = createSmallSudoku()->solve();
+  ASSERT_TRUE(expected.has_value());
+  ASSERT_TRUE(solver.next());
+
+  const auto &rows = solver.getSolution();
+  EXPECT_EQ(16, rows.size());
+  for (int index : rows) {
+    auto placement = placementForIndex(SudokuSize::Four, index);
+    EXPECT_EQ(expected.value()->getCellValue(placement.row, placement.column), placement.number);
+  }
+
+  Solution solution(SudokuSize::Four);
+  decodeRows(SudokuSize::Four, rows, solution.getDigits());
+  EXPECT_TRUE(std::ranges::equal(expected.value()->getDigits(), solution.getDigits()));
+
+  EXPECT_FALSE(solver.next());
+}
+
+/**
+ * Test: replicas of a prepared residual solver enumerate the same solutions in their own arena
+ */
+TEST(SudokuSolver, Clone) {
+  auto matrix = SudokuMatrix::fromPuzzle(Puzzle(SudokuSize::Four));
+  ASSERT_TRUE(matrix.has_value());
+  Solver solver(std::move(matrix.value()));
+  ASSERT_TRUE(solver.setInput(1, 1, 4).has_value());
+
+  dlx::CountingMemoryResource counter;
+  std::pmr::monotonic_buffer_resource arena(&counter);
+  auto replica = solver.clone(&arena);
+  counter.reset();
+
+  // the replica keeps the input, and decodes without touching the original
+  EXPECT_EQ(InputError::Conflict, replica->setInput(1, 2, 4).error());
+
+  std::array<std::uint8_t, 16> expected{};
+  std::array<std::uint8_t, 16> digits{};
+  int count = 0;
+  while (solver.next()) {
+    ASSERT_TRUE(replica->next());
+    solver.getSolution(expected);
+    replica->getSolution(digits);
+    EXPECT_EQ(expected, digits);
+    count++;
+  }
+  EXPECT_FALSE(replica->next());
+  EXPECT_EQ(288 / 4, count);
+
+  // the search of the replica is served from its arena
+  EXPECT_EQ(0, counter.getAllocations());
+}
+
 }  // namespace
 }  // namespace sudoku
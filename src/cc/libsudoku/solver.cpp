@@ -1,34 +1,147 @@
 
 #include "solver.hpp"
 
-#include <iostream>
+#include <array>
 
 namespace sudoku {
 Solver::Solver(std::unique_ptr<SudokuMatrix> matrix)
     : matrix(matrix.get()), solver(std::move(matrix)) {}
 
-auto Solver::solve() -> std::optional<std::unique_ptr<Solution>> {
-  auto optRawSolution = this->solver.solve();
+Solver::Solver(const Solver &other, std::pmr::memory_resource *resource)
+    : matrix(nullptr), solver(other.solver, resource) {
+  // the cloned matrix is a SudokuMatrix as well, see SudokuMatrix::clone()
+  this->matrix = static_cast<SudokuMatrix *>(this->solver.getMatrix());
+}
+
+auto Solver::clone(std::pmr::memory_resource *resource) const -> std::unique_ptr<Solver> {
+  return std::make_unique<Solver>(*this, resource);
+}
 
+auto Solver::solve() -> std::optional<std::unique_ptr<Solution>> {
   // check if a solution was found
-  if (optRawSolution.has_value()) {
-    // convert internal solution to list of placement values
-    auto rawSolution = optRawSolution.value();
-    std::vector<Placement> vec_solution;
-    vec_solution.reserve(rawSolution.size());
+  if (this->next()) {
+    return this->getSolution();
+  }
+
+  return std::nullopt;
+}
 
-    for (auto *node : rawSolution) {
-      vec_solution.push_back(std::any_cast<Placement>(node->getData()));
-    }
+auto Solver::next() -> bool {
+  return this->solver.next();
+}
 
-    return std::make_unique<Solution>(this->matrix->getSudokuSize(), vec_solution);
+auto Solver::getSolution() -> std::unique_ptr<Solution> {
+  auto *resource = this->matrix->getMemoryResource();
+  auto solution = std::make_unique<Solution>(this->matrix->getSudokuSize(), resource);
+  this->getSolution(solution->getDigits());
+  return solution;
+}
+
+auto Solver::getSolution(std::span<std::uint8_t> digits) const -> bool {
+  const auto digit_range = this->matrix->getSudokuSize();
+  const auto cells = static_cast<std::size_t>(digit_range) * static_cast<std::size_t>(digit_range);
+  if (digits.size() < cells) {
+    return false;
   }
 
-  return std::nullopt;
+  // the data element of each node is its matrix row, representing a placement
+  std::array<int, MaxCells> placements{};
+  std::size_t count = 0;
+  for (auto *node : this->solver.getSolution()) {
+    placements[count++] = this->matrix->getPlacement(node->getData());
+  }
+
+  decodeRows(digit_range, this->matrix->getGivens(), digits);
+  decodeRows(digit_range, std::span<const int>(placements).first(count), digits);
+  return true;
+}
+
+auto Solver::setInput(const int row, const int column, const int number) -> Expected<void, InputError> {
+  const int digits = static_cast<int>(this->matrix->getSudokuSize());
+  if (row < 1 || row > digits || column < 1 || column > digits || number < 1 || number > digits) {
+    return Unexpected(InputError::OutOfRange);
+  }
+
+  // a placement eliminated by the givens of a residual matrix conflicts with them
+  auto *node_row = this->matrix->getNodeRow(row, column, number);
+  if (node_row == nullptr || !this->solver.coverRow(node_row)) {
+    return Unexpected(InputError::Conflict);
+  }
+
+  return {};
+}
+
+auto Solver::getNodes() const -> std::uint64_t {
+  return this->solver.getNodes();
+}
+
+void Solver::setTrace(dlx::SearchTrace *trace) {
+  this->solver.setTrace(trace);
+}
+
+void Solver::randomize(std::uint64_t seed, std::uint64_t restart_unit) {
+  this->solver.randomize(seed, restart_unit);
+}
+
+void Solver::useGenericRows() {
+  this->solver.useGenericRows();
+}
+
+auto Solver::reduce() -> dlx::Reduction {
+  return dlx::reduce(this->solver);
+}
+
+auto Solver::split(std::size_t depth) -> std::vector<dlx::WorkUnit> {
+  return this->solver.split(depth);
+}
+
+auto Solver::solveUnit(const dlx::WorkUnit &unit, bool all) -> std::optional<dlx::WorkResult> {
+  return this->solver.solveUnit(unit, all);
+}
+
+auto Solver::fingerprint() const -> std::uint64_t {
+  return this->solver.fingerprint();
+}
+
+auto Solver::coverRows(std::span<const int> rows) -> bool {
+  return this->solver.coverRows(rows);
+}
+
+auto Solver::getSolutions() const -> std::uint64_t {
+  return this->solver.getSolutions();
+}
+
+auto Solver::countSolutions(std::size_t max_bytes, std::pmr::memory_resource *resource)
+    -> std::optional<dlx::CountResult> {
+  return this->solver.countSolutions(max_bytes, resource);
+}
+
+auto Solver::estimateTreeSize(int probes, std::uint64_t seed) -> std::optional<double> {
+  return this->solver.estimateTreeSize(probes, seed);
+}
+
+auto Solver::checkpoint() const -> std::optional<dlx::Checkpoint> {
+  return this->solver.checkpoint();
+}
+
+auto Solver::resume(const dlx::Checkpoint &checkpoint) -> bool {
+  return this->solver.resume(checkpoint);
+}
+
+void Solver::setCheckpointHandler(std::uint64_t interval, dlx::CheckpointHandler handler) {
+  this->solver.setCheckpointHandler(interval, std::move(handler));
+}
+
+void Solver::requestCheckpoint() {
+  this->solver.requestCheckpoint();
+}
+
+void Solver::setCancelPredicate(std::uint64_t interval, dlx::CancelPredicate cancelled) {
+  this->solver.setCancelPredicate(interval, std::move(cancelled));
 }
 
-void Solver::setInput(const int row, const int column, const int number) {
-  this->solver.coverRow(this->matrix->getNodeRow(row, column, number));
+auto Solver::isPaused() const -> bool {
+  return this->solver.isPaused();
 }
 
-}  // namespace sudoku
\ No newline at end of file
+}  // namespace sudoku
@@ -1,7 +1,15 @@
 #ifndef LIBSUDOKU_SOLVER_HPP_
 #define LIBSUDOKU_SOLVER_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "expected.hpp"
 #include "solution.hpp"
+#include "src/cc/libdlx/reduction.hpp"
 #include "src/cc/libdlx/solver.hpp"
 #include "sudoku-matrix.hpp"
 
@@ -15,6 +23,10 @@ namespace sudoku {
  *    on the given row and column, the given number is pre-filled as input.
  *  - The solve() method converts a found solution from the raw exact cover dlx::Solution
  *    to a Sudoku Solution object.
+ *  - The next() and getSolution() methods enumerate all solutions one at a time,
+ *    only converting those solutions to Sudoku Solution objects that are requested.
+ *    A solution can also be decoded straight into a caller-provided grid of digits,
+ *    without any allocation.
  */
 class Solver {
  public:
@@ -26,6 +38,22 @@ class Solver {
    */
   explicit Solver(std::unique_ptr<SudokuMatrix> matrix);
 
+  /**
+   * Constructs a replica of the given solver in its current state, see dlx::Solver::clone() .
+   *
+   * For example, a puzzle is prepared once with its givens set as input, and each worker
+   * thread then searches its own replica.
+   *
+   * \param resource The memory resource from which the replica is allocated.
+   */
+  Solver(const Solver &other, std::pmr::memory_resource *resource);
+
+  /**
+   * Get a replica of this solver in its current state, see the copy constructor above.
+   */
+  [[nodiscard]] auto clone(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const
+      -> std::unique_ptr<Solver>;
+
   /**
    * Solve for the provided matrix using the dlx::Solver.
    *
@@ -34,11 +62,139 @@ class Solver {
    */
   auto solve() -> std::optional<std::unique_ptr<Solution>>;
 
+  /**
+   * Resume the search until the next solution is found, see dlx::Solver::next() .
+   *
+   * The solution is not converted until requested via \link getSolution() ,
+   * so that solutions can be counted or skipped cheaply.
+   *
+   * \return if a next solution was found. If false, all solutions have been enumerated.
+   */
+  auto next() -> bool;
+
+  /**
+   * Convert the solution found by the last successful call to \link next()
+   * to a Sudoku Solution object.
+   */
+  auto getSolution() -> std::unique_ptr<Solution>;
+
+  /**
+   * Decode the solution found by the last successful call to \link next()
+   * into the given grid, see \link decodeRows() . Only the cells of the solution are written,
+   * by their index row by row, so the grid must hold every cell of the Sudoku.
+   *
+   * \param digits The grid to write to, of at least digit_range^2 cells (81 for a 9x9 Sudoku),
+   *               such as \link Solution::getDigits() .
+   * \return if the solution was decoded. If false, the grid is too small and left unchanged.
+   */
+  auto getSolution(std::span<std::uint8_t> digits) const -> bool;
+
   /**
    * Update the SudokuMatrix such that on the given row and column,
    * the given number is pre-filled as input.
+   *
+   * Conflicting inputs are detected in O(1), see dlx::Solver::coverRow() , so that
+   * a Sudoku with conflicting givens is reported unsolvable before any search.
+   *
+   * \return an error if the placement is invalid, in which case the matrix is unchanged.
+   */
+  auto setInput(int row, int column, int number) -> Expected<void, InputError>;
+
+  /**
+   * Get the number of search nodes visited so far, see dlx::Solver::getNodes() .
+   */
+  [[nodiscard]] auto getNodes() const -> std::uint64_t;
+
+  /**
+   * Record every search decision into the given trace, see dlx::Solver::setTrace() .
+   */
+  void setTrace(dlx::SearchTrace *trace);
+
+  /**
+   * Switch to a randomized search with restarts, see dlx::Solver::randomize() .
+   */
+  void randomize(std::uint64_t seed, std::uint64_t restart_unit = dlx::DefaultRestartUnit);
+
+  /**
+   * Use the generic search path instead of the one specialized for four-node rows,
+   * see dlx::Solver::useGenericRows() .
+   */
+  void useGenericRows();
+
+  /**
+   * Shrink the matrix before searching, after all inputs are set, see dlx::reduce() .
+   * Forced placements become part of the solution, like inputs.
+   */
+  auto reduce() -> dlx::Reduction;
+
+  /**
+   * Split the search into units, see dlx::Solver::split() .
+   */
+  auto split(std::size_t depth) -> std::vector<dlx::WorkUnit>;
+
+  /**
+   * Search only the subtree of the given unit, see dlx::Solver::solveUnit() .
+   */
+  auto solveUnit(const dlx::WorkUnit &unit, bool all) -> std::optional<dlx::WorkResult>;
+
+  /**
+   * Get the fingerprint of the residual matrix and its inputs, see dlx::Solver::fingerprint() .
+   */
+  [[nodiscard]] auto fingerprint() const -> std::uint64_t;
+
+  /**
+   * Cover the matrix rows with the given indices, see dlx::Solver::coverRows() .
+   * For example, covering the rows of a merged first solution lets next() report it at once.
+   */
+  auto coverRows(std::span<const int> rows) -> bool;
+
+  /**
+   * Get the number of solutions found so far, see dlx::Solver::getSolutions() .
+   */
+  [[nodiscard]] auto getSolutions() const -> std::uint64_t;
+
+  /**
+   * Count all solutions, memoizing the count of every subproblem, see dlx::Solver::countSolutions() .
+   */
+  auto countSolutions(std::size_t max_bytes = dlx::DefaultCountCacheBytes,
+                      std::pmr::memory_resource *resource = std::pmr::new_delete_resource())
+      -> std::optional<dlx::CountResult>;
+
+  /**
+   * Estimate the number of search nodes to enumerate all solutions, see dlx::Solver::estimateTreeSize() .
+   */
+  auto estimateTreeSize(int probes, std::uint64_t seed) -> std::optional<double>;
+
+  /**
+   * Get a checkpoint of the search in its current state, see dlx::Solver::checkpoint() .
+   */
+  [[nodiscard]] auto checkpoint() const -> std::optional<dlx::Checkpoint>;
+
+  /**
+   * Restore the search from a checkpoint, see dlx::Solver::resume() .
+   * The givens of a residual matrix are part of the matrix, so no input must be set before.
+   */
+  auto resume(const dlx::Checkpoint &checkpoint) -> bool;
+
+  /**
+   * Hand checkpoints of the search to the given handler, see dlx::Solver::setCheckpointHandler() .
+   */
+  void setCheckpointHandler(std::uint64_t interval, dlx::CheckpointHandler handler);
+
+  /**
+   * Request a checkpoint at the next search node, see dlx::Solver::requestCheckpoint() .
+   */
+  void requestCheckpoint();
+
+  /**
+   * Ask the given predicate whether the search is still needed, see dlx::Solver::setCancelPredicate() .
+   */
+  void setCancelPredicate(std::uint64_t interval, dlx::CancelPredicate cancelled);
+
+  /**
+   * Get if the search was paused by the checkpoint handler or the cancel predicate, see dlx::Solver::isPaused() .
    */
-  void setInput(int row, int column, int number);
+  [[nodiscard]] auto isPaused() const -> bool;
 
  private:
   // The matrix modelling the Sudoku problem
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <cstdint>
 
+#include "placement.hpp"
+
 namespace sudoku {
 /**
  * SudokuSize predefines valid possible digit range sizes for a valid sudoku grid.
@@ -22,6 +24,16 @@ enum class SudokuSize : std::uint8_t {
   Sixteen = 16
 };
 
+/**
+ * Largest supported number of digits, see \link SudokuSize
+ */
+constexpr int MaxDigits = static_cast<int>(SudokuSize::Sixteen);
+
+/**
+ * Number of cells in the largest supported Sudoku
+ */
+constexpr int MaxCells = MaxDigits * MaxDigits;
+
 /*******
  * The below helper methods calculate the header node index for a given Sudoku condition.
  *
@@ -96,6 +108,15 @@ inline auto indexForNode(const SudokuSize digit_range, const int row, const int
   return ((row - 1) * static_cast<int>(digit_range) * static_cast<int>(digit_range)) + ((column - 1) * static_cast<int>(digit_range)) + (number - 1);
 }
 
+/**
+ * Helper method to calculate the placement for a given lookup index.
+ * This is the inverse of indexForNode(), used to interpret the rows of a solution.
+ */
+inline auto placementForIndex(const SudokuSize digit_range, const int index) -> Placement {
+  const int digits = static_cast<int>(digit_range);
+  return Placement{(index / (digits * digits)) + 1, ((index / digits) % digits) + 1, (index % digits) + 1};
+}
+
 }  // namespace sudoku
 
 #endif  // LIBSUDOKU_SUDOKU_MATH_HPP_
\ No newline at end of file
@@ -1,7 +1,9 @@
 
 #include "sudoku-matrix.hpp"
 
-#include "placement.hpp"
+#include <array>
+#include <cmath>
+#include <utility>
 
 namespace sudoku {
 
@@ -18,18 +20,38 @@ constexpr int TypesOfConditions = 4;
  * Constructs a new sparse matrix modelling a Sudoku problem
  * of the given size.
  */
-SudokuMatrix::SudokuMatrix(SudokuSize sudoku_size)
-    : sudoku_size(sudoku_size) {
-  const int num_digits = static_cast<int>(this->sudoku_size);
+SudokuMatrix::SudokuMatrix(SudokuSize sudoku_size, std::pmr::memory_resource *resource)
+    : dlx::DancingLinksMatrix(SudokuMatrix::describe(sudoku_size, resource), resource),
+      sudoku_size(sudoku_size),
+      placements(resource),
+      placement_rows(resource),
+      givens(resource) {
+  // Now we have our sparse matrix fully constructed.
+  //
+  //                         ^                       ^
+  //                         v                       v
+  //  [this->root] <-> [condition 1] <-> ... <-> [condition n] <->
+  //                         ^                       ^
+  //                         v                       |
+  //                  <-> [1,1,1] <-> [1,1,1] <->    |
+  //                         ^                       v
+  //                         v   <-> [9,9,9] <-> [9,9,9] <->
+  //                        ....                     ^
+  //                                                 v
+  //
+  // The data element of every node holds its row index, from which the placement
+  // is recovered via placementForIndex() after finding a solution.
+}
+
+auto SudokuMatrix::describe(SudokuSize sudoku_size, std::pmr::memory_resource *resource) -> dlx::ExactCoverProblem {
+  const int num_digits = static_cast<int>(sudoku_size);
 
   /**
-   * This matrix will model the exact cover problem for a sudoku of size <sudoku_size>
-   * The matrix is represented as a sparse matrix structure and
-   * implemented using the dancing link nodes as doubly-linked lists.
+   * This problem will model the exact cover problem for a sudoku of size <sudoku_size>
    *
-   * Each column in this matrix will represent one condition choice.
+   * Each column in this problem will represent one condition choice.
    *
-   * We model these conditions in 4 groups of header columns:
+   * We model these conditions in 4 groups of columns:
    *  1. the first digit_range^2 columns represent
    *     for each cell a number is filled in
    *  2. the second digit_range^2 columns represent
@@ -44,64 +66,161 @@ SudokuMatrix::SudokuMatrix(SudokuSize sudoku_size)
    *
    */
   const int NumConditions = num_digits * num_digits * TypesOfConditions;
+  dlx::ExactCoverProblem problem(NumConditions, resource);
 
-  // We will use this helper data-structure to quickly lookup column headers by index
-  // This is used while filling the matrix with nodes matching the correct column
-  std::vector<dlx::DancingLinkHeader *> columnByIndex(NumConditions);
+  // Next, we add a row for every possible digit in every cell
+  // The total number of rows to model equals:
+  //    numNodes = digits * digits * digits
+  //             = 9 * 9 * 9 = 729   for a typical sudoku of size digits=9
+  // Rows are added in order of indexForNode(), so that a row index maps back to its placement.
+  for (int row = 1; row <= num_digits; row++) {
+    for (int column = 1; column <= num_digits; column++) {
+      for (int number = 1; number <= num_digits; number++) {
+        // Mark for condition: cell, row, column, and box
+        problem.addRow({indexForCondCell(sudoku_size, row, column),
+                        indexForCondRow(sudoku_size, row, number),
+                        indexForCondColumn(sudoku_size, column, number),
+                        indexForCondBox(sudoku_size, row, column, number)});
+      }
+    }
+  }
+
+  return problem;
+}
 
-  // Create every column header
-  for (int i = 0; i < NumConditions; i++) {
-    columnByIndex[i] = this->newHeader();
+SudokuMatrix::SudokuMatrix(const SudokuProblem &problem, std::pmr::memory_resource *resource)
+    : dlx::DancingLinksMatrix(problem.problem, resource),
+      sudoku_size(problem.sudoku_size),
+      placements(problem.placements.begin(), problem.placements.end(), resource),
+      placement_rows(static_cast<std::size_t>(problem.sudoku_size) * static_cast<std::size_t>(problem.sudoku_size) * static_cast<std::size_t>(problem.sudoku_size), -1, resource),
+      givens(problem.givens.begin(), problem.givens.end(), resource) {
+  // Lookup for the rows of the remaining placements, used to set further input
+  for (int row = 0; row < static_cast<int>(this->placements.size()); row++) {
+    this->placement_rows[this->placements[row]] = row;
   }
+}
 
-  // Next, we fill the matrix with nodes, representing every possible digit in every cell
-  // The total number of nodes to model equals:
-  //    numNodes = digits * digits * digits
-  //             = 9 * 9 * 9 = 729   for a typical sudoku of size digits=9
-  const int NumNodes = num_digits * num_digits * num_digits;
+SudokuMatrix::SudokuMatrix(const SudokuMatrix &other, std::pmr::memory_resource *resource)
+    : dlx::DancingLinksMatrix(other, resource),
+      sudoku_size(other.sudoku_size),
+      placements(other.placements, resource),
+      placement_rows(other.placement_rows, resource),
+      givens(other.givens, resource) {}
+
+auto SudokuMatrix::clone(std::pmr::memory_resource *resource) const -> std::unique_ptr<dlx::DancingLinksMatrix> {
+  return std::make_unique<SudokuMatrix>(*this, resource);
+}
+
+auto SudokuMatrix::fromPuzzle(const Puzzle &puzzle, std::pmr::memory_resource *resource)
+    -> Expected<std::unique_ptr<SudokuMatrix>, InputError> {
+  auto problem = SudokuMatrix::describe(puzzle, resource);
+  if (!problem) {
+    return Unexpected(problem.error());
+  }
+
+  return std::make_unique<SudokuMatrix>(*problem, resource);
+}
+
+auto SudokuMatrix::describe(const Puzzle &puzzle, std::pmr::memory_resource *resource) -> Expected<SudokuProblem, InputError> {
+  const auto sudoku_size = puzzle.getSudokuSize();
+  const int num_digits = static_cast<int>(sudoku_size);
+  const int box_size = static_cast<int>(std::floor(std::sqrt(static_cast<float>(num_digits))));
+  const auto cells = puzzle.getCells();
+
+  // The numbers used by the givens in each row, column and box (bit number - 1)
+  std::array<std::uint32_t, MaxDigits> used_rows{}, used_columns{}, used_boxes{};
+  std::pmr::vector<int> givens(resource);
+
+  // Apply the givens, checking each against the previous ones
+  for (int row = 0; row < num_digits; row++) {
+    for (int column = 0; column < num_digits; column++) {
+      const int number = cells[row * num_digits + column];
+      if (number == Puzzle::EmptyCell) {
+        continue;
+      }
+      if (number < 1 || number > num_digits) {
+        return Unexpected(InputError::OutOfRange);
+      }
+
+      const std::uint32_t bit = std::uint32_t{1} << (number - 1);
+      const int box = (row / box_size) * box_size + (column / box_size);
+      if (((used_rows[row] | used_columns[column] | used_boxes[box]) & bit) != 0) {
+        return Unexpected(InputError::Conflict);
+      }
+
+      used_rows[row] |= bit;
+      used_columns[column] |= bit;
+      used_boxes[box] |= bit;
+      givens.push_back(indexForNode(sudoku_size, row + 1, column + 1, number));
+    }
+  }
 
-  // We use this helper data-structure to quickly lookup root/starting placement nodes by index
-  // This will be used to lookup a row of nodes for a given (row, column, number) triplet.
-  this->index2node.reserve(NumNodes);
+  // Number the conditions not yet met by the givens, in the order of the full matrix
+  const int NumConditions = num_digits * num_digits * TypesOfConditions;
+  std::pmr::vector<int> columns(NumConditions, -1, resource);
+  int num_columns = 0;
 
-  // Create every node and add to the vertical list of the right column headers
   for (int row = 1; row <= num_digits; row++) {
     for (int column = 1; column <= num_digits; column++) {
+      if (cells[(row - 1) * num_digits + column - 1] == Puzzle::EmptyCell) {
+        columns[indexForCondCell(sudoku_size, row, column)] = num_columns++;
+      }
+    }
+  }
+  for (int unit = 1; unit <= num_digits; unit++) {
+    for (int number = 1; number <= num_digits; number++) {
+      if ((used_rows[unit - 1] & (std::uint32_t{1} << (number - 1))) == 0) {
+        columns[indexForCondRow(sudoku_size, unit, number)] = num_columns++;
+      }
+    }
+  }
+  for (int unit = 1; unit <= num_digits; unit++) {
+    for (int number = 1; number <= num_digits; number++) {
+      if ((used_columns[unit - 1] & (std::uint32_t{1} << (number - 1))) == 0) {
+        columns[indexForCondColumn(sudoku_size, unit, number)] = num_columns++;
+      }
+    }
+  }
+  for (int box = 0; box < num_digits; box++) {
+    // indexForCondBox() identifies a box by any of its cells, e.g. its top-left cell
+    const int row = (box / box_size) * box_size + 1;
+    const int column = (box % box_size) * box_size + 1;
+    for (int number = 1; number <= num_digits; number++) {
+      if ((used_boxes[box] & (std::uint32_t{1} << (number - 1))) == 0) {
+        columns[indexForCondBox(sudoku_size, row, column, number)] = num_columns++;
+      }
+    }
+  }
+
+  SudokuProblem problem{sudoku_size, dlx::ExactCoverProblem(num_columns, resource),
+                        std::pmr::vector<int>(resource), std::move(givens)};
+
+  // Add a row for every number in every empty cell, not yet used in its row, column or box
+  for (int row = 1; row <= num_digits; row++) {
+    for (int column = 1; column <= num_digits; column++) {
+      if (cells[(row - 1) * num_digits + column - 1] != Puzzle::EmptyCell) {
+        continue;
+      }
+
+      const int box = ((row - 1) / box_size) * box_size + ((column - 1) / box_size);
+      const std::uint32_t used = used_rows[row - 1] | used_columns[column - 1] | used_boxes[box];
+
       for (int number = 1; number <= num_digits; number++) {
+        if ((used & (std::uint32_t{1} << (number - 1))) != 0) {
+          continue;
+        }
+
         // Mark for condition: cell, row, column, and box
-        auto *nodeCell = columnByIndex[indexForCondCell(sudoku_size, row, column)]->newNode();
-        auto *nodeRow = columnByIndex[indexForCondRow(sudoku_size, row, number)]->newNode();
-        auto *nodeColumn = columnByIndex[indexForCondColumn(sudoku_size, column, number)]->newNode();
-        auto *nodeBox = columnByIndex[indexForCondBox(sudoku_size, row, column, number)]->newNode();
-
-        // Define matrix row
-        dlx::DancingLinkNode::makeRow(nodeCell, nodeRow, nodeColumn, nodeBox);
-
-        // Add Placement meta data so that after finding a solution,
-        // we can reinterpret the DancingLinkNodes as values in a Sudoku grid
-        Placement data(row, column, number);
-        nodeCell->setData(data);
-        nodeRow->setData(data);
-        nodeColumn->setData(data);
-        nodeBox->setData(data);
-
-        this->index2node[indexForNode(sudoku_size, row, column, number)] = nodeCell;
+        problem.problem.addRow({columns[indexForCondCell(sudoku_size, row, column)],
+                                columns[indexForCondRow(sudoku_size, row, number)],
+                                columns[indexForCondColumn(sudoku_size, column, number)],
+                                columns[indexForCondBox(sudoku_size, row, column, number)]});
+        problem.placements.push_back(indexForNode(sudoku_size, row, column, number));
       }
     }
   }
 
-  // Now we have our sparse matrix fully constructed.
-  //
-  //                         ^                       ^
-  //                         v                       v
-  //  [this->root] <-> [condition 1] <-> ... <-> [condition n] <->
-  //                         ^                       ^
-  //                         v                       |
-  //                  <-> [1,1,1] <-> [1,1,1] <->    |
-  //                         ^                       v
-  //                         v   <-> [9,9,9] <-> [9,9,9] <->
-  //                        ....                     ^
-  //                                                 v
+  return problem;
 }
 
 auto SudokuMatrix::getSudokuSize() const -> SudokuSize {
@@ -109,7 +228,21 @@ auto SudokuMatrix::getSudokuSize() const -> SudokuSize {
 }
 
 auto SudokuMatrix::getNodeRow(const int row, const int column, const int number) -> dlx::DancingLinkNode * {
-  return this->index2node[indexForNode(this->sudoku_size, row, column, number)];
+  const int index = indexForNode(this->sudoku_size, row, column, number);
+  if (this->placement_rows.empty()) {
+    return this->getRow(index);
+  }
+
+  const int matrix_row = this->placement_rows[index];
+  return matrix_row < 0 ? nullptr : this->getRow(matrix_row);
+}
+
+auto SudokuMatrix::getPlacement(int row) const -> int {
+  return this->placements.empty() ? row : this->placements[row];
+}
+
+auto SudokuMatrix::getGivens() const -> std::span<const int> {
+  return this->givens;
 }
 
 }  // namespace sudoku
\ No newline at end of file
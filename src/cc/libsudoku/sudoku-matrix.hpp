@@ -1,12 +1,51 @@
 #ifndef LIBSUDOKU_SUDOKU_MATRIX_HPP_
 #define LIBSUDOKU_SUDOKU_MATRIX_HPP_
 
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <vector>
 
+#include "expected.hpp"
+#include "placement.hpp"
+#include "puzzle.hpp"
 #include "src/cc/libdlx/dancing-links-matrix.hpp"
+#include "src/cc/libdlx/exact-cover-problem.hpp"
 #include "sudoku-math.hpp"
 
 namespace sudoku {
+/**
+ * The reasons an input placement cannot be set, see \link Solver::setInput()
+ * and \link SudokuMatrix::describe(const Puzzle &, std::pmr::memory_resource *) .
+ */
+enum class InputError : std::uint8_t {
+  // The row, column or number is outside the range 1..digit_range
+  OutOfRange,
+
+  // The placement conflicts with a previous input: its cell is already filled in, or its
+  // number is already in its row, column or box. The Sudoku has no solution.
+  Conflict
+};
+
+/**
+ * The exact cover problem of a Sudoku with its givens already applied,
+ * see \link SudokuMatrix::describe(const Puzzle &, std::pmr::memory_resource *) .
+ */
+struct SudokuProblem {
+  // The size of the Sudoku grid
+  SudokuSize sudoku_size;
+
+  // The conditions not yet met by the givens, and the placements consistent with the givens
+  dlx::ExactCoverProblem problem;
+
+  // The placement (see indexForNode()) represented by each row of the problem
+  std::pmr::vector<int> placements;
+
+  // The placements (see indexForNode()) of the givens, which are part of every solution
+  std::pmr::vector<int> givens;
+};
+
 /**
  * The SudokuMatrix represents a sparse matrix capturing a Sudoku problem.
  *
@@ -17,14 +56,77 @@ namespace sudoku {
  *
  * The \link Solver class can be used to update this matrix such that on
  * a given row and column, a given number is pre-filled as input.
+ *
+ * The matrix is built from the exact cover description given by \link describe() ,
+ * which can also be solved directly by the dense dlx::BitsetSolver . In both cases,
+ * row i of the description represents the placement at \link placementForIndex(i) .
+ *
+ * Alternatively, the matrix is built lazily from a \link SudokuProblem , holding only
+ * the rows and columns consistent with the givens of a puzzle. Such a residual matrix
+ * has its givens applied already, and its size scales with the number of empty cells
+ * rather than with digit_range^3. Its rows map to placements via \link getPlacement() .
  */
 class SudokuMatrix : public dlx::DancingLinksMatrix {
  public:
   /**
    * Constructs a new sparse matrix modelling a Sudoku problem
    * of the given size.
+   *
+   * \param resource The memory resource from which the matrix is allocated.
+   *                 The resource must outlive this matrix.
    */
-  explicit SudokuMatrix(SudokuSize size);
+  explicit SudokuMatrix(SudokuSize size, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Constructs a new residual sparse matrix modelling the given Sudoku problem,
+   * with its givens already applied.
+   *
+   * \param resource The memory resource from which the matrix is allocated.
+   *                 The resource must outlive this matrix.
+   */
+  explicit SudokuMatrix(const SudokuProblem &problem, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  /**
+   * Constructs an exact copy of the given matrix in its current state, including its givens
+   * and placement lookups, see dlx::DancingLinksMatrix::clone() .
+   *
+   * \param resource The memory resource from which the copy is allocated.
+   */
+  SudokuMatrix(const SudokuMatrix &other, std::pmr::memory_resource *resource);
+
+  [[nodiscard]] auto clone(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const
+      -> std::unique_ptr<dlx::DancingLinksMatrix> override;
+
+  /**
+   * Constructs a new residual sparse matrix for the given puzzle, see \link describe(const Puzzle &, std::pmr::memory_resource *) .
+   *
+   * \return the matrix, or an error if the givens of the puzzle are out of range or conflict.
+   */
+  static auto fromPuzzle(const Puzzle &puzzle, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      -> Expected<std::unique_ptr<SudokuMatrix>, InputError>;
+
+  /**
+   * Describes the exact cover problem of a Sudoku of the given size.
+   *
+   * Columns represent the Sudoku conditions, see \link indexForCondCell() and friends.
+   * Rows represent the placements, with row \link indexForNode() for each placement.
+   *
+   * \param resource The memory resource from which the description is allocated.
+   */
+  static auto describe(SudokuSize size, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) -> dlx::ExactCoverProblem;
+
+  /**
+   * Describes the residual exact cover problem of the given puzzle, with its givens applied.
+   *
+   * Only the columns of conditions not met by the givens, and only the rows of placements in
+   * empty cells not conflicting with the givens are included. Givens are checked against each
+   * other with bitmasks per row, column and box, in O(1) per given.
+   *
+   * \param resource The memory resource from which the description is allocated.
+   * \return the description, or an error if the givens are out of range or conflict.
+   */
+  static auto describe(const Puzzle &puzzle, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+      -> Expected<SudokuProblem, InputError>;
 
   /**
    * Get the size of the solution grid.
@@ -32,17 +134,33 @@ class SudokuMatrix : public dlx::DancingLinksMatrix {
   [[nodiscard]] auto getSudokuSize() const -> SudokuSize;
 
   /**
-   * Get the DancingLinkNode row node corresponding to a given placement.
+   * Get the DancingLinkNode row node corresponding to a given placement,
+   * or nullptr if the placement was eliminated by the givens of a residual matrix.
    */
   auto getNodeRow(int row, int column, int number) -> dlx::DancingLinkNode *;
 
+  /**
+   * Get the placement (see \link indexForNode() ) represented by the given matrix row.
+   */
+  [[nodiscard]] auto getPlacement(int row) const -> int;
+
+  /**
+   * Get the placements (see \link indexForNode() ) of the givens applied during construction.
+   */
+  [[nodiscard]] auto getGivens() const -> std::span<const int>;
+
  private:
   // The size of the solution grid
   SudokuSize sudoku_size;
 
-  // Lookup vector for placement nodes by index.
-  // This is used to lookup a row of nodes for a given (row, column, number) triplet.
-  std::vector<dlx::DancingLinkNode *> index2node;
+  // The placement represented by each matrix row, or empty if row i represents placement i
+  std::pmr::vector<int> placements;
+
+  // The matrix row of each placement, or -1 if eliminated; empty if placement i is row i
+  std::pmr::vector<int> placement_rows;
+
+  // The placements of the givens applied during construction
+  std::pmr::vector<int> givens;
 };
 
 }  // namespace sudoku
@@ -0,0 +1,17 @@
+#include "test-puzzles.hpp"
+
+namespace sudoku {
+auto createPuzzle(SudokuSize size, std::initializer_list<const char *> rows) -> Puzzle {
+  Puzzle puzzle(size);
+  int row = 1;
+  for (const char *cells : rows) {
+    for (int column = 1; cells[column - 1] != '\0'; column++) {
+      if (cells[column - 1] != '_') {
+        puzzle.setCellValue(row, column, cells[column - 1] - '0');
+      }
+    }
+    row++;
+  }
+  return puzzle;
+}
+}  // namespace sudoku
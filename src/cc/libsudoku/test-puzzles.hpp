@@ -0,0 +1,20 @@
+#ifndef LIBSUDOKU_TEST_PUZZLES_HPP_
+#define LIBSUDOKU_TEST_PUZZLES_HPP_
+
+#include <initializer_list>
+
+#include "puzzle.hpp"
+#include "sudoku-math.hpp"
+
+namespace sudoku {
+/**
+ * Test Helper: create a puzzle from rows of digits, with '_' for empty cells.
+ *
+ * Only for the unit tests of this library, for grids of up to 9x9, e.g.
+ * createPuzzle(SudokuSize::Four, {"4__1", "_13_", "_41_", "1__3"}).
+ */
+auto createPuzzle(SudokuSize size, std::initializer_list<const char *> rows) -> Puzzle;
+
+}  // namespace sudoku
+
+#endif  // LIBSUDOKU_TEST_PUZZLES_HPP_
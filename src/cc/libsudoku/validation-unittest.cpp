@@ -0,0 +1,83 @@
+#include "validation.hpp"
+
+#include "gtest/gtest.h"
+#include "test-puzzles.hpp"
+
+namespace sudoku {
+namespace {
+
+/**
+ * Test: a complete and valid grid is solved
+ */
+TEST(SudokuValidation, Solved) {
+  auto validation = validate(createPuzzle(SudokuSize::Four, {"4321", "2134", "3412", "1243"}));
+
+  EXPECT_TRUE(validation.complete);
+  EXPECT_TRUE(validation.isValid());
+  EXPECT_TRUE(validation.isSolved());
+}
+
+/**
+ * Test: a valid partial grid is valid, but not solved
+ */
+TEST(SudokuValidation, Partial) {
+  auto validation = validate(createPuzzle(SudokuSize::Four, {"4__1", "_13_", "_41_", "1__3"}));
+
+  EXPECT_FALSE(validation.complete);
+  EXPECT_TRUE(validation.isValid());
+  EXPECT_FALSE(validation.isSolved());
+}
+
+/**
+ * Test: all cells involved in a duplicate row, column or box are reported, in order
+ */
+TEST(SudokuValidation, Conflicts) {
+  // row 1 has two 4s; column 4 has two 1s; the top-left box has two 1s
+  auto validation = validate(createPuzzle(SudokuSize::Four, {"44_1", "_1__", "___1", "1___"}));
+
+  EXPECT_FALSE(validation.isValid());
+
+  std::vector<std::pair<int, int>> cells;
+  for (auto conflict : validation.conflicts) {
+    cells.emplace_back(conflict.row, conflict.column);
+  }
+
+  // the 1s at (2,2) and (1,4) do not share a row, column or box with another 1
+  EXPECT_EQ((std::vector<std::pair<int, int>>{{1, 1}, {1, 2}, {1, 4}, {3, 4}}), cells);
+}
+
+/**
+ * Test: out of range numbers are conflicts
+ */
+TEST(SudokuValidation, OutOfRange) {
+  auto validation = validate(createPuzzle(SudokuSize::Four, {"4__9", "____", "____", "____"}));
+
+  ASSERT_EQ(1, validation.conflicts.size());
+  EXPECT_EQ(1, validation.conflicts[0].row);
+  EXPECT_EQ(4, validation.conflicts[0].column);
+  EXPECT_EQ(9, validation.conflicts[0].number);
+}
+
+/**
+ * Test: boxes are checked for every supported size
+ */
+TEST(SudokuValidation, Boxes) {
+  for (auto size : {SudokuSize::Four, SudokuSize::Nine, SudokuSize::Sixteen}) {
+    const int digits = static_cast<int>(size);
+    const int box_size = static_cast<int>(std::sqrt(digits));
+
+    // the same number in the last cell of the first box, and the first cell of the second row of it
+    Puzzle puzzle(size);
+    puzzle.setCellValue(1, box_size, 1);
+    puzzle.setCellValue(2, 1, 1);
+    EXPECT_EQ(2, validate(puzzle).conflicts.size());
+
+    // but not when in different boxes
+    puzzle.setCellValue(2, 1, Puzzle::EmptyCell);
+    puzzle.setCellValue(2, box_size + 1, 1);
+    EXPECT_TRUE(validate(puzzle).isValid());
+  }
+}
+
+}  // namespace
+}  // namespace sudoku
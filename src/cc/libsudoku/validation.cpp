@@ -0,0 +1,86 @@
+#include "validation.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace sudoku {
+
+/**
+ * A set of numbers 1..MaxDigits, with bit (number - 1) set for each number in the set
+ */
+using NumberMask = std::uint32_t;
+
+auto validate(const Puzzle &puzzle) -> Validation {
+  const int digits = static_cast<int>(puzzle.getSudokuSize());
+  const int box_size = static_cast<int>(std::floor(std::sqrt(static_cast<float>(digits))));
+  const auto cells = puzzle.getCells();
+
+  // the numbers seen so far, and the numbers seen more than once, per row, column and box
+  std::array<NumberMask, MaxDigits> rows{}, columns{}, boxes{};
+  std::array<NumberMask, MaxDigits> duplicate_rows{}, duplicate_columns{}, duplicate_boxes{};
+
+  Validation validation;
+  bool out_of_range = false;
+
+  // first pass: record every number, and any number seen twice
+  for (int row = 0; row < digits; row++) {
+    for (int column = 0; column < digits; column++) {
+      const int number = cells[row * digits + column];
+      if (number == Puzzle::EmptyCell) {
+        validation.complete = false;
+        continue;
+      }
+      if (number < 1 || number > digits) {
+        out_of_range = true;
+        continue;
+      }
+
+      const NumberMask bit = NumberMask{1} << (number - 1);
+      const int box = (row / box_size) * box_size + (column / box_size);
+
+      duplicate_rows[row] |= rows[row] & bit;
+      duplicate_columns[column] |= columns[column] & bit;
+      duplicate_boxes[box] |= boxes[box] & bit;
+
+      rows[row] |= bit;
+      columns[column] |= bit;
+      boxes[box] |= bit;
+    }
+  }
+
+  NumberMask any_duplicate = 0;
+  for (int index = 0; index < digits; index++) {
+    any_duplicate |= duplicate_rows[index] | duplicate_columns[index] | duplicate_boxes[index];
+  }
+
+  // the common case: no conflicts, so no need to look for the cells involved
+  if (any_duplicate == 0 && !out_of_range) {
+    return validation;
+  }
+
+  // second pass: collect every cell with an out of range or duplicate number
+  for (int row = 0; row < digits; row++) {
+    for (int column = 0; column < digits; column++) {
+      const int number = cells[row * digits + column];
+      if (number == Puzzle::EmptyCell) {
+        continue;
+      }
+
+      bool conflict = number < 1 || number > digits;
+      if (!conflict) {
+        const NumberMask bit = NumberMask{1} << (number - 1);
+        const int box = (row / box_size) * box_size + (column / box_size);
+        conflict = ((duplicate_rows[row] | duplicate_columns[column] | duplicate_boxes[box]) & bit) != 0;
+      }
+
+      if (conflict) {
+        validation.conflicts.push_back(Placement{row + 1, column + 1, number});
+      }
+    }
+  }
+
+  return validation;
+}
+
+}  // namespace sudoku
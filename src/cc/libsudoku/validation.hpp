@@ -0,0 +1,49 @@
+#ifndef LIBSUDOKU_VALIDATION_HPP_
+#define LIBSUDOKU_VALIDATION_HPP_
+
+#include <vector>
+
+#include "placement.hpp"
+#include "puzzle.hpp"
+
+namespace sudoku {
+/**
+ * The result of validating a (partially) filled Sudoku grid, see \link validate() .
+ */
+struct Validation {
+  // Whether every cell of the grid is filled in
+  bool complete = true;
+
+  // The filled cells violating a Sudoku rule, in row-by-row order. A cell violates a rule
+  // if its number is out of range, or appears more than once in its row, column or box.
+  std::vector<Placement> conflicts;
+
+  /**
+   * Returns if the grid observes all Sudoku rules, i.e., has no conflicting cells.
+   */
+  [[nodiscard]] auto isValid() const -> bool {
+    return this->conflicts.empty();
+  }
+
+  /**
+   * Returns if the grid is a complete and valid Sudoku solution.
+   */
+  [[nodiscard]] auto isSolved() const -> bool {
+    return this->complete && this->isValid();
+  }
+};
+
+/**
+ * Checks the given grid against the Sudoku rules, without building a \link SudokuMatrix .
+ *
+ * Every row, column and box keeps a bitmask of the numbers seen so far, so that a grid is
+ * checked in a single pass over its cells. Only if that pass finds a duplicate, a second
+ * pass collects all the cells involved. Empty cells are never in conflict.
+ *
+ * Note that a valid partial grid may still have no solution; use the \link Solver for that.
+ */
+auto validate(const Puzzle &puzzle) -> Validation;
+
+}  // namespace sudoku
+
+#endif  // LIBSUDOKU_VALIDATION_HPP_
@@ -0,0 +1,178 @@
+#include "batch-scheduler.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "prometheus-phase-observer.hpp"
+#include "timing-phase-observer.hpp"
+
+namespace app {
+
+namespace {
+
+/**
+ * An empty 9x9 Sudoku, which is expensive enough to be split into work units
+ */
+const std::string EmptySudoku = [] {
+  std::string puzzle;
+  for (int row = 0; row < 9; row++) {
+    puzzle += "_ _ _ _ _ _ _ _ _\n";
+  }
+  return puzzle;
+}();
+
+/**
+ * A batch of a solvable, a conflicting and an empty Sudoku
+ */
+const std::string Batch = "4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n\n"
+                          "4 4 _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n\n" +
+                          EmptySudoku;
+
+/**
+ * Test: every schedule writes the same output as a sequential batch, on any number of workers
+ */
+TEST(MainBatchScheduler, SameOutput) {
+  std::istringstream sequential_input(Batch);
+  std::ostringstream expected;
+  EXPECT_FALSE(processBatch(sequential_input, expected));
+
+  for (auto schedule : {Schedule::Fifo, Schedule::LongestFirst}) {
+    for (unsigned jobs = 1; jobs <= 4; jobs++) {
+      std::istringstream input(Batch);
+      std::ostringstream output;
+      EXPECT_FALSE(processScheduledBatch(input, output, jobs, schedule));
+      EXPECT_EQ(expected.str(), output.str()) << scheduleName(schedule) << ", " << jobs << " jobs";
+    }
+  }
+}
+
+/**
+ * Test: a puzzle outlasting the rest of the batch is split into work units, and yields the first
+ * solution of a search of the whole tree
+ */
+TEST(MainBatchScheduler, SplitPuzzle) {
+  std::istringstream input(EmptySudoku);
+  std::ostringstream expected;
+  ASSERT_TRUE(processSudoku(input, expected));
+
+  auto run = runBatch({EmptySudoku}, 3, Schedule::LongestFirst);
+  EXPECT_TRUE(run.all_solved);
+  EXPECT_EQ(1, run.split_puzzles);
+  EXPECT_LE(SplitUnitsPerJob * 3, run.cpu_times.size());
+  ASSERT_EQ(1, run.outputs.size());
+  EXPECT_EQ(expected.str(), run.outputs.front());
+
+  // a single worker has nothing to spread the units across
+  auto single = runBatch({EmptySudoku}, 1, Schedule::LongestFirst);
+  EXPECT_EQ(0, single.split_puzzles);
+  EXPECT_EQ(1, single.cpu_times.size());
+  EXPECT_EQ(expected.str(), single.outputs.front());
+}
+
+/**
+ * Test: split puzzles honour the search options, and puzzles are not split for an engine
+ * that cannot split its search
+ */
+TEST(MainBatchScheduler, SplitSearchOptions) {
+  SearchOptions reduced;
+  reduced.reduce = true;
+  SearchOptions generic;
+  generic.generic_rows = true;
+  SearchOptions cells;
+  cells.dancing_cells = true;
+  SearchOptions bitset;
+  bitset.bitset = true;
+
+  for (const auto& [search, splits] : {std::pair{reduced, 1}, {generic, 1}, {cells, 0}, {bitset, 0}}) {
+    std::istringstream input(EmptySudoku);
+    std::ostringstream expected;
+    ASSERT_TRUE(processSudoku(input, expected, nullptr, search));
+
+    auto run = runBatch({EmptySudoku}, 3, Schedule::LongestFirst, search);
+    EXPECT_TRUE(run.all_solved);
+    EXPECT_EQ(splits, run.split_puzzles);
+    ASSERT_EQ(1, run.outputs.size());
+    EXPECT_EQ(expected.str(), run.outputs.front());
+  }
+}
+
+/**
+ * Test: every worker records into observers of its own, which merge into the metrics of the whole batch,
+ * with a split puzzle reported once
+ */
+TEST(MainBatchScheduler, Observers) {
+  constexpr unsigned Jobs = 3;
+  std::vector<TimingPhaseObserver> timing(Jobs, TimingPhaseObserver(3));
+  std::vector<PrometheusPhaseObserver> prometheus(Jobs);
+  std::vector<PhaseObserverList> lists(Jobs);
+  std::vector<PhaseObserver*> workers;
+  for (unsigned worker = 0; worker < Jobs; worker++) {
+    lists[worker].add(&timing[worker]);
+    lists[worker].add(&prometheus[worker]);
+    workers.push_back(&lists[worker]);
+  }
+
+  std::istringstream input(Batch);
+  std::ostringstream output;
+  EXPECT_FALSE(processScheduledBatch(input, output, Jobs, Schedule::LongestFirst, {}, workers));
+
+  TimingPhaseObserver merged_timing(3);
+  PrometheusPhaseObserver merged_prometheus;
+  for (unsigned worker = 0; worker < Jobs; worker++) {
+    merged_timing.merge(timing[worker]);
+    merged_prometheus.merge(prometheus[worker]);
+  }
+  merged_prometheus.setWorkers(Jobs);
+
+  EXPECT_EQ(1, merged_prometheus.getPuzzles(sudoku::SudokuSize::Four, Outcome::Solved));
+  EXPECT_EQ(1, merged_prometheus.getPuzzles(sudoku::SudokuSize::Four, Outcome::Unsolvable));
+  EXPECT_EQ(1, merged_prometheus.getPuzzles(sudoku::SudokuSize::Nine, Outcome::Solved));
+  EXPECT_EQ(1, merged_prometheus.getNodesHistogram(sudoku::SudokuSize::Nine).getCount());
+
+  std::ostringstream metrics;
+  merged_prometheus.writeMetrics(metrics);
+  EXPECT_NE(std::string::npos, metrics.str().find("sudoku_workers 3\n"));
+
+  // every Sudoku is identified by its first input line, also the split one
+  EXPECT_EQ(3, merged_timing.getTotalHistogram().getCount());
+  std::vector<int> lines;
+  for (auto [latency, line] : merged_timing.getSlowest()) {
+    lines.push_back(line);
+  }
+  std::sort(lines.begin(), lines.end());
+  EXPECT_EQ(std::vector<int>({1, 6, 11}), lines);
+}
+
+/**
+ * Test: the simulated makespan follows the order of the tasks
+ */
+TEST(MainBatchScheduler, SimulateMakespan) {
+  using std::chrono::nanoseconds;
+
+  // the longest task last finishes late, but first it overlaps the others
+  const std::vector<nanoseconds> fifo = {nanoseconds(1), nanoseconds(1), nanoseconds(1), nanoseconds(1),
+                                         nanoseconds(4)};
+  const std::vector<nanoseconds> longest = {nanoseconds(4), nanoseconds(1), nanoseconds(1), nanoseconds(1),
+                                            nanoseconds(1)};
+  EXPECT_EQ(nanoseconds(6), simulateMakespan(fifo, 2));
+  EXPECT_EQ(nanoseconds(4), simulateMakespan(longest, 2));
+  EXPECT_EQ(nanoseconds(8), simulateMakespan(longest, 1));
+  EXPECT_EQ(nanoseconds(0), simulateMakespan({}, 2));
+}
+
+/**
+ * Test: schedules are parsed by name
+ */
+TEST(MainBatchScheduler, ParseSchedule) {
+  for (auto schedule : {Schedule::Fifo, Schedule::LongestFirst}) {
+    EXPECT_EQ(schedule, parseSchedule(scheduleName(schedule)));
+  }
+  EXPECT_EQ(Schedule::LongestFirst, parseSchedule("longest"));
+  EXPECT_FALSE(parseSchedule("shortest").has_value());
+}
+
+}  // namespace
+}  // namespace app
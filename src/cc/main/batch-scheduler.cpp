@@ -0,0 +1,377 @@
+#include "batch-scheduler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <thread>
+
+#include "corpus-reader.hpp"
+#include "src/cc/libdlx/work-unit.hpp"
+#include "src/cc/libsudoku/difficulty.hpp"
+#include "src/cc/libsudoku/solver.hpp"
+#include "src/cc/libsudoku/sudoku-matrix.hpp"
+
+namespace app {
+
+namespace {
+/**
+ * A puzzle whose search is split into work units, each searched by a task of its own
+ */
+struct SplitSudoku {
+  // The size of the puzzle
+  sudoku::SudokuSize size = sudoku::SudokuSize::Nine;
+
+  // The arena of the base solver
+  std::pmr::monotonic_buffer_resource arena;
+
+  // The solver over the residual matrix before the search, replicated by every unit
+  std::unique_ptr<sudoku::Solver> base;
+
+  // The units of the split, and the result of each, or std::nullopt if it was skipped
+  std::vector<dlx::WorkUnit> units;
+  std::vector<std::optional<dlx::WorkResult>> results;
+
+  // The lowest unit having a solution so far, and the number of units not finished yet
+  std::atomic<std::uint32_t> first_found = std::numeric_limits<std::uint32_t>::max();
+  std::atomic<std::size_t> remaining = 0;
+
+  // The time the first of its units started, and the wall-clock time spent on its units so far
+  std::once_flag started;
+  std::chrono::steady_clock::time_point start_time;
+  std::atomic<std::chrono::nanoseconds::rep> busy = 0;
+};
+
+/**
+ * A task of a batch: a whole puzzle, or a work unit of a split puzzle
+ */
+struct Task {
+  // The index of the puzzle in the batch
+  std::size_t puzzle = 0;
+
+  // The split puzzle and the index of its unit, or nullptr for a whole puzzle
+  SplitSudoku* split = nullptr;
+  std::size_t unit = 0;
+
+  // The estimated cost of the task, in search nodes
+  double cost = 0;
+};
+
+/**
+ * Helper method to get the CPU time consumed by the calling thread so far
+ */
+auto threadCpuTime() -> std::chrono::nanoseconds {
+  timespec time{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+/**
+ * Helper method to estimate the cost of solving the puzzle with the given input text.
+ * Malformed or conflicting puzzles fail at once, so they cost nothing.
+ */
+auto estimateCost(const std::string& text) -> double {
+  std::istringstream input(text);
+  auto puzzle = parseInput(input);
+  if (!puzzle.has_value()) {
+    return 0;
+  }
+
+  auto difficulty = sudoku::estimateDifficulty(puzzle.value());
+  return difficulty.has_value() ? difficulty.value().cost() : 0;
+}
+
+/**
+ * Helper method to split the search of the puzzle with the given input text into at least
+ * the given number of work units, at the shallowest depth having that many.
+ * The search options apply to the units as they would to the whole search, see \link solvePuzzle() .
+ *
+ * \return the split, or nullptr if the puzzle cannot be solved, is not searched via dancing links,
+ *         or has fewer than two units.
+ */
+auto prepareSplit(const std::string& text, std::size_t min_units, const SearchOptions& search)
+    -> std::unique_ptr<SplitSudoku> {
+  std::istringstream input(text);
+  auto puzzle = parseInput(input);
+  if (!puzzle.has_value()) {
+    return nullptr;
+  }
+
+  // the other engines search the puzzle as a whole
+  const auto size = puzzle.value().getSudokuSize();
+  if (search.dancing_cells || (search.bitset && size != sudoku::SudokuSize::Sixteen)) {
+    return nullptr;
+  }
+
+  auto split = std::make_unique<SplitSudoku>();
+  auto matrix = sudoku::SudokuMatrix::fromPuzzle(puzzle.value(), &split->arena);
+  if (!matrix.has_value()) {
+    return nullptr;
+  }
+
+  split->size = size;
+  split->base = std::make_unique<sudoku::Solver>(std::move(matrix.value()));
+  if (search.reduce) {
+    split->base->reduce();
+  }
+  if (search.generic_rows) {
+    split->base->useGenericRows();
+  }
+  for (std::size_t depth = 1; depth <= MaxScheduleSplitDepth && split->units.size() < min_units; depth++) {
+    split->units = split->base->split(depth);
+  }
+  if (split->units.size() < 2) {
+    return nullptr;
+  }
+
+  split->results.resize(split->units.size());
+  split->remaining = split->units.size();
+  return split;
+}
+
+/**
+ * Helper method to search the given unit of a split puzzle, unless a lower unit already has a solution.
+ *
+ * \return if this was the last unit of the puzzle to finish.
+ */
+auto searchUnit(SplitSudoku& split, std::size_t index) -> bool {
+  const auto unit_start = std::chrono::steady_clock::now();
+  std::call_once(split.started, [&split, unit_start]() { split.start_time = unit_start; });
+
+  const auto& unit = split.units[index];
+  if (unit.id < split.first_found.load()) {
+    std::pmr::monotonic_buffer_resource arena;
+    auto replica = split.base->clone(&arena);
+
+    // a unit is of no use once a lower unit has a solution, so its search is cancelled then
+    replica->setCancelPredicate(UnitCancelInterval, [&split, &unit]() { return unit.id > split.first_found.load(); });
+    auto result = replica->solveUnit(unit, false);
+
+    if (result.has_value() && result->solutions > 0) {
+      auto found = split.first_found.load();
+      while (unit.id < found && !split.first_found.compare_exchange_weak(found, unit.id)) {
+      }
+    }
+    split.results[index] = std::move(result);
+  }
+
+  split.busy.fetch_add((std::chrono::steady_clock::now() - unit_start).count());
+  return split.remaining.fetch_sub(1) == 1;
+}
+
+/**
+ * Helper method to write the solution of a split puzzle, once all of its units finished:
+ * the first solution of the lowest unit having one, as in \link mergeSudoku() .
+ *
+ * \return if the puzzle has a solution.
+ */
+auto finishSplit(SplitSudoku& split, std::ostream& output) -> bool {
+  const auto first = split.first_found.load();
+  std::pmr::monotonic_buffer_resource arena;
+  auto replica = split.base->clone(&arena);
+
+  // covering the rows of the first solution leaves nothing to search but that solution
+  std::array<std::uint8_t, sudoku::MaxCells> digits{};
+  if (first >= split.results.size() || !replica->coverRows(split.results[first]->first) || !replica->next() ||
+      !replica->getSolution(digits)) {
+    output << "No valid Sudoku solution found" << '\n';
+    return false;
+  }
+
+  writeSolution(output, split.size, digits);
+  return true;
+}
+
+/**
+ * Helper method to report a split puzzle to an observer, once all of its units finished.
+ */
+auto reportSplit(const SplitSudoku& split, int line, bool solved) -> SplitReport {
+  SplitReport report;
+  report.line = line;
+  report.size = split.size;
+  report.solved = solved;
+  report.latency = std::chrono::steady_clock::now() - split.start_time;
+  report.busy = std::chrono::nanoseconds(split.busy.load());
+  for (const auto& result : split.results) {
+    report.nodes += result.has_value() ? result->nodes : 0;
+  }
+  return report;
+}
+}  // namespace
+
+void forEachParallel(std::size_t count, unsigned jobs, const std::function<void(std::size_t, unsigned)>& function) {
+  std::atomic<std::size_t> next_index(0);
+  auto work = [&](unsigned worker) {
+    for (auto index = next_index.fetch_add(1); index < count; index = next_index.fetch_add(1)) {
+      function(index, worker);
+    }
+  };
+
+  std::vector<std::jthread> workers;
+  for (unsigned thread = 1; thread < std::min<std::size_t>(jobs, count); thread++) {
+    workers.emplace_back(work, thread);
+  }
+  work(0);
+}
+
+auto scheduleName(Schedule schedule) -> const char* {
+  switch (schedule) {
+    case Schedule::Fifo:
+      return "fifo";
+    case Schedule::LongestFirst:
+      return "longest";
+  }
+  return "unknown";
+}
+
+auto parseSchedule(const std::string& name) -> std::optional<Schedule> {
+  for (auto schedule : {Schedule::Fifo, Schedule::LongestFirst}) {
+    if (name == scheduleName(schedule)) {
+      return schedule;
+    }
+  }
+  return std::nullopt;
+}
+
+auto runBatch(const std::vector<std::string>& corpus, unsigned jobs, Schedule schedule, const SearchOptions& search,
+              std::span<PhaseObserver* const> observers, std::span<const int> lines) -> BatchRun {
+  jobs = std::max(jobs, 1U);
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<Task> tasks(corpus.size());
+  for (std::size_t index = 0; index < corpus.size(); index++) {
+    tasks[index].puzzle = index;
+  }
+
+  BatchRun run;
+  std::vector<std::unique_ptr<SplitSudoku>> splits;
+  if (schedule == Schedule::LongestFirst) {
+    std::vector<std::chrono::nanoseconds> estimate_times(tasks.size());
+    forEachParallel(tasks.size(), jobs, [&](std::size_t index, unsigned /*worker*/) {
+      const auto estimate_start = threadCpuTime();
+      tasks[index].cost = estimateCost(corpus[index]);
+      estimate_times[index] = threadCpuTime() - estimate_start;
+    });
+    const auto split_start = threadCpuTime();
+
+    // a puzzle costing more than the whole batch per worker finishes last, however the rest is scheduled,
+    // unless its units are spread across the workers; a randomized search cannot be split, see prepareSplit()
+    // for the other search options
+    double total = 0;
+    for (const auto& task : tasks) {
+      total += task.cost;
+    }
+
+    std::vector<Task> scheduled;
+    for (const auto& task : tasks) {
+      auto split = jobs > 1 && !search.seed.has_value() && task.cost > total / (jobs * SplitCostShare)
+                       ? prepareSplit(corpus[task.puzzle], SplitUnitsPerJob * jobs, search)
+                       : nullptr;
+      if (split == nullptr) {
+        scheduled.push_back(task);
+        continue;
+      }
+
+      for (std::size_t unit = 0; unit < split->units.size(); unit++) {
+        Task unit_task;
+        unit_task.puzzle = task.puzzle;
+        unit_task.split = split.get();
+        unit_task.unit = unit;
+        unit_task.cost = task.cost / static_cast<double>(split->units.size());
+        scheduled.push_back(unit_task);
+      }
+      splits.push_back(std::move(split));
+    }
+
+    // the units of a split keep their search order, so that a solution in an early unit skips the later ones
+    tasks = std::move(scheduled);
+    std::stable_sort(tasks.begin(), tasks.end(), [](const Task& left, const Task& right) {
+      return left.cost > right.cost;
+    });
+    run.planning = simulateMakespan(estimate_times, jobs) + (threadCpuTime() - split_start);
+  }
+
+  run.outputs.resize(corpus.size());
+  run.cpu_times.resize(tasks.size());
+  run.split_puzzles = splits.size();
+  std::vector<char> solved(corpus.size(), 0);
+
+  forEachParallel(tasks.size(), jobs, [&](std::size_t index, unsigned worker) {
+    const auto& task = tasks[index];
+    const auto task_start = threadCpuTime();
+    auto* observer = worker < observers.size() ? observers[worker] : nullptr;
+    const int line = task.puzzle < lines.size() ? lines[task.puzzle] : static_cast<int>(task.puzzle + 1);
+
+    if (task.split == nullptr) {
+      if (observer != nullptr) {
+        observer->puzzleStarted(line);
+      }
+
+      std::istringstream input(corpus[task.puzzle]);
+      std::ostringstream output;
+      solved[task.puzzle] = processSudoku(input, output, observer, search) ? 1 : 0;
+      run.outputs[task.puzzle] = output.str();
+
+      if (observer != nullptr) {
+        observer->puzzleFinished(solved[task.puzzle] != 0);
+      }
+    } else if (searchUnit(*task.split, task.unit)) {
+      std::ostringstream output;
+      solved[task.puzzle] = finishSplit(*task.split, output) ? 1 : 0;
+      run.outputs[task.puzzle] = output.str();
+
+      if (observer != nullptr) {
+        observer->splitFinished(reportSplit(*task.split, line, solved[task.puzzle] != 0));
+      }
+    }
+
+    run.cpu_times[index] = threadCpuTime() - task_start;
+  });
+
+  run.makespan = std::chrono::steady_clock::now() - start;
+  run.all_solved = std::all_of(solved.begin(), solved.end(), [](char value) { return value != 0; });
+  return run;
+}
+
+auto simulateMakespan(std::span<const std::chrono::nanoseconds> cpu_times, unsigned jobs) -> std::chrono::nanoseconds {
+  // the time at which each worker is idle next, earliest first
+  std::priority_queue<std::chrono::nanoseconds, std::vector<std::chrono::nanoseconds>, std::greater<>> idle;
+  for (unsigned worker = 0; worker < std::max(jobs, 1U); worker++) {
+    idle.emplace(0);
+  }
+
+  std::chrono::nanoseconds makespan(0);
+  for (auto cpu_time : cpu_times) {
+    const auto finish = idle.top() + cpu_time;
+    idle.pop();
+    idle.push(finish);
+    makespan = std::max(makespan, finish);
+  }
+  return makespan;
+}
+
+auto processScheduledBatch(std::istream& input, std::ostream& output, unsigned jobs, Schedule schedule,
+                           const SearchOptions& search, std::span<PhaseObserver* const> observers) -> bool {
+  std::vector<std::string> corpus;
+  std::vector<int> lines;
+  CorpusReader reader(input);
+  for (std::string puzzle; reader.next(puzzle);) {
+    corpus.push_back(puzzle);
+    lines.push_back(reader.getLine());
+  }
+
+  auto run = runBatch(corpus, jobs, schedule, search, observers, lines);
+  for (const auto& solution : run.outputs) {
+    output << solution << '\n';
+  }
+  return run.all_solved;
+}
+
+}  // namespace app
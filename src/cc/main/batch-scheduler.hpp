@@ -0,0 +1,150 @@
+#ifndef APP_BATCH_SCHEDULER_HPP_
+#define APP_BATCH_SCHEDULER_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "sudoku-processor.hpp"
+
+namespace app {
+
+/**
+ * A puzzle is split into work units if its estimated cost exceeds the whole batch per worker, divided
+ * by this share. Estimates of hard puzzles are often several times too low, so the threshold is lower
+ * than the cost at which the puzzle would certainly finish last.
+ */
+constexpr double SplitCostShare = 2;
+
+/**
+ * Number of work units per worker a very expensive puzzle is split into at least, if its search tree
+ * has that many nodes above MaxScheduleSplitDepth, see dlx::Solver::split()
+ */
+constexpr std::size_t SplitUnitsPerJob = 4;
+
+/**
+ * Deepest search level at which a very expensive puzzle is split into work units
+ */
+constexpr std::size_t MaxScheduleSplitDepth = 64;
+
+/**
+ * Number of search nodes between checks whether a work unit of a split puzzle is still needed
+ */
+constexpr std::uint64_t UnitCancelInterval = 4096;
+
+/**
+ * The order in which a parallel batch dispatches its puzzles to the workers, see \link runBatch() .
+ */
+enum class Schedule : std::uint8_t {
+  // In input order
+  Fifo,
+
+  // The most expensive first, by their estimated difficulty (see sudoku::estimateDifficulty() ),
+  // with every puzzle that would outlast the rest of the batch split into work units
+  LongestFirst
+};
+
+/**
+ * Returns the command-line name of the given schedule, see \link parseSchedule() .
+ */
+auto scheduleName(Schedule schedule) -> const char*;
+
+/**
+ * Parses the command-line name of a schedule: "fifo" or "longest".
+ *
+ * \return the schedule, or std::nullopt if the name is not recognized.
+ */
+auto parseSchedule(const std::string& name) -> std::optional<Schedule>;
+
+/**
+ * The outcome of solving a batch on several workers, see \link runBatch() .
+ */
+struct BatchRun {
+  // The output of every puzzle, in input order, as written by \link processSudoku()
+  std::vector<std::string> outputs;
+
+  // Whether a solution was found for every puzzle
+  bool all_solved = true;
+
+  // The wall-clock time from the start of scheduling until the last task finished,
+  // including the time spent estimating and splitting
+  std::chrono::nanoseconds makespan{0};
+
+  // The CPU time of every task, in dispatch order, which unlike its latency does not depend on
+  // the number of tasks sharing a core. A task solves a whole puzzle, or a work unit of a split
+  // puzzle; units skipped because an earlier unit had a solution take next to no time.
+  std::vector<std::chrono::nanoseconds> cpu_times;
+
+  // The makespan of estimating and splitting before dispatching the tasks, on jobs dedicated cores,
+  // from the CPU time of each estimate and split, see \link simulateMakespan()
+  std::chrono::nanoseconds planning{0};
+
+  // The number of puzzles split into work units
+  std::size_t split_puzzles = 0;
+};
+
+/**
+ * Solves a batch of puzzles on the given number of worker threads.
+ *
+ * Workers take the next task from a shared list as soon as they are idle, so a batch finishes
+ * late if an expensive puzzle is taken last. With \link Schedule::LongestFirst , the cost of each
+ * puzzle is estimated first, in parallel, and the puzzles are dispatched most expensive first.
+ * A puzzle estimated to cost more than a share of the whole batch per worker (see SplitCostShare)
+ * is split into the work units of its search tree (see dlx::Solver::split() ), which are dispatched as tasks of their own.
+ * As the top levels of a Sudoku search are mostly forced, the split depth is raised one level
+ * at a time, until there are SplitUnitsPerJob units per worker.
+ * Once a unit finds a solution, later units of the same puzzle are skipped or stop within
+ * UnitCancelInterval search nodes, and the solution of the lowest unit having one is reported:
+ * the same first solution as a search of the whole tree.
+ * Only a search via dancing links can be split, so with a randomized search, and for puzzles searched
+ * via dancing cells or bitsets, no puzzle is split. Split puzzles are reduced and searched via the
+ * generic rows as requested by the search options; all other puzzles are solved via
+ * \link processSudoku() with the given search options.
+ *
+ * Each worker notifies an observer of its own, so that observers need not be thread-safe; their
+ * recordings are to be merged once the batch finished. A split puzzle is reported once, by the worker
+ * finishing its last unit, see \link PhaseObserver::splitFinished() .
+ *
+ * \param corpus The input text of every puzzle, see \link readCorpus() .
+ * \param jobs The number of worker threads, at least 1.
+ * \param observers The observer of each worker, one per job, or empty to not observe the batch.
+ * \param lines The input line every puzzle starts at, reported to the observers; by default its
+ *              position in the corpus.
+ */
+auto runBatch(const std::vector<std::string>& corpus, unsigned jobs, Schedule schedule, const SearchOptions& search = {},
+              std::span<PhaseObserver* const> observers = {}, std::span<const int> lines = {}) -> BatchRun;
+
+/**
+ * Calls function for every index below count, on the given number of threads (the calling thread
+ * being one of them), each taking the next index as soon as it is idle. Returns once all calls returned.
+ * Each call is passed the index, and the worker making it: 0 for the calling thread, up to jobs - 1.
+ */
+void forEachParallel(std::size_t count, unsigned jobs, const std::function<void(std::size_t, unsigned)>& function);
+
+/**
+ * Returns the makespan of running tasks of the given CPU times in the given order, on the given
+ * number of workers each taking the next task as soon as it is idle: i.e., the makespan of
+ * \link runBatch() on jobs dedicated cores, without the overhead of scheduling.
+ */
+auto simulateMakespan(std::span<const std::chrono::nanoseconds> cpu_times, unsigned jobs) -> std::chrono::nanoseconds;
+
+/**
+ * Reads in a batch of partial Sudokus from input and writes their solutions to output, solving
+ * them on several workers via \link runBatch() . The input and output are in the format of
+ * \link processBatch() , but the whole batch is read before solving it.
+ *
+ * \param observers The observer of each worker, one per job, or empty to not observe the batch.
+ * \return if a solution was found for every Sudoku in the batch.
+ */
+auto processScheduledBatch(std::istream& input, std::ostream& output, unsigned jobs, Schedule schedule,
+                           const SearchOptions& search = {}, std::span<PhaseObserver* const> observers = {}) -> bool;
+
+}  // namespace app
+
+#endif  // APP_BATCH_SCHEDULER_HPP_
@@ -0,0 +1,57 @@
+#include "benchmark.hpp"
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace app {
+
+namespace {
+
+/**
+ * Test: a corpus is split on empty lines
+ */
+TEST(MainBenchmark, ReadCorpus) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+  
+4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ _
+)");
+
+  auto corpus = readCorpus(input);
+
+  EXPECT_EQ(2, corpus.size());
+  EXPECT_EQ("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n", corpus[0]);
+  EXPECT_EQ("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ _\n", corpus[1]);
+}
+
+/**
+ * Test: every puzzle yields a benchmark record with its solution
+ */
+TEST(MainBenchmark, Records) {
+  std::vector<std::string> corpus = {"4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n"};
+  std::ostringstream output;
+
+  bool result = runBenchmark(corpus, 1, output);
+
+  EXPECT_TRUE(result);
+
+  std::istringstream records(output.str());
+  std::string record;
+
+  std::getline(records, record);
+  EXPECT_EQ(0, record.find("puzzle,1,4,"));
+  EXPECT_EQ("4321213434121243", record.substr(record.rfind(',') + 1));
+
+  std::getline(records, record);
+  EXPECT_EQ(0, record.find("summary,1,"));
+}
+
+}  // namespace
+}  // namespace app
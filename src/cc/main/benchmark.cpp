@@ -0,0 +1,127 @@
+#include "benchmark.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include "batch-scheduler.hpp"
+#include "corpus-reader.hpp"
+#include "perf-phase-observer.hpp"
+
+namespace app {
+
+/**
+ * Helper method to get the peak resident set size of this process in kilobytes
+ */
+auto peakRssKb() -> long {
+  struct rusage usage {};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+
+  // On Linux, ru_maxrss is reported in kilobytes
+  return usage.ru_maxrss;
+}
+
+/**
+ * Helper method to remove all whitespace from a string
+ */
+auto stripWhitespace(std::string str) -> std::string {
+  str.erase(std::remove_if(str.begin(), str.end(), isspace), str.end());
+  return str;
+}
+
+auto readCorpus(std::istream& input) -> std::vector<std::string> {
+  std::vector<std::string> corpus;
+  CorpusReader reader(input);
+
+  std::string puzzle;
+  while (reader.next(puzzle)) {
+    corpus.push_back(puzzle);
+  }
+
+  return corpus;
+}
+
+auto runBenchmark(const std::vector<std::string>& corpus, int warmup_rounds, std::ostream& output,
+                  PhaseObserver* observer, const SearchOptions& search) -> bool {
+  // Warm-up rounds, results are discarded
+  for (int round = 0; round < warmup_rounds; round++) {
+    for (const auto& puzzle : corpus) {
+      std::istringstream input(puzzle);
+      std::ostringstream solution;
+      processSudoku(input, solution, nullptr, search);
+    }
+  }
+
+  // Timed round
+  bool all_solved = true;
+  std::chrono::nanoseconds total(0);
+
+  for (std::size_t index = 0; index < corpus.size(); index++) {
+    std::istringstream input(corpus[index]);
+    std::ostringstream solution;
+
+    auto start = std::chrono::steady_clock::now();
+    bool solved = processSudoku(input, solution, observer, search);
+    auto latency = std::chrono::steady_clock::now() - start;
+    total += latency;
+
+    // the first line of a puzzle determines the sudoku size
+    std::string first_line = corpus[index].substr(0, corpus[index].find('\n'));
+
+    output << "puzzle," << (index + 1) << ','
+           << stripWhitespace(first_line).length() << ','
+           << std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count() << ','
+           << (solved ? stripWhitespace(solution.str()) : "none") << '\n';
+
+    all_solved = all_solved && solved;
+  }
+
+  output << "summary," << corpus.size() << ',' << total.count() << ',' << peakRssKb() << '\n';
+
+  return all_solved;
+}
+
+auto runScheduleBenchmark(const std::vector<std::string>& corpus, unsigned jobs, std::ostream& output,
+                          const SearchOptions& search) -> bool {
+  bool all_solved = true;
+  for (auto schedule : {Schedule::Fifo, Schedule::LongestFirst}) {
+    auto run = runBatch(corpus, jobs, schedule, search);
+    output << "makespan," << scheduleName(schedule) << ',' << jobs << ',' << run.makespan.count() << ','
+           << (run.planning + simulateMakespan(run.cpu_times, jobs)).count() << ',' << run.cpu_times.size() << ','
+           << run.split_puzzles << '\n';
+    all_solved = all_solved && run.all_solved;
+  }
+  return all_solved;
+}
+
+auto benchmarkMain(const Options& options, std::ostream& output) -> bool {
+  std::ifstream input(options.benchmark_corpus);
+  if (!input) {
+    output << "Error: Cannot read corpus: " << options.benchmark_corpus << '\n';
+    return false;
+  }
+
+  auto corpus = readCorpus(input);
+
+  bool result = false;
+  if (options.perf_counters) {
+    PerfPhaseObserver observer;
+    result = runBenchmark(corpus, options.warmup_rounds, output, &observer, options.search);
+    observer.writeRecords(output);
+  } else {
+    result = runBenchmark(corpus, options.warmup_rounds, output, nullptr, options.search);
+  }
+
+  if (options.jobs > 1) {
+    result = runScheduleBenchmark(corpus, options.jobs, output, options.search) && result;
+  }
+  return result;
+}
+
+}  // namespace app
@@ -0,0 +1,71 @@
+#ifndef APP_BENCHMARK_HPP_
+#define APP_BENCHMARK_HPP_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "options.hpp"
+#include "sudoku-processor.hpp"
+
+namespace app {
+
+/**
+ * Splits a corpus of Sudoku puzzles into the input text of each puzzle.
+ *
+ * A corpus lists puzzles in the input format of \link processSudoku() ,
+ * separated by one or more empty lines.
+ */
+auto readCorpus(std::istream& input) -> std::vector<std::string>;
+
+/**
+ * Solves every puzzle in the corpus and writes a benchmark record per puzzle to output.
+ *
+ * The corpus is first solved warmup_rounds times without recording, so that the timed
+ * round is not skewed by cold caches (or, in the Java port, by JIT compilation).
+ * The record format is shared by the C++, Go and Java ports so that
+ * tools/bench can combine and compare their results:
+ *
+ *   puzzle,<index>,<size>,<latency_ns>,<solution>
+ *   summary,<puzzles>,<total_ns>,<peak_rss_kb>
+ *
+ * where solution is the solved grid with all whitespace removed, or "none" when
+ * the puzzle could not be solved.
+ *
+ * \param observer Optional observer notified of each processing phase in the timed round.
+ * \param search Options for the search for a solution, e.g. to compare a randomized search.
+ * \return if every puzzle in the corpus was solved.
+ */
+auto runBenchmark(const std::vector<std::string>& corpus, int warmup_rounds, std::ostream& output,
+                  PhaseObserver* observer = nullptr, const SearchOptions& search = {}) -> bool;
+
+/**
+ * Solves the corpus as a batch on the given number of workers once per \link Schedule ,
+ * and writes a makespan record per schedule to output:
+ *
+ *   makespan,<schedule>,<jobs>,<makespan_ns>,<simulated_ns>,<tasks>,<split_puzzles>
+ *
+ * where makespan_ns is the measured wall-clock time of \link runBatch() , and simulated_ns the
+ * makespan of the CPU times of its planning and its tasks in dispatch order on jobs dedicated
+ * cores, see \link simulateMakespan() .
+ * The latter tells the schedules apart even on a machine with fewer cores than workers.
+ *
+ * \return if every puzzle in the corpus was solved under every schedule.
+ */
+auto runScheduleBenchmark(const std::vector<std::string>& corpus, unsigned jobs, std::ostream& output,
+                          const SearchOptions& search = {}) -> bool;
+
+/**
+ * Command-line entry for the benchmark mode, see \link Options .
+ *
+ * With perf_counters enabled, the records are followed by the hardware performance
+ * counters of the timed round, see \link PerfPhaseObserver::writeRecords() .
+ * With more than one job, they are followed by the makespan records, see \link runScheduleBenchmark() .
+ *
+ * \return if the corpus could be read and every puzzle in the corpus was solved.
+ */
+auto benchmarkMain(const Options& options, std::ostream& output) -> bool;
+
+}  // namespace app
+
+#endif  // APP_BENCHMARK_HPP_
@@ -0,0 +1,41 @@
+#include "corpus-reader.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace app {
+
+CorpusReader::CorpusReader(std::istream& input)
+    : input(input), lines_read(0), puzzle_line(0) {}
+
+auto CorpusReader::next(std::string& puzzle) -> bool {
+  std::string line;
+  puzzle.clear();
+
+  while (std::getline(this->input, line)) {
+    this->lines_read++;
+
+    if (std::all_of(line.begin(), line.end(), isspace)) {
+      // an empty line ends the current puzzle, if any
+      if (!puzzle.empty()) {
+        return true;
+      }
+      continue;
+    }
+
+    if (puzzle.empty()) {
+      this->puzzle_line = this->lines_read;
+    }
+
+    puzzle += line;
+    puzzle += '\n';
+  }
+
+  return !puzzle.empty();
+}
+
+auto CorpusReader::getLine() const -> int {
+  return this->puzzle_line;
+}
+
+}  // namespace app
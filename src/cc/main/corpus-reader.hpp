@@ -0,0 +1,48 @@
+#ifndef APP_CORPUS_READER_HPP_
+#define APP_CORPUS_READER_HPP_
+
+#include <iostream>
+#include <string>
+
+namespace app {
+
+/**
+ * The CorpusReader reads a corpus of Sudoku puzzles from a stream, one puzzle at a time.
+ *
+ * A corpus lists puzzles in the input format of \link processSudoku() ,
+ * separated by one or more empty lines. Puzzles are read lazily, so that
+ * arbitrarily large batches can be processed in constant memory.
+ */
+class CorpusReader {
+ public:
+  /**
+   * Constructs a new reader on the given stream. The stream must outlive this reader.
+   */
+  explicit CorpusReader(std::istream& input);
+
+  /**
+   * Reads the input text of the next puzzle.
+   *
+   * \return if a puzzle was read, or false at the end of the stream.
+   */
+  auto next(std::string& puzzle) -> bool;
+
+  /**
+   * Returns the input line number (1-based) at which the last read puzzle started.
+   */
+  [[nodiscard]] auto getLine() const -> int;
+
+ private:
+  // The stream to read from
+  std::istream& input;
+
+  // Number of lines read so far
+  int lines_read;
+
+  // Line number at which the last read puzzle started
+  int puzzle_line;
+};
+
+}  // namespace app
+
+#endif  // APP_CORPUS_READER_HPP_
@@ -1,10 +1,141 @@
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
 
+#include "batch-scheduler.hpp"
+#include "benchmark.hpp"
+#include "options.hpp"
+#include "perf-phase-observer.hpp"
+#include "prometheus-phase-observer.hpp"
+#include "puzzle-archive.hpp"
+#include "shard.hpp"
 #include "sudoku-processor.hpp"
+#include "timing-phase-observer.hpp"
+#include "trace-phase-observer.hpp"
 
-auto main() -> int {
-  if (!app::processSudoku(std::cin, std::cout)) {
+auto main(int argc, char* argv[]) -> int {
+  app::Options options;
+  if (!app::parseOptions(std::vector<std::string>(argv + 1, argv + argc), options, std::cerr)) {
     return 1;
   }
 
-  return 0;
+  // Benchmark mode: solve a corpus of puzzles and report per-puzzle latencies
+  if (!options.benchmark_corpus.empty()) {
+    return app::benchmarkMain(options, std::cout) ? 0 : 1;
+  }
+
+  // Sharded search: split a puzzle into work units, search one unit, or merge the results,
+  // or count all solutions of a puzzle in a resumable search
+  if (!options.split_directory.empty() || !options.work_unit.empty() || !options.merge_directory.empty() ||
+      options.count) {
+    return app::shardMain(options, std::cin, std::cout) ? 0 : 1;
+  }
+
+  // Archive conversion: pack a batch read from stdin into a binary archive, or unpack one to stdout
+  if (!options.pack_archive.empty() || !options.unpack_archive.empty()) {
+    return app::archiveMain(options, std::cin, std::cout, {}) ? 0 : 1;
+  }
+
+  // Optional instrumentation, reported on stderr to keep stdout for the solutions
+  app::PhaseObserverList observers;
+  app::TimingPhaseObserver timing(options.top_slowest);
+  app::PerfPhaseObserver perf;
+  app::PrometheusPhaseObserver prometheus(options.prometheus_file, std::chrono::seconds(options.prometheus_interval));
+
+  if (options.metrics) {
+    observers.add(&timing);
+  }
+  if (options.perf_counters) {
+    observers.add(&perf);
+  }
+  if (!options.prometheus_file.empty()) {
+    observers.add(&prometheus);
+  }
+
+  std::ofstream trace_file;
+  std::optional<app::TracePhaseObserver> trace;
+  if (!options.trace_file.empty()) {
+    trace_file.open(options.trace_file, std::ios::binary | std::ios::trunc);
+    if (!trace_file) {
+      std::cerr << "Error: Cannot write trace to " << options.trace_file << '\n';
+      return 1;
+    }
+    observers.add(&trace.emplace(trace_file));
+  }
+
+  app::PhaseObserver* observer = observers.empty() ? nullptr : &observers;
+  app::PuzzleProcessor process = app::solveWith(options.search);
+  if (options.validate) {
+    process = app::validateSudoku;
+  } else if (options.minimality) {
+    process = app::checkMinimalityWith(options.threads);
+  }
+  bool result = false;
+
+  const bool archive = !options.input_archive.empty() || !options.output_archive.empty();
+  const bool scheduled = options.batch && options.jobs > 1 && !options.validate && !options.minimality;
+  const unsigned jobs = archive || scheduled ? std::max(options.jobs, 1U) : 1;
+  if (jobs > 1 && (options.perf_counters || trace.has_value())) {
+    std::cerr << "Error: --perf-counters and --trace are not supported with --jobs" << '\n';
+    return 1;
+  }
+
+  // With several jobs, each worker records into observers of its own, merged once all finished,
+  // while the Prometheus metrics are also published periodically for the metrics file
+  std::vector<app::TimingPhaseObserver> worker_timing;
+  std::vector<app::PrometheusPhaseObserver> worker_prometheus;
+  std::vector<app::PhaseObserverList> worker_lists;
+  std::vector<app::PhaseObserver*> workers;
+  if (jobs == 1 && observer != nullptr) {
+    workers.push_back(observer);
+  } else if (observer != nullptr) {
+    worker_timing.assign(jobs, app::TimingPhaseObserver(options.top_slowest));
+    worker_prometheus = std::vector<app::PrometheusPhaseObserver>(jobs);
+    worker_lists.resize(jobs);
+    for (unsigned worker = 0; worker < jobs; worker++) {
+      if (options.metrics) {
+        worker_lists[worker].add(&worker_timing[worker]);
+      }
+      if (!options.prometheus_file.empty()) {
+        worker_prometheus[worker].publishTo(&prometheus);
+        worker_lists[worker].add(&worker_prometheus[worker]);
+      }
+      workers.push_back(&worker_lists[worker]);
+    }
+  }
+
+  prometheus.setWorkers(jobs);
+
+  if (archive) {
+    result = app::archiveMain(options, std::cin, std::cout, workers);
+  } else if (scheduled) {
+    result = app::processScheduledBatch(std::cin, std::cout, options.jobs, options.schedule, options.search, workers);
+  } else if (options.batch) {
+    result = app::processBatch(std::cin, std::cout, observer, process);
+  } else {
+    observers.puzzleStarted(1);
+    result = process(std::cin, std::cout, observer);
+    observers.puzzleFinished(result);
+  }
+
+  for (const auto& worker : worker_timing) {
+    timing.merge(worker);
+  }
+  for (const auto& worker : worker_prometheus) {
+    prometheus.merge(worker);
+  }
+
+  if (options.metrics) {
+    timing.writeReport(std::cerr);
+  }
+  if (options.perf_counters) {
+    perf.writeTable(std::cerr);
+  }
+  if (!options.prometheus_file.empty() && !prometheus.exportFile()) {
+    std::cerr << "Error: Cannot write metrics to " << options.prometheus_file << '\n';
+  }
+
+  return result ? 0 : 1;
 }
@@ -0,0 +1,188 @@
+#include "options.hpp"
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace app {
+
+namespace {
+
+/**
+ * Test: no arguments yields the default options
+ */
+TEST(MainOptions, Defaults) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_TRUE(parseOptions({}, options, error));
+  EXPECT_TRUE(options.benchmark_corpus.empty());
+  EXPECT_EQ(DefaultWarmupRounds, options.warmup_rounds);
+  EXPECT_FALSE(options.perf_counters);
+}
+
+/**
+ * Test: benchmark arguments are parsed
+ */
+TEST(MainOptions, Benchmark) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_TRUE(parseOptions({"--benchmark", "corpus.txt", "--warmup", "5", "--perf-counters"}, options, error));
+  EXPECT_EQ("corpus.txt", options.benchmark_corpus);
+  EXPECT_EQ(5, options.warmup_rounds);
+  EXPECT_TRUE(options.perf_counters);
+}
+
+/**
+ * Test: batch, validate and metrics arguments are parsed
+ */
+TEST(MainOptions, BatchMetrics) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_TRUE(parseOptions({"--batch", "--validate", "--metrics", "--top", "3"}, options, error));
+  EXPECT_TRUE(options.batch);
+  EXPECT_TRUE(options.validate);
+  EXPECT_TRUE(options.metrics);
+  EXPECT_EQ(3, options.top_slowest);
+}
+
+/**
+ * Test: minimality arguments are parsed
+ */
+TEST(MainOptions, Minimality) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_FALSE(options.minimality);
+  EXPECT_EQ(0, options.threads);
+  EXPECT_TRUE(parseOptions({"--minimality", "--threads", "4"}, options, error));
+  EXPECT_TRUE(options.minimality);
+  EXPECT_EQ(4, options.threads);
+}
+
+/**
+ * Test: prometheus and trace arguments are parsed
+ */
+TEST(MainOptions, PrometheusTrace) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_TRUE(options.prometheus_file.empty());
+  EXPECT_TRUE(parseOptions({"--batch", "--prometheus", "sudoku.prom", "--prometheus-interval", "30"}, options, error));
+  EXPECT_EQ("sudoku.prom", options.prometheus_file);
+  EXPECT_EQ(30, options.prometheus_interval);
+
+  EXPECT_TRUE(options.trace_file.empty());
+  EXPECT_TRUE(parseOptions({"--trace", "search.trace"}, options, error));
+  EXPECT_EQ("search.trace", options.trace_file);
+}
+
+/**
+ * Test: randomized search arguments are parsed
+ */
+TEST(MainOptions, Search) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_FALSE(options.search.seed.has_value());
+  EXPECT_TRUE(parseOptions({"--seed", "42", "--restart-unit", "100"}, options, error));
+  EXPECT_EQ(42, options.search.seed);
+  EXPECT_EQ(100, options.search.restart_unit);
+
+  EXPECT_FALSE(options.search.generic_rows);
+  EXPECT_TRUE(parseOptions({"--generic-rows"}, options, error));
+  EXPECT_TRUE(options.search.generic_rows);
+
+  EXPECT_FALSE(options.search.reduce);
+  EXPECT_TRUE(parseOptions({"--reduce"}, options, error));
+  EXPECT_TRUE(options.search.reduce);
+
+  EXPECT_FALSE(options.search.dancing_cells);
+  EXPECT_TRUE(parseOptions({"--dancing-cells"}, options, error));
+  EXPECT_TRUE(options.search.dancing_cells);
+
+  EXPECT_FALSE(options.search.bitset);
+  EXPECT_TRUE(parseOptions({"--bitset"}, options, error));
+  EXPECT_TRUE(options.search.bitset);
+}
+
+/**
+ * Test: sharded search arguments are parsed
+ */
+TEST(MainOptions, Shard) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_EQ(DefaultSplitDepth, options.split_depth);
+  EXPECT_TRUE(parseOptions({"--split", "units", "--split-depth", "3", "--work", "units/unit-0.unit", "--count",
+                            "--merge", "units"},
+                           options, error));
+  EXPECT_EQ("units", options.split_directory);
+  EXPECT_EQ(3, options.split_depth);
+  EXPECT_EQ("units/unit-0.unit", options.work_unit);
+  EXPECT_TRUE(options.count);
+  EXPECT_EQ("units", options.merge_directory);
+
+  EXPECT_EQ(DefaultCheckpointInterval, options.checkpoint_interval);
+  EXPECT_TRUE(parseOptions({"--checkpoint", "count.checkpoint", "--checkpoint-interval", "1000"}, options, error));
+  EXPECT_EQ("count.checkpoint", options.checkpoint_file);
+  EXPECT_EQ(1000, options.checkpoint_interval);
+
+  EXPECT_FALSE(options.memo);
+  EXPECT_EQ(DefaultMemoMegabytes, options.memo_megabytes);
+  EXPECT_TRUE(parseOptions({"--memo", "--memo-memory", "64"}, options, error));
+  EXPECT_TRUE(options.memo);
+  EXPECT_EQ(64, options.memo_megabytes);
+}
+
+/**
+ * Test: parallel batch arguments are parsed
+ */
+TEST(MainOptions, Jobs) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_EQ(1, options.jobs);
+  EXPECT_EQ(Schedule::LongestFirst, options.schedule);
+  EXPECT_TRUE(parseOptions({"--batch", "--jobs", "4", "--schedule", "fifo"}, options, error));
+  EXPECT_EQ(4, options.jobs);
+  EXPECT_EQ(Schedule::Fifo, options.schedule);
+
+  EXPECT_FALSE(parseOptions({"--schedule", "shortest"}, options, error));
+  EXPECT_EQ("Error: Unrecognized schedule: shortest\n", error.str());
+}
+
+/**
+ * Test: archive arguments are parsed
+ */
+TEST(MainOptions, Archive) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_TRUE(parseOptions({"--pack", "puzzles.sdk", "--solutions", "--unpack", "solutions.sdk"}, options, error));
+  EXPECT_EQ("puzzles.sdk", options.pack_archive);
+  EXPECT_TRUE(options.solutions);
+  EXPECT_EQ("solutions.sdk", options.unpack_archive);
+
+  EXPECT_TRUE(parseOptions({"--batch", "--input-archive", "in.sdk", "--output-archive", "out.sdk"}, options, error));
+  EXPECT_EQ("in.sdk", options.input_archive);
+  EXPECT_EQ("out.sdk", options.output_archive);
+}
+
+/**
+ * Test: unknown arguments and missing values are rejected
+ */
+TEST(MainOptions, Invalid) {
+  Options options;
+  std::ostringstream error;
+
+  EXPECT_FALSE(parseOptions({"--unknown"}, options, error));
+  EXPECT_EQ("Error: Unrecognized argument: --unknown\n", error.str());
+
+  EXPECT_FALSE(parseOptions({"--benchmark"}, options, error));
+}
+
+}  // namespace
+}  // namespace app
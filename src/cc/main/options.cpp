@@ -0,0 +1,99 @@
+#include "options.hpp"
+
+#include <cstdlib>
+
+namespace app {
+
+/**
+ * Base Ten
+ */
+const int BaseTen = 10;
+
+auto parseOptions(const std::vector<std::string>& args, Options& options, std::ostream& error) -> bool {
+  for (std::size_t i = 0; i < args.size(); i++) {
+    const std::string& arg = args[i];
+    const bool has_value = i + 1 < args.size();
+
+    if (arg == "--benchmark" && has_value) {
+      options.benchmark_corpus = args[++i];
+    } else if (arg == "--warmup" && has_value) {
+      options.warmup_rounds = static_cast<int>(strtol(args[++i].c_str(), nullptr, BaseTen));
+    } else if (arg == "--perf-counters") {
+      options.perf_counters = true;
+    } else if (arg == "--batch") {
+      options.batch = true;
+    } else if (arg == "--validate") {
+      options.validate = true;
+    } else if (arg == "--minimality") {
+      options.minimality = true;
+    } else if (arg == "--threads" && has_value) {
+      options.threads = static_cast<unsigned>(strtoul(args[++i].c_str(), nullptr, BaseTen));
+    } else if (arg == "--jobs" && has_value) {
+      options.jobs = static_cast<unsigned>(strtoul(args[++i].c_str(), nullptr, BaseTen));
+    } else if (arg == "--schedule" && has_value) {
+      auto schedule = parseSchedule(args[++i]);
+      if (!schedule.has_value()) {
+        error << "Error: Unrecognized schedule: " << args[i] << '\n';
+        return false;
+      }
+      options.schedule = schedule.value();
+    } else if (arg == "--metrics") {
+      options.metrics = true;
+    } else if (arg == "--top" && has_value) {
+      options.top_slowest = static_cast<int>(strtol(args[++i].c_str(), nullptr, BaseTen));
+    } else if (arg == "--prometheus" && has_value) {
+      options.prometheus_file = args[++i];
+    } else if (arg == "--prometheus-interval" && has_value) {
+      options.prometheus_interval = static_cast<int>(strtol(args[++i].c_str(), nullptr, BaseTen));
+    } else if (arg == "--trace" && has_value) {
+      options.trace_file = args[++i];
+    } else if (arg == "--seed" && has_value) {
+      options.search.seed = strtoull(args[++i].c_str(), nullptr, BaseTen);
+    } else if (arg == "--restart-unit" && has_value) {
+      options.search.restart_unit = strtoull(args[++i].c_str(), nullptr, BaseTen);
+    } else if (arg == "--generic-rows") {
+      options.search.generic_rows = true;
+    } else if (arg == "--reduce") {
+      options.search.reduce = true;
+    } else if (arg == "--dancing-cells") {
+      options.search.dancing_cells = true;
+    } else if (arg == "--bitset") {
+      options.search.bitset = true;
+    } else if (arg == "--split" && has_value) {
+      options.split_directory = args[++i];
+    } else if (arg == "--split-depth" && has_value) {
+      options.split_depth = strtoull(args[++i].c_str(), nullptr, BaseTen);
+    } else if (arg == "--work" && has_value) {
+      options.work_unit = args[++i];
+    } else if (arg == "--count") {
+      options.count = true;
+    } else if (arg == "--merge" && has_value) {
+      options.merge_directory = args[++i];
+    } else if (arg == "--checkpoint" && has_value) {
+      options.checkpoint_file = args[++i];
+    } else if (arg == "--checkpoint-interval" && has_value) {
+      options.checkpoint_interval = strtoull(args[++i].c_str(), nullptr, BaseTen);
+    } else if (arg == "--memo") {
+      options.memo = true;
+    } else if (arg == "--memo-memory" && has_value) {
+      options.memo_megabytes = strtoull(args[++i].c_str(), nullptr, BaseTen);
+    } else if (arg == "--pack" && has_value) {
+      options.pack_archive = args[++i];
+    } else if (arg == "--solutions") {
+      options.solutions = true;
+    } else if (arg == "--unpack" && has_value) {
+      options.unpack_archive = args[++i];
+    } else if (arg == "--input-archive" && has_value) {
+      options.input_archive = args[++i];
+    } else if (arg == "--output-archive" && has_value) {
+      options.output_archive = args[++i];
+    } else {
+      error << "Error: Unrecognized argument: " << arg << '\n';
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace app
@@ -0,0 +1,201 @@
+#ifndef APP_OPTIONS_HPP_
+#define APP_OPTIONS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "batch-scheduler.hpp"
+#include "sudoku-processor.hpp"
+
+namespace app {
+
+/**
+ * Number of untimed rounds over the corpus before the timed round, if not specified
+ */
+constexpr int DefaultWarmupRounds = 3;
+
+/**
+ * Number of slowest Sudokus reported with --metrics, if not specified
+ */
+constexpr int DefaultTopSlowest = 10;
+
+/**
+ * Number of seconds between rewrites of the --prometheus metrics file, if not specified
+ */
+constexpr int DefaultPrometheusInterval = 10;
+
+/**
+ * Search depth at which --split divides the search into work units, if not specified
+ */
+constexpr std::size_t DefaultSplitDepth = 2;
+
+/**
+ * Number of search nodes between checkpoints of --count --checkpoint, if not specified
+ */
+constexpr std::uint64_t DefaultCheckpointInterval = 100000000;
+
+/**
+ * Number of MiB the cache of --count --memo may grow to, if not specified
+ */
+constexpr std::size_t DefaultMemoMegabytes = 256;
+
+/**
+ * The command-line options of the sudoku binary.
+ *
+ *   sudoku [--batch] [--validate] [--metrics [--top <k>]] [--perf-counters]
+ *          [--prometheus <file> [--prometheus-interval <seconds>]] [--trace <file>]
+ *          [--seed <n> [--restart-unit <nodes>]] [--generic-rows] [--reduce] [--dancing-cells] [--bitset]
+ *       Solve a single puzzle, or with --batch a list of puzzles separated by
+ *       empty lines, read from stdin. With --validate, only check the puzzles
+ *       for conflicting cells instead of solving them. With --metrics, report
+ *       latency percentiles per processing phase and the k slowest puzzles on stderr.
+ *       With --prometheus, keep counters and histograms in the Prometheus text
+ *       format in the given file, rewritten at most once per interval and at exit.
+ *       With --trace, record every search decision into the given binary trace,
+ *       to be summarized with the trace-summary tool.
+ *       With --seed, use a randomized search with restarts, see dlx::Solver::randomize() .
+ *       With --generic-rows, search without the specialization for four-node rows.
+ *       With --reduce, cover forced placements and drop dominated rows and columns before searching.
+ *       With --dancing-cells, search with dlx::DancingCellsSolver instead of dancing links.
+ *       With --bitset, search grids of up to 9x9 with dlx::BitsetSolver instead.
+ *   sudoku --batch --jobs <n> [--schedule fifo|longest] [--metrics [--top <k>]]
+ *          [--prometheus <file> [--prometheus-interval <seconds>]] [<search options>]
+ *       Solve a list of puzzles read from stdin on n worker threads, see \link runBatch() . By default,
+ *       the most expensive puzzles are dispatched first, and puzzles that would outlast the rest of the
+ *       batch are split across the workers. With --metrics and --prometheus, every worker records on
+ *       its own, and the recordings are merged once the batch finished. Meanwhile, the workers publish
+ *       their Prometheus metrics once per interval, and the metrics file is rewritten from the merged
+ *       totals. --perf-counters and --trace only apply to a batch of a single job.
+ *   sudoku --batch --input-archive <archive> --output-archive <archive> [--jobs <n>] [--metrics [--top <k>]]
+ *          [--prometheus <file>] [<search options>]
+ *       Solve the puzzles of a binary archive into an archive of solutions, see \link solveArchive() ,
+ *       on n worker threads, instrumented as a batch of n jobs.
+ *   sudoku --pack <archive> [--solutions]
+ *   sudoku --unpack <archive>
+ *       Convert between a batch in the text format and a binary archive, see \link PuzzleArchive :
+ *       pack a batch of puzzles (or with --solutions, the output of a batch) read from stdin into
+ *       the given archive, or write the records of the given archive to stdout.
+ *   sudoku [--batch] --minimality [--threads <n>]
+ *       List the redundant givens of a puzzle, or with --batch of each puzzle, read from stdin:
+ *       givens whose removal keeps the solution unique, see \link checkSudokuMinimality() .
+ *       The givens are checked on n threads, by default one per hardware thread.
+ *   sudoku --benchmark <corpus> [--warmup <rounds>] [--perf-counters] [--seed <n> [--restart-unit <nodes>]]
+ *          [--generic-rows] [--reduce] [--dancing-cells] [--bitset] [--jobs <n>]
+ *       Solve a corpus of puzzles and report per-puzzle latencies, see \link runBenchmark() .
+ *       With --jobs, also report the makespan of the corpus on n workers per schedule.
+ *   sudoku --split <directory> [--split-depth <levels>]
+ *   sudoku --work <unit> [--count]
+ *   sudoku --merge <directory>
+ *       Search a puzzle read from stdin across processes, see \link shardMain() : split its search
+ *       into work unit files, search a single unit (optionally counting all its solutions),
+ *       and merge the *.result files the workers' output was saved to.
+ *   sudoku --count [--checkpoint <file> [--checkpoint-interval <nodes>]]
+ *       Count all solutions of a puzzle read from stdin, see \link countSudoku() . With --checkpoint,
+ *       the search is checkpointed to the given file every interval nodes and on SIGINT or SIGTERM,
+ *       and resumed from it when the file exists.
+ *   sudoku --count --memo [--memo-memory <MiB>]
+ *       Count all solutions of a puzzle read from stdin, memoizing the count of every subproblem
+ *       in a cache of bounded memory, see \link countSudokuMemoized() .
+ */
+struct Options {
+  // Path of the corpus to benchmark, or empty when not in benchmark mode.
+  std::string benchmark_corpus;
+
+  // Number of untimed rounds over the corpus before the timed round.
+  int warmup_rounds = DefaultWarmupRounds;
+
+  // Whether to report hardware performance counters per processing phase.
+  bool perf_counters = false;
+
+  // Whether to read a batch of puzzles instead of a single puzzle.
+  bool batch = false;
+
+  // Whether to only validate the puzzles instead of solving them.
+  bool validate = false;
+
+  // Whether to list the redundant givens of the puzzles instead of solving them.
+  bool minimality = false;
+
+  // Number of threads checking givens for minimality, or 0 for the number of hardware threads.
+  unsigned threads = 0;
+
+  // Number of worker threads solving a batch, or 1 to solve it sequentially.
+  unsigned jobs = 1;
+
+  // The order in which a batch of several jobs dispatches its puzzles.
+  Schedule schedule = Schedule::LongestFirst;
+
+  // Whether to report latency histograms per processing phase.
+  bool metrics = false;
+
+  // Number of slowest puzzles to report with metrics.
+  int top_slowest = DefaultTopSlowest;
+
+  // File to expose Prometheus metrics in, or empty when not exposing metrics.
+  std::string prometheus_file;
+
+  // Number of seconds between rewrites of the Prometheus metrics file.
+  int prometheus_interval = DefaultPrometheusInterval;
+
+  // File to record search decisions in, or empty when not tracing.
+  std::string trace_file;
+
+  // Options for the search for a solution, such as a randomized search.
+  SearchOptions search;
+
+  // Directory to write work units to, or empty when not splitting a search.
+  std::string split_directory;
+
+  // Search depth at which to split.
+  std::size_t split_depth = DefaultSplitDepth;
+
+  // Work unit to search, or empty when not working on a unit.
+  std::string work_unit;
+
+  // Whether a worker counts all solutions of its unit, instead of stopping at the first.
+  // Without a unit, whether to count all solutions of the puzzle.
+  bool count = false;
+
+  // File to checkpoint a count to and resume it from, or empty when not checkpointing.
+  std::string checkpoint_file;
+
+  // Number of search nodes between checkpoints.
+  std::uint64_t checkpoint_interval = DefaultCheckpointInterval;
+
+  // Whether to count via memoized subproblem counts.
+  bool memo = false;
+
+  // Number of MiB the cache of memoized counts may grow to.
+  std::size_t memo_megabytes = DefaultMemoMegabytes;
+
+  // Directory to merge the work results of, or empty when not merging.
+  std::string merge_directory;
+
+  // Archive to pack a batch read from stdin into, or empty when not packing.
+  std::string pack_archive;
+
+  // Whether the batch to pack holds solutions rather than puzzles.
+  bool solutions = false;
+
+  // Archive to write as text to stdout, or empty when not unpacking.
+  std::string unpack_archive;
+
+  // Archive to read the puzzles of a batch from, and archive to write their solutions to,
+  // or empty when solving a batch read from stdin.
+  std::string input_archive;
+  std::string output_archive;
+};
+
+/**
+ * Parses the command-line arguments (excluding the program name) into options.
+ *
+ * \return if all arguments were valid. If not, an error is written to error.
+ */
+auto parseOptions(const std::vector<std::string>& args, Options& options, std::ostream& error) -> bool;
+
+}  // namespace app
+
+#endif  // APP_OPTIONS_HPP_
@@ -0,0 +1,63 @@
+#include "perf-phase-observer.hpp"
+
+#include <iomanip>
+
+namespace app {
+
+/**
+ * Column width of the human-readable table
+ */
+const int TableColumnWidth = 15;
+
+void PerfPhaseObserver::phaseStarted(Phase /*phase*/) {
+  this->counters.start();
+}
+
+void PerfPhaseObserver::phaseFinished(Phase phase) {
+  this->samples[static_cast<int>(phase)] += this->counters.stop();
+}
+
+auto PerfPhaseObserver::getSample(Phase phase) const -> const metrics::PerfSample& {
+  return this->samples[static_cast<int>(phase)];
+}
+
+void PerfPhaseObserver::writeTable(std::ostream& output) const {
+  if (!this->counters.isAvailable()) {
+    output << "Performance counters unavailable (see /proc/sys/kernel/perf_event_paranoid)" << '\n';
+    return;
+  }
+
+  output << std::left << std::setw(TableColumnWidth) << "phase";
+  for (int event = 0; event < metrics::NumPerfEvents; event++) {
+    output << std::right << std::setw(TableColumnWidth) << metrics::perfEventName(static_cast<metrics::PerfEvent>(event));
+  }
+  output << '\n';
+
+  for (int phase = 0; phase < NumPhases; phase++) {
+    output << std::left << std::setw(TableColumnWidth) << phaseName(static_cast<Phase>(phase));
+    for (int event = 0; event < metrics::NumPerfEvents; event++) {
+      output << std::right << std::setw(TableColumnWidth);
+      if (this->counters.isAvailable(static_cast<metrics::PerfEvent>(event))) {
+        output << this->samples[phase].counts[event];
+      } else {
+        output << "n/a";
+      }
+    }
+    output << '\n';
+  }
+}
+
+void PerfPhaseObserver::writeRecords(std::ostream& output) const {
+  for (int phase = 0; phase < NumPhases; phase++) {
+    output << "perf," << phaseName(static_cast<Phase>(phase));
+    for (int event = 0; event < metrics::NumPerfEvents; event++) {
+      output << ',';
+      if (this->counters.isAvailable(static_cast<metrics::PerfEvent>(event))) {
+        output << this->samples[phase].counts[event];
+      }
+    }
+    output << '\n';
+  }
+}
+
+}  // namespace app
@@ -0,0 +1,53 @@
+#ifndef APP_PERF_PHASE_OBSERVER_HPP_
+#define APP_PERF_PHASE_OBSERVER_HPP_
+
+#include <array>
+#include <iostream>
+
+#include "src/cc/libmetrics/perf-counters.hpp"
+#include "sudoku-processor.hpp"
+
+namespace app {
+
+/**
+ * A PhaseObserver accumulating hardware performance counters per processing phase.
+ *
+ * Counts are summed over all Sudokus processed with this observer, so that a
+ * batch run reports totals per phase. If perf events are unavailable, all counts
+ * remain zero and the reports say so.
+ */
+class PerfPhaseObserver : public PhaseObserver {
+ public:
+  void phaseStarted(Phase phase) override;
+  void phaseFinished(Phase phase) override;
+
+  /**
+   * Returns the accumulated counts for the given phase.
+   */
+  [[nodiscard]] auto getSample(Phase phase) const -> const metrics::PerfSample&;
+
+  /**
+   * Writes a human-readable table of the counts per phase.
+   */
+  void writeTable(std::ostream& output) const;
+
+  /**
+   * Writes the counts per phase as benchmark records:
+   *
+   *   perf,<phase>,<cycles>,<instructions>,<l1d_misses>,<llc_misses>,<branch_misses>
+   *
+   * Unavailable events are written as an empty field.
+   */
+  void writeRecords(std::ostream& output) const;
+
+ private:
+  // The hardware counters of the thread processing Sudokus
+  metrics::PerfCounters counters;
+
+  // Accumulated counts, indexed by Phase
+  std::array<metrics::PerfSample, NumPhases> samples;
+};
+
+}  // namespace app
+
+#endif  // APP_PERF_PHASE_OBSERVER_HPP_
@@ -0,0 +1,117 @@
+#include "prometheus-phase-observer.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace app {
+
+namespace {
+
+/**
+ * Test: every sudoku in a batch is counted by size and outcome, with its search nodes
+ */
+TEST(MainPrometheusPhaseObserver, Batch) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+4 4 _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+4 _ _
+)");
+  std::ostringstream output;
+  PrometheusPhaseObserver observer;
+
+  EXPECT_FALSE(processBatch(input, output, &observer));
+
+  EXPECT_EQ(1, observer.getPuzzles(sudoku::SudokuSize::Four, Outcome::Solved));
+  EXPECT_EQ(1, observer.getPuzzles(sudoku::SudokuSize::Four, Outcome::Unsolvable));
+  EXPECT_EQ(0, observer.getPuzzles(sudoku::SudokuSize::Nine, Outcome::Solved));
+
+  // the conflicting sudoku is rejected before searching
+  EXPECT_EQ(1, observer.getNodesHistogram(sudoku::SudokuSize::Four).getCount());
+
+  std::ostringstream metrics;
+  observer.writeMetrics(metrics);
+  EXPECT_NE(std::string::npos, metrics.str().find("sudoku_puzzles_total{size=\"4x4\",outcome=\"solved\"} 1\n"));
+  EXPECT_NE(std::string::npos, metrics.str().find("sudoku_puzzles_total{size=\"unknown\",outcome=\"invalid\"} 1\n"));
+  EXPECT_NE(std::string::npos, metrics.str().find("sudoku_puzzle_duration_seconds_count{size=\"4x4\"} 2\n"));
+  EXPECT_NE(std::string::npos, metrics.str().find("# TYPE sudoku_search_nodes histogram\n"));
+}
+
+/**
+ * Test: the metrics file is replaced as a whole
+ */
+TEST(MainPrometheusPhaseObserver, ExportFile) {
+  auto path = std::filesystem::temp_directory_path() / "sudoku-prometheus-unittest.prom";
+  PrometheusPhaseObserver observer(path.string());
+
+  std::istringstream input("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n");
+  std::ostringstream output;
+  EXPECT_TRUE(processBatch(input, output, &observer));
+  EXPECT_TRUE(observer.exportFile());
+
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  std::ostringstream expected;
+  observer.writeMetrics(expected);
+  EXPECT_EQ(expected.str(), contents.str());
+  EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+  std::filesystem::remove(path);
+}
+
+/**
+ * Test: observers of several workers publish to the total, which rewrites its file meanwhile,
+ * and what remains unpublished is merged in the end
+ */
+TEST(MainPrometheusPhaseObserver, PublishTo) {
+  constexpr unsigned Jobs = 3;
+  constexpr int Puzzles = 20;
+  auto path = std::filesystem::temp_directory_path() / "sudoku-prometheus-publish-unittest.prom";
+  std::filesystem::remove(path);
+  PrometheusPhaseObserver total(path.string(), std::chrono::milliseconds(0));
+  std::vector<PrometheusPhaseObserver> workers(Jobs);
+  for (auto& worker : workers) {
+    worker.publishTo(&total);
+  }
+
+  std::vector<std::thread> threads;
+  for (auto& worker : workers) {
+    threads.emplace_back([&worker]() {
+      for (int puzzle = 0; puzzle < Puzzles; puzzle++) {
+        std::istringstream input("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n");
+        std::ostringstream output;
+        EXPECT_TRUE(processBatch(input, output, &worker));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // with an interval of 0, every Sudoku is published as soon as it finished
+  EXPECT_TRUE(std::filesystem::exists(path));
+  EXPECT_EQ(Jobs * Puzzles, total.getPuzzles(sudoku::SudokuSize::Four, Outcome::Solved));
+  for (auto& worker : workers) {
+    EXPECT_EQ(0, worker.getPuzzles(sudoku::SudokuSize::Four, Outcome::Solved));
+    total.merge(worker);
+  }
+  EXPECT_EQ(Jobs * Puzzles, total.getPuzzles(sudoku::SudokuSize::Four, Outcome::Solved));
+  EXPECT_EQ(Jobs * Puzzles, total.getNodesHistogram(sudoku::SudokuSize::Four).getCount());
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace
+}  // namespace app
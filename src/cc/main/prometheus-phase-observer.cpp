@@ -0,0 +1,235 @@
+#include "prometheus-phase-observer.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#include "src/cc/libmetrics/prometheus.hpp"
+
+namespace app {
+
+/**
+ * Label values of the grid sizes, indexed as by sizeIndex(), followed by the label for invalid input
+ */
+const std::array<const char*, 4> SizeLabels = {"4x4", "9x9", "16x16", "unknown"};
+
+/**
+ * Label values of the outcomes, indexed by Outcome
+ */
+const std::array<const char*, NumOutcomes> OutcomeLabels = {"solved", "unsolvable", "invalid"};
+
+namespace {
+/**
+ * Helper method to move each bound to the highest value of its histogram bucket, so that the
+ * exposed bucket counts hold exactly the values up to the bound, see
+ * metrics::Histogram::getBucketUpperBound() . Bounds move up by less than 1/64.
+ */
+auto bucketBounds(std::array<std::uint64_t, 7> bounds) -> std::array<std::uint64_t, 7> {
+  for (auto& bound : bounds) {
+    bound = metrics::Histogram::getBucketUpperBound(bound);
+  }
+  return bounds;
+}
+}  // namespace
+
+/**
+ * Upper bounds of the latency buckets, in nanoseconds: about 10us up to 10s
+ */
+const std::array<std::uint64_t, 7> LatencyBounds =
+    bucketBounds({10'000, 100'000, 1'000'000, 10'000'000, 100'000'000, 1'000'000'000, 10'000'000'000});
+
+/**
+ * Upper bounds of the search node buckets: 10, 100, and about 1000 up to 10^7
+ */
+const std::array<std::uint64_t, 7> NodeBounds =
+    bucketBounds({10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000});
+
+/**
+ * Nanoseconds per second, the unit of exposed durations
+ */
+const double NanosPerSecond = 1e9;
+
+PrometheusPhaseObserver::PrometheusPhaseObserver(std::string path, std::chrono::milliseconds interval)
+    : path(std::move(path)),
+      interval(interval),
+      busy(0),
+      workers(1),
+      start_time(std::chrono::system_clock::now()),
+      last_export(std::chrono::steady_clock::now()),
+      current_size(NumSizes - 1),
+      total(nullptr) {}
+
+auto PrometheusPhaseObserver::sizeIndex(sudoku::SudokuSize size) -> int {
+  switch (size) {
+    case sudoku::SudokuSize::Four:
+      return 0;
+    case sudoku::SudokuSize::Nine:
+      return 1;
+    case sudoku::SudokuSize::Sixteen:
+      return 2;
+  }
+  return NumSizes - 1;
+}
+
+void PrometheusPhaseObserver::puzzleStarted(int /*line*/) {
+  // the size is unknown until the Sudoku is parsed
+  this->current_size = NumSizes - 1;
+  this->current_start = std::chrono::steady_clock::now();
+}
+
+void PrometheusPhaseObserver::puzzleParsed(sudoku::SudokuSize size) {
+  this->current_size = sizeIndex(size);
+}
+
+void PrometheusPhaseObserver::searchFinished(std::uint64_t nodes) {
+  this->nodes[this->current_size].record(nodes);
+}
+
+void PrometheusPhaseObserver::puzzleFinished(bool solved) {
+  auto now = std::chrono::steady_clock::now();
+  auto latency = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - this->current_start).count());
+
+  Outcome outcome = Outcome::Solved;
+  if (!solved) {
+    outcome = this->current_size == NumSizes - 1 ? Outcome::Invalid : Outcome::Unsolvable;
+  }
+
+  this->puzzles[this->current_size][static_cast<int>(outcome)]++;
+  this->latencies[this->current_size].record(latency);
+  this->busy += latency;
+
+  // rewrite the file periodically, checked once per Sudoku instead of on a separate thread
+  this->exportPeriodically(now);
+}
+
+void PrometheusPhaseObserver::phaseStarted(Phase /*phase*/) {}
+
+void PrometheusPhaseObserver::phaseFinished(Phase /*phase*/) {}
+
+void PrometheusPhaseObserver::splitFinished(const SplitReport& report) {
+  const int size = sizeIndex(report.size);
+  const Outcome outcome = report.solved ? Outcome::Solved : Outcome::Unsolvable;
+
+  this->puzzles[size][static_cast<int>(outcome)]++;
+  this->latencies[size].record(static_cast<std::uint64_t>(report.latency.count()));
+  this->nodes[size].record(report.nodes);
+  this->busy += static_cast<std::uint64_t>(report.busy.count());
+
+  this->exportPeriodically(std::chrono::steady_clock::now());
+}
+
+void PrometheusPhaseObserver::merge(const PrometheusPhaseObserver& other) {
+  for (int size = 0; size < NumSizes; size++) {
+    for (int outcome = 0; outcome < NumOutcomes; outcome++) {
+      this->puzzles[size][outcome] += other.puzzles[size][outcome];
+    }
+    this->latencies[size].merge(other.latencies[size]);
+    this->nodes[size].merge(other.nodes[size]);
+  }
+  this->busy += other.busy;
+}
+
+void PrometheusPhaseObserver::publishTo(PrometheusPhaseObserver* total) {
+  this->total = total;
+  if (total != nullptr) {
+    this->interval = total->interval;
+  }
+}
+
+void PrometheusPhaseObserver::exportPeriodically(std::chrono::steady_clock::time_point now) {
+  if (now - this->last_export < this->interval) {
+    return;
+  }
+  if (this->total == nullptr) {
+    if (!this->path.empty()) {
+      this->exportFile();
+    }
+    return;
+  }
+
+  // move everything recorded since the last publication to the total, keeping the Sudoku in progress
+  this->last_export = now;
+  const std::lock_guard lock(this->total->publish_mutex);
+  this->total->merge(*this);
+  this->puzzles = {};
+  this->latencies = {};
+  this->nodes = {};
+  this->busy = 0;
+  if (!this->total->path.empty() && now - this->total->last_export >= this->total->interval) {
+    this->total->exportFile();
+  }
+}
+
+void PrometheusPhaseObserver::setWorkers(unsigned workers) {
+  this->workers = workers;
+}
+
+auto PrometheusPhaseObserver::getPuzzles(sudoku::SudokuSize size, Outcome outcome) const -> std::uint64_t {
+  return this->puzzles[sizeIndex(size)][static_cast<int>(outcome)];
+}
+
+auto PrometheusPhaseObserver::getNodesHistogram(sudoku::SudokuSize size) const -> const metrics::Histogram& {
+  return this->nodes[sizeIndex(size)];
+}
+
+void PrometheusPhaseObserver::writeMetrics(std::ostream& output) const {
+  metrics::PrometheusWriter writer(output);
+
+  writer.family("sudoku_puzzles_total", metrics::MetricType::Counter, "Sudokus processed, by grid size and outcome.");
+  for (int size = 0; size < NumSizes; size++) {
+    for (int outcome = 0; outcome < NumOutcomes; outcome++) {
+      if (this->puzzles[size][outcome] != 0) {
+        writer.sample("sudoku_puzzles_total", {{"size", SizeLabels[size]}, {"outcome", OutcomeLabels[outcome]}},
+                      static_cast<double>(this->puzzles[size][outcome]));
+      }
+    }
+  }
+
+  writer.family("sudoku_puzzle_duration_seconds", metrics::MetricType::Histogram,
+                "Latency of processing a Sudoku, by grid size.");
+  for (int size = 0; size < NumSizes; size++) {
+    if (this->latencies[size].getCount() != 0) {
+      writer.histogram("sudoku_puzzle_duration_seconds", {{"size", SizeLabels[size]}}, this->latencies[size],
+                       LatencyBounds, NanosPerSecond);
+    }
+  }
+
+  writer.family("sudoku_search_nodes", metrics::MetricType::Histogram,
+                "Search nodes visited per Sudoku, by grid size.");
+  for (int size = 0; size < NumSizes; size++) {
+    if (this->nodes[size].getCount() != 0) {
+      writer.histogram("sudoku_search_nodes", {{"size", SizeLabels[size]}}, this->nodes[size], NodeBounds);
+    }
+  }
+
+  writer.family("sudoku_worker_busy_seconds_total", metrics::MetricType::Counter,
+                "Time spent processing Sudokus, summed over all workers.");
+  writer.sample("sudoku_worker_busy_seconds_total", {}, static_cast<double>(this->busy) / NanosPerSecond);
+
+  writer.family("sudoku_workers", metrics::MetricType::Gauge, "Number of workers processing Sudokus.");
+  writer.sample("sudoku_workers", {}, static_cast<double>(this->workers));
+
+  writer.family("sudoku_start_time_seconds", metrics::MetricType::Gauge, "Start time of the process since the epoch.");
+  writer.sample("sudoku_start_time_seconds", {},
+                std::chrono::duration<double>(this->start_time.time_since_epoch()).count());
+}
+
+auto PrometheusPhaseObserver::exportFile() -> bool {
+  this->last_export = std::chrono::steady_clock::now();
+
+  const std::string temporary = this->path + ".tmp";
+  {
+    std::ofstream output(temporary, std::ios::trunc);
+    this->writeMetrics(output);
+    if (!output.flush()) {
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporary, this->path, error);
+  return !error;
+}
+
+}  // namespace app
@@ -0,0 +1,164 @@
+#ifndef APP_PROMETHEUS_PHASE_OBSERVER_HPP_
+#define APP_PROMETHEUS_PHASE_OBSERVER_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include "src/cc/libmetrics/histogram.hpp"
+#include "src/cc/libsudoku/sudoku-math.hpp"
+#include "sudoku-processor.hpp"
+
+namespace app {
+
+/**
+ * Interval between rewrites of the metrics file, if not specified
+ */
+constexpr std::chrono::seconds DefaultExportInterval{10};
+
+/**
+ * The outcomes of processing a Sudoku, as counted by \link PrometheusPhaseObserver .
+ */
+enum class Outcome : std::uint8_t {
+  // A solution was found (or, when validating, the Sudoku has no conflicts)
+  Solved,
+
+  // The Sudoku was parsed, but has no solution (or, when validating, has conflicts)
+  Unsolvable,
+
+  // The input could not be parsed into a Sudoku
+  Invalid
+};
+
+/**
+ * Number of outcomes in \link Outcome .
+ */
+constexpr int NumOutcomes = 3;
+
+/**
+ * A PhaseObserver keeping process-level counters and histograms of all processed Sudokus,
+ * exposed in the Prometheus text format.
+ *
+ * Per grid size, it counts the Sudokus by \link Outcome , and records the latency and the
+ * number of search nodes of each Sudoku in a histogram. The time spent processing Sudokus
+ * is exposed as a busy-time counter, so that worker utilization is its rate.
+ *
+ * Recording takes a few increments per Sudoku. The metrics are exposed by periodically
+ * rewriting a file, to be scraped via the textfile collector of the Prometheus node exporter.
+ * The file is replaced atomically, so a scrape never observes a partially written file.
+ *
+ * An observer is not thread-safe: in a batch of several workers, each worker records into an
+ * observer of its own, and these are merged once the batch finished, see \link merge() .
+ * Meanwhile, the workers periodically publish what they recorded to the observer of the whole batch,
+ * which keeps rewriting its file, see \link publishTo() .
+ */
+class PrometheusPhaseObserver : public PhaseObserver {
+ public:
+  /**
+   * Constructs a new observer, rewriting the given file at most once per interval.
+   *
+   * \param path The file to write the metrics to, or empty to only collect them.
+   */
+  explicit PrometheusPhaseObserver(std::string path = "",
+                                   std::chrono::milliseconds interval = DefaultExportInterval);
+
+  void puzzleStarted(int line) override;
+  void puzzleFinished(bool solved) override;
+  void puzzleParsed(sudoku::SudokuSize size) override;
+  void searchFinished(std::uint64_t nodes) override;
+  void phaseStarted(Phase phase) override;
+  void phaseFinished(Phase phase) override;
+  void splitFinished(const SplitReport& report) override;
+
+  /**
+   * Adds everything recorded by another observer, such as that of another worker, to this observer.
+   */
+  void merge(const PrometheusPhaseObserver& other);
+
+  /**
+   * Periodically moves everything recorded by this observer, such as that of a worker, to the given total,
+   * which then rewrites its file at most once per its interval. Publishing is thread-safe, so the observers
+   * of several workers can publish to the same total while it is not otherwise used; what was not
+   * published yet remains to be merged into the total once the workers finished, see \link merge() .
+   *
+   * \param total The observer to publish to, using its interval, or nullptr to stop publishing.
+   */
+  void publishTo(PrometheusPhaseObserver* total);
+
+  /**
+   * Sets the number of workers processing Sudokus, exposed as a gauge; 1 by default.
+   */
+  void setWorkers(unsigned workers);
+
+  /**
+   * Returns the number of Sudokus of the given size processed with the given outcome.
+   */
+  [[nodiscard]] auto getPuzzles(sudoku::SudokuSize size, Outcome outcome) const -> std::uint64_t;
+
+  /**
+   * Returns the histogram of search nodes visited per Sudoku of the given size.
+   */
+  [[nodiscard]] auto getNodesHistogram(sudoku::SudokuSize size) const -> const metrics::Histogram&;
+
+  /**
+   * Writes all metrics in the Prometheus text format.
+   */
+  void writeMetrics(std::ostream& output) const;
+
+  /**
+   * Rewrites the metrics file, by writing a temporary file next to it and renaming it.
+   *
+   * \return if the file was written.
+   */
+  auto exportFile() -> bool;
+
+ private:
+  // Number of grid size labels: the Sudoku sizes, and 'unknown' for invalid input
+  static constexpr int NumSizes = 4;
+
+  // The file to write the metrics to, and the minimal interval between rewrites
+  std::string path;
+  std::chrono::milliseconds interval;
+
+  // Number of Sudokus, indexed by grid size and Outcome
+  std::array<std::array<std::uint64_t, NumOutcomes>, NumSizes> puzzles{};
+
+  // Latency histograms in nanoseconds, and search node histograms, indexed by grid size
+  std::array<metrics::Histogram, NumSizes> latencies;
+  std::array<metrics::Histogram, NumSizes> nodes;
+
+  // Total time spent processing Sudokus, in nanoseconds
+  std::uint64_t busy;
+
+  // Number of workers processing Sudokus
+  unsigned workers;
+
+  // The time this observer was created, and the time the file was last written
+  std::chrono::system_clock::time_point start_time;
+  std::chrono::steady_clock::time_point last_export;
+
+  // State of the Sudoku currently being processed
+  int current_size;
+  std::chrono::steady_clock::time_point current_start;
+
+  // The observer to publish to, see publishTo(), and the lock of the metrics published to this observer
+  PrometheusPhaseObserver* total;
+  std::mutex publish_mutex;
+
+  /**
+   * Helper method to rewrite the file, or to publish to the total, once the interval elapsed.
+   */
+  void exportPeriodically(std::chrono::steady_clock::time_point now);
+
+  /**
+   * Helper method to find the index of a grid size.
+   */
+  static auto sizeIndex(sudoku::SudokuSize size) -> int;
+};
+
+}  // namespace app
+
+#endif  // APP_PROMETHEUS_PHASE_OBSERVER_HPP_
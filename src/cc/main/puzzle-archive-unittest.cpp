@@ -0,0 +1,282 @@
+#include "puzzle-archive.hpp"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace app {
+
+namespace {
+
+/**
+ * A batch of a solvable, a conflicting and a malformed 4x4 Sudoku
+ */
+constexpr const char* Batch = "4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n\n"
+                              "4 4 _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n\n"
+                              "4 _ _\n";
+
+/**
+ * Test Helper: the path of a temporary file for the given test
+ */
+auto temporaryPath(const std::string& name) -> std::string {
+  return (std::filesystem::temp_directory_path() / ("sudoku-archive-unittest-" + name)).string();
+}
+
+/**
+ * Test: cells are packed into 4 bits up to 9x9, and into 5 bits for 16x16
+ */
+TEST(MainPuzzleArchive, RecordBytes) {
+  EXPECT_EQ(4, archiveCellBits(sudoku::SudokuSize::Four));
+  EXPECT_EQ(4, archiveCellBits(sudoku::SudokuSize::Nine));
+  EXPECT_EQ(5, archiveCellBits(sudoku::SudokuSize::Sixteen));
+
+  EXPECT_EQ(8, archiveRecordBytes(sudoku::SudokuSize::Four));
+  EXPECT_EQ(41, archiveRecordBytes(sudoku::SudokuSize::Nine));
+  EXPECT_EQ(160, archiveRecordBytes(sudoku::SudokuSize::Sixteen));
+}
+
+/**
+ * Test: grids written to a new archive are read back, also after reopening and resizing it
+ */
+TEST(MainPuzzleArchive, WriteAndRead) {
+  const auto path = temporaryPath("write.sdk");
+
+  for (auto size : {sudoku::SudokuSize::Four, sudoku::SudokuSize::Nine, sudoku::SudokuSize::Sixteen}) {
+    const int cells = static_cast<int>(size) * static_cast<int>(size);
+
+    // every number, including the largest, and empty cells in between
+    std::vector<std::uint8_t> grid(cells);
+    for (int cell = 0; cell < cells; cell++) {
+      grid[cell] = static_cast<std::uint8_t>((cell * 7) % (static_cast<int>(size) + 1));
+    }
+
+    {
+      auto archive = PuzzleArchive::create(path, size, ArchiveSolutions, 3);
+      ASSERT_TRUE(archive.has_value());
+      ASSERT_TRUE(archive->write(1, grid).has_value());
+
+      // growing keeps the records, and adds empty ones
+      ASSERT_TRUE(archive->resize(5));
+      ASSERT_TRUE(archive->write(4, grid).has_value());
+    }
+
+    auto archive = PuzzleArchive::open(path);
+    ASSERT_TRUE(archive.has_value());
+    EXPECT_EQ(size, archive->getSudokuSize());
+    EXPECT_EQ(ArchiveSolutions, archive->getFlags());
+    ASSERT_EQ(5, archive->getCount());
+    EXPECT_EQ(sizeof(ArchiveHeader) + (5 * archiveRecordBytes(size)), std::filesystem::file_size(path));
+
+    std::vector<std::uint8_t> digits(cells, 1);
+    for (std::uint64_t index = 0; index < archive->getCount(); index++) {
+      ASSERT_TRUE(archive->read(index, digits).has_value());
+      EXPECT_EQ(index == 1 || index == 4 ? grid : std::vector<std::uint8_t>(cells, 0), digits)
+          << "size " << static_cast<int>(size) << ", record " << index;
+    }
+
+    // a read-only archive cannot be resized or written
+    EXPECT_FALSE(archive->resize(1));
+    auto written = archive->write(0, grid);
+    ASSERT_FALSE(written.has_value());
+    EXPECT_EQ(ArchiveError::Io, written.error());
+  }
+  std::filesystem::remove(path);
+}
+
+/**
+ * Test: files that are missing, not an archive, or shorter than their header says are rejected
+ */
+TEST(MainPuzzleArchive, Invalid) {
+  const auto path = temporaryPath("invalid.sdk");
+  std::filesystem::remove(path);
+
+  auto missing = PuzzleArchive::open(path);
+  ASSERT_FALSE(missing.has_value());
+  EXPECT_EQ(ArchiveError::Io, missing.error());
+
+  {
+    std::ofstream text(path);
+    text << Batch << Batch << Batch;
+  }
+  auto not_archive = PuzzleArchive::open(path);
+  ASSERT_FALSE(not_archive.has_value());
+  EXPECT_EQ(ArchiveError::Format, not_archive.error());
+
+  ASSERT_TRUE(PuzzleArchive::create(path, sudoku::SudokuSize::Nine, 0, 2).has_value());
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  auto truncated = PuzzleArchive::open(path);
+  ASSERT_FALSE(truncated.has_value());
+  EXPECT_EQ(ArchiveError::Format, truncated.error());
+  std::filesystem::remove(path);
+}
+
+/**
+ * Test: records holding a cell code above the grid size are rejected when reading, unpacking and solving
+ */
+TEST(MainPuzzleArchive, InvalidCell) {
+  const auto path = temporaryPath("cell.sdk");
+  const auto solutions_path = temporaryPath("cell-solutions.sdk");
+
+  for (auto size : {sudoku::SudokuSize::Four, sudoku::SudokuSize::Nine, sudoku::SudokuSize::Sixteen}) {
+    const int cells = static_cast<int>(size) * static_cast<int>(size);
+    {
+      auto archive = PuzzleArchive::create(path, size, 0, 2);
+      ASSERT_TRUE(archive.has_value());
+    }
+
+    // the last cell of the second record holds N+1, written into the file past the archive
+    {
+      std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+      const int bits = archiveCellBits(size);
+      const auto offset = ((cells - 1) * bits);
+      const auto code = static_cast<unsigned>(size) + 1;
+      const auto position = sizeof(ArchiveHeader) + archiveRecordBytes(size) + (offset / 8);
+      const unsigned window = code << static_cast<unsigned>(offset % 8);
+      std::array<char, 2> bytes = {static_cast<char>(window & 0xFFU), static_cast<char>(window >> 8U)};
+      file.seekp(static_cast<std::streamoff>(position));
+      file.write(bytes.data(), (offset % 8) + bits > 8 ? 2 : 1);
+    }
+
+    auto archive = PuzzleArchive::open(path);
+    ASSERT_TRUE(archive.has_value());
+    std::vector<std::uint8_t> digits(cells);
+    EXPECT_TRUE(archive->read(0, digits).has_value());
+    auto corrupt = archive->read(1, digits);
+    ASSERT_FALSE(corrupt.has_value()) << "size " << static_cast<int>(size);
+    EXPECT_EQ(ArchiveError::Format, corrupt.error());
+    EXPECT_EQ(static_cast<int>(size) + 1, digits[cells - 1]);
+
+    std::ostringstream unpacked;
+    EXPECT_FALSE(unpackArchive(unpacked, path));
+    EXPECT_NE(std::string::npos, unpacked.str().find(errorMessage(ArchiveError::Format)));
+
+    auto solutions = PuzzleArchive::create(solutions_path, size, ArchiveSolutions, 2);
+    ASSERT_TRUE(solutions.has_value());
+    EXPECT_FALSE(solveArchive(archive.value(), solutions.value(), 2));
+  }
+
+  std::filesystem::remove(path);
+  std::filesystem::remove(solutions_path);
+}
+
+/**
+ * Test: a batch is packed into an archive and unpacked into the same text, skipping malformed Sudokus
+ */
+TEST(MainPuzzleArchive, PackAndUnpack) {
+  const auto path = temporaryPath("pack.sdk");
+
+  std::istringstream input(Batch);
+  std::ostringstream output;
+  EXPECT_FALSE(packArchive(input, output, path, false));
+  EXPECT_EQ("Error: Unrecognized Sudoku size:3. Valid sizes are: 4, 9, 16 (Sudoku at line 11)\n2\n", output.str());
+
+  std::ostringstream text;
+  ASSERT_TRUE(unpackArchive(text, path));
+  EXPECT_EQ("4 _ _ 1 \n_ 1 3 _ \n_ 4 1 _ \n1 _ _ 3 \n\n"
+            "4 4 _ 1 \n_ 1 3 _ \n_ 4 1 _ \n1 _ _ 3 \n\n",
+            text.str());
+
+  // the solutions of a batch keep the Sudokus without a solution
+  std::istringstream batch(Batch);
+  std::ostringstream solutions;
+  EXPECT_FALSE(processBatch(batch, solutions));
+
+  std::istringstream solutions_input(solutions.str());
+  std::ostringstream count;
+  EXPECT_TRUE(packArchive(solutions_input, count, path, true));
+  EXPECT_EQ("3\n", count.str());
+
+  std::ostringstream unpacked;
+  ASSERT_TRUE(unpackArchive(unpacked, path));
+  EXPECT_EQ("4 3 2 1 \n2 1 3 4 \n3 4 1 2 \n1 2 4 3 \n\n"
+            "No valid Sudoku solution found\n\n"
+            "No valid Sudoku solution found\n\n",
+            unpacked.str());
+  std::filesystem::remove(path);
+}
+
+/**
+ * Test: the archive grows past its initial capacity, also when solutions without a grid are skipped
+ * in between
+ */
+TEST(MainPuzzleArchive, PackGrows) {
+  const auto path = temporaryPath("grow.sdk");
+  constexpr const char* Grid = "4 3 2 1\n2 1 3 4\n3 4 1 2\n1 2 4 3\n\n";
+  constexpr const char* NoSolution = "No valid Sudoku solution found\n\n";
+
+  // more skipped records than remain free after the first grids, then more grids
+  std::string batch;
+  for (int index = 0; index < 1000; index++) {
+    batch += Grid;
+  }
+  for (int index = 0; index < 300; index++) {
+    batch += NoSolution;
+  }
+  for (int index = 0; index < 1200; index++) {
+    batch += Grid;
+  }
+  batch += NoSolution;
+
+  std::istringstream input(batch);
+  std::ostringstream count;
+  EXPECT_TRUE(packArchive(input, count, path, true));
+  EXPECT_EQ("2501\n", count.str());
+
+  auto archive = PuzzleArchive::open(path);
+  ASSERT_TRUE(archive.has_value());
+  ASSERT_EQ(2501, archive->getCount());
+  EXPECT_EQ(sizeof(ArchiveHeader) + (2501 * archiveRecordBytes(sudoku::SudokuSize::Four)),
+            std::filesystem::file_size(path));
+
+  const std::vector<std::uint8_t> grid = {4, 3, 2, 1, 2, 1, 3, 4, 3, 4, 1, 2, 1, 2, 4, 3};
+  std::vector<std::uint8_t> digits(16);
+  for (std::uint64_t index = 0; index < archive->getCount(); index++) {
+    ASSERT_TRUE(archive->read(index, digits).has_value());
+    const bool skipped = (index >= 1000 && index < 1300) || index == 2500;
+    EXPECT_EQ(skipped ? std::vector<std::uint8_t>(16, 0) : grid, digits) << "record " << index;
+  }
+  std::filesystem::remove(path);
+}
+
+/**
+ * Test: an archive of puzzles is solved into an archive of the same solutions as a text batch,
+ * on any number of workers
+ */
+TEST(MainPuzzleArchive, Solve) {
+  const auto puzzles_path = temporaryPath("puzzles.sdk");
+  const auto solutions_path = temporaryPath("solutions.sdk");
+
+  std::istringstream input(Batch);
+  std::ostringstream count;
+  packArchive(input, count, puzzles_path, false);
+
+  std::istringstream batch("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n\n4 4 _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n");
+  std::ostringstream expected;
+  EXPECT_FALSE(processBatch(batch, expected));
+
+  for (unsigned jobs : {1U, 3U}) {
+    Options options;
+    options.input_archive = puzzles_path;
+    options.output_archive = solutions_path;
+    options.jobs = jobs;
+
+    std::istringstream no_input;
+    std::ostringstream output;
+    EXPECT_FALSE(archiveMain(options, no_input, output, {}));
+    EXPECT_EQ("", output.str());
+
+    std::ostringstream solutions;
+    ASSERT_TRUE(unpackArchive(solutions, solutions_path));
+    EXPECT_EQ(expected.str(), solutions.str()) << jobs << " jobs";
+  }
+
+  std::filesystem::remove(puzzles_path);
+  std::filesystem::remove(solutions_path);
+}
+
+}  // namespace
+}  // namespace app
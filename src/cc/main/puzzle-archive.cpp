@@ -0,0 +1,475 @@
+#include "puzzle-archive.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <optional>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include "batch-scheduler.hpp"
+#include "corpus-reader.hpp"
+#include "src/cc/libsudoku/puzzle.hpp"
+
+namespace app {
+
+static_assert(std::is_trivially_copyable_v<ArchiveHeader> && sizeof(ArchiveHeader) == 32,
+              "archive headers are written as fixed-size records");
+
+/**
+ * The magic bytes starting every archive, and the version of the format
+ */
+constexpr std::array<char, 8> ArchiveMagic = {'S', 'U', 'D', 'O', 'K', 'U', 'P', 'K'};
+constexpr std::uint32_t ArchiveVersion = 1;
+
+/**
+ * Number of records a packed archive is created with, doubled whenever it is full
+ */
+constexpr std::uint64_t InitialPackCapacity = 1024;
+
+/**
+ * Number of bits per byte
+ */
+constexpr int ByteBits = 8;
+
+/**
+ * Number of bits per cell of the grids up to 9x9
+ */
+constexpr int NibbleBits = 4;
+
+auto errorMessage(ArchiveError error) -> std::string {
+  switch (error) {
+    case ArchiveError::Io:
+      return "Error: Cannot open, create or map archive";
+    case ArchiveError::Format:
+      return "Error: Not a puzzle archive";
+  }
+  return "Error: Unknown archive error";
+}
+
+auto archiveCellBits(sudoku::SudokuSize sudoku_size) -> int {
+  return std::max(NibbleBits, static_cast<int>(std::bit_width(static_cast<unsigned>(sudoku_size))));
+}
+
+auto archiveRecordBytes(sudoku::SudokuSize sudoku_size) -> std::size_t {
+  const auto cells = static_cast<std::size_t>(sudoku_size) * static_cast<std::size_t>(sudoku_size);
+  return (cells * archiveCellBits(sudoku_size) + ByteBits - 1) / ByteBits;
+}
+
+namespace {
+/**
+ * Helper method to check if the given size is a supported Sudoku size
+ */
+auto isSudokuSize(std::uint32_t size) -> bool {
+  return size == static_cast<std::uint32_t>(sudoku::SudokuSize::Four) ||
+         size == static_cast<std::uint32_t>(sudoku::SudokuSize::Nine) ||
+         size == static_cast<std::uint32_t>(sudoku::SudokuSize::Sixteen);
+}
+
+/**
+ * Helper method to get the number of bytes of an archive of count records of the given size
+ */
+auto archiveBytes(sudoku::SudokuSize sudoku_size, std::uint64_t count) -> std::size_t {
+  return sizeof(ArchiveHeader) + count * archiveRecordBytes(sudoku_size);
+}
+}  // namespace
+
+PuzzleArchive::PuzzleArchive(int descriptor, void* mapping, std::size_t mapped_bytes, bool writable)
+    : descriptor(descriptor), mapping(mapping), mapped_bytes(mapped_bytes), writable(writable) {}
+
+PuzzleArchive::PuzzleArchive(PuzzleArchive&& other) noexcept
+    : descriptor(std::exchange(other.descriptor, -1)),
+      mapping(std::exchange(other.mapping, nullptr)),
+      mapped_bytes(std::exchange(other.mapped_bytes, 0)),
+      writable(other.writable) {}
+
+auto PuzzleArchive::operator=(PuzzleArchive&& other) noexcept -> PuzzleArchive& {
+  if (this != &other) {
+    std::swap(this->descriptor, other.descriptor);
+    std::swap(this->mapping, other.mapping);
+    std::swap(this->mapped_bytes, other.mapped_bytes);
+    std::swap(this->writable, other.writable);
+  }
+  return *this;
+}
+
+PuzzleArchive::~PuzzleArchive() {
+  if (this->mapping != nullptr) {
+    munmap(this->mapping, this->mapped_bytes);
+  }
+  if (this->descriptor >= 0) {
+    close(this->descriptor);
+  }
+}
+
+auto PuzzleArchive::open(const std::string& path) -> sudoku::Expected<PuzzleArchive, ArchiveError> {
+  using Error = sudoku::Unexpected<ArchiveError>;
+
+  const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (descriptor < 0) {
+    return Error(ArchiveError::Io);
+  }
+
+  struct stat status {};
+  if (fstat(descriptor, &status) != 0) {
+    close(descriptor);
+    return Error(ArchiveError::Io);
+  }
+  const auto file_bytes = static_cast<std::size_t>(status.st_size);
+  if (file_bytes < sizeof(ArchiveHeader)) {
+    close(descriptor);
+    return Error(ArchiveError::Format);
+  }
+
+  void* mapping = mmap(nullptr, file_bytes, PROT_READ, MAP_SHARED, descriptor, 0);
+  if (mapping == MAP_FAILED) {
+    close(descriptor);
+    return Error(ArchiveError::Io);
+  }
+  PuzzleArchive archive(descriptor, mapping, file_bytes, false);
+
+  // the records the header announces must all be in the file
+  const auto* header = static_cast<const ArchiveHeader*>(mapping);
+  if (header->magic != ArchiveMagic || header->version != ArchiveVersion || !isSudokuSize(header->sudoku_size)) {
+    return Error(ArchiveError::Format);
+  }
+  const auto sudoku_size = static_cast<sudoku::SudokuSize>(header->sudoku_size);
+  if (header->record_bytes != archiveRecordBytes(sudoku_size) ||
+      header->count > (file_bytes - sizeof(ArchiveHeader)) / header->record_bytes) {
+    return Error(ArchiveError::Format);
+  }
+  return archive;
+}
+
+auto PuzzleArchive::create(const std::string& path, sudoku::SudokuSize sudoku_size, std::uint32_t flags,
+                           std::uint64_t count) -> sudoku::Expected<PuzzleArchive, ArchiveError> {
+  using Error = sudoku::Unexpected<ArchiveError>;
+
+  const int descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);  // NOLINT(*-magic-numbers)
+  if (descriptor < 0) {
+    return Error(ArchiveError::Io);
+  }
+
+  // a new file is extended with zeros, i.e., with empty records
+  const auto bytes = archiveBytes(sudoku_size, count);
+  if (ftruncate(descriptor, static_cast<off_t>(bytes)) != 0) {
+    close(descriptor);
+    return Error(ArchiveError::Io);
+  }
+
+  void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+  if (mapping == MAP_FAILED) {
+    close(descriptor);
+    return Error(ArchiveError::Io);
+  }
+
+  auto* header = static_cast<ArchiveHeader*>(mapping);
+  header->magic = ArchiveMagic;
+  header->version = ArchiveVersion;
+  header->flags = flags;
+  header->sudoku_size = static_cast<std::uint32_t>(sudoku_size);
+  header->record_bytes = static_cast<std::uint32_t>(archiveRecordBytes(sudoku_size));
+  header->count = count;
+  return PuzzleArchive(descriptor, mapping, bytes, true);
+}
+
+auto PuzzleArchive::getSudokuSize() const -> sudoku::SudokuSize {
+  return static_cast<sudoku::SudokuSize>(static_cast<const ArchiveHeader*>(this->mapping)->sudoku_size);
+}
+
+auto PuzzleArchive::getFlags() const -> std::uint32_t {
+  return static_cast<const ArchiveHeader*>(this->mapping)->flags;
+}
+
+auto PuzzleArchive::getCount() const -> std::uint64_t {
+  return static_cast<const ArchiveHeader*>(this->mapping)->count;
+}
+
+auto PuzzleArchive::record(std::uint64_t index) const -> std::uint8_t* {
+  const auto record_bytes = static_cast<const ArchiveHeader*>(this->mapping)->record_bytes;
+  return static_cast<std::uint8_t*>(this->mapping) + sizeof(ArchiveHeader) + index * record_bytes;
+}
+
+auto PuzzleArchive::read(std::uint64_t index, std::span<std::uint8_t> digits) const
+    -> sudoku::Expected<void, ArchiveError> {
+  const auto sudoku_size = this->getSudokuSize();
+  const int bits = archiveCellBits(sudoku_size);
+  const unsigned mask = (1U << static_cast<unsigned>(bits)) - 1;
+  const int cells = static_cast<int>(sudoku_size) * static_cast<int>(sudoku_size);
+  const std::uint8_t* record = this->record(index);
+
+  // cells are packed from the lowest bit of each byte up, and may span two bytes
+  unsigned highest = 0;
+  for (int cell = 0, offset = 0; cell < cells; cell++, offset += bits) {
+    const int byte = offset / ByteBits;
+    const int shift = offset % ByteBits;
+    unsigned window = record[byte];
+    if (shift + bits > ByteBits) {
+      window |= static_cast<unsigned>(record[byte + 1]) << static_cast<unsigned>(ByteBits);
+    }
+    const unsigned code = (window >> static_cast<unsigned>(shift)) & mask;
+    highest = std::max(highest, code);
+    digits[cell] = static_cast<std::uint8_t>(code);
+  }
+
+  // the cell bits hold codes up to 15 or 31, of which only 0..N are numbers
+  if (highest > static_cast<unsigned>(sudoku_size)) {
+    return sudoku::Unexpected<ArchiveError>(ArchiveError::Format);
+  }
+  return {};
+}
+
+auto PuzzleArchive::write(std::uint64_t index, std::span<const std::uint8_t> digits)
+    -> sudoku::Expected<void, ArchiveError> {
+  if (!this->writable) {
+    return sudoku::Unexpected<ArchiveError>(ArchiveError::Io);
+  }
+
+  const auto sudoku_size = this->getSudokuSize();
+  const int bits = archiveCellBits(sudoku_size);
+  const int cells = static_cast<int>(sudoku_size) * static_cast<int>(sudoku_size);
+  std::uint8_t* record = this->record(index);
+
+  std::fill_n(record, archiveRecordBytes(sudoku_size), 0);
+  for (int cell = 0, offset = 0; cell < cells; cell++, offset += bits) {
+    const int byte = offset / ByteBits;
+    const int shift = offset % ByteBits;
+    const unsigned window = static_cast<unsigned>(digits[cell]) << static_cast<unsigned>(shift);
+    record[byte] |= static_cast<std::uint8_t>(window);
+    if (shift + bits > ByteBits) {
+      record[byte + 1] |= static_cast<std::uint8_t>(window >> static_cast<unsigned>(ByteBits));
+    }
+  }
+  return {};
+}
+
+auto PuzzleArchive::resize(std::uint64_t count) -> bool {
+  if (!this->writable || this->mapping == nullptr) {
+    return false;
+  }
+
+  const auto header = *static_cast<const ArchiveHeader*>(this->mapping);
+  const auto bytes = archiveBytes(static_cast<sudoku::SudokuSize>(header.sudoku_size), count);
+  munmap(this->mapping, this->mapped_bytes);
+  this->mapping = nullptr;
+  this->mapped_bytes = 0;
+
+  // records beyond the old end of the file are extended with zeros, records cut off are dropped
+  if (ftruncate(this->descriptor, static_cast<off_t>(bytes)) != 0) {
+    return false;
+  }
+  void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, this->descriptor, 0);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+
+  this->mapping = mapping;
+  this->mapped_bytes = bytes;
+  static_cast<ArchiveHeader*>(this->mapping)->count = count;
+  return true;
+}
+
+auto packArchive(std::istream& input, std::ostream& output, const std::string& path, bool solutions) -> bool {
+  const std::uint32_t flags = solutions ? ArchiveSolutions : 0;
+
+  // the archive is created at the first grid, as that determines its size
+  std::optional<PuzzleArchive> archive;
+  std::uint64_t count = 0;
+  std::uint64_t capacity = 0;
+  bool all_written = true;
+
+  CorpusReader reader(input);
+  std::array<std::uint8_t, sudoku::MaxCells> digits{};
+  for (std::string text; reader.next(text);) {
+    std::istringstream stream(text);
+    auto puzzle = parseInput(stream);
+
+    // a batch of solutions lists "No valid Sudoku solution found" or an error instead of a grid
+    if (!puzzle.has_value() && solutions) {
+      count++;
+      continue;
+    }
+    if (!puzzle.has_value()) {
+      output << errorMessage(puzzle.error()) << " (Sudoku at line " << reader.getLine() << ")" << '\n';
+      all_written = false;
+      continue;
+    }
+
+    const auto sudoku_size = puzzle.value().getSudokuSize();
+    if (!archive.has_value()) {
+      capacity = std::max(InitialPackCapacity, count + 1);
+      auto created = PuzzleArchive::create(path, sudoku_size, flags, capacity);
+      if (!created.has_value()) {
+        output << errorMessage(created.error()) << ": " << path << '\n';
+        return false;
+      }
+      archive.emplace(std::move(created.value()));
+    } else if (sudoku_size != archive->getSudokuSize()) {
+      output << "Error: Sudoku size " << static_cast<int>(sudoku_size) << " differs from the archive size "
+             << static_cast<int>(archive->getSudokuSize()) << " (Sudoku at line " << reader.getLine() << ")" << '\n';
+      all_written = false;
+      continue;
+    }
+
+    // skipped solutions count as records without being written, so count may have passed capacity
+    if (count >= capacity) {
+      capacity = std::max(2 * capacity, count + 1);
+      if (!archive->resize(capacity)) {
+        output << errorMessage(ArchiveError::Io) << ": " << path << '\n';
+        return false;
+      }
+    }
+
+    const auto cells = puzzle.value().getCells();
+    std::copy(cells.begin(), cells.end(), digits.begin());
+    if (!archive->write(count++, digits).has_value()) {
+      output << errorMessage(ArchiveError::Io) << ": " << path << '\n';
+      return false;
+    }
+  }
+
+  // without any grid, the archive holds 9x9 records, all empty
+  if (!archive.has_value()) {
+    auto created = PuzzleArchive::create(path, sudoku::SudokuSize::Nine, flags, count);
+    if (!created.has_value()) {
+      output << errorMessage(created.error()) << ": " << path << '\n';
+      return false;
+    }
+    archive.emplace(std::move(created.value()));
+  }
+
+  if (!archive->resize(count)) {
+    output << errorMessage(ArchiveError::Io) << ": " << path << '\n';
+    return false;
+  }
+  output << count << '\n';
+  return all_written;
+}
+
+auto unpackArchive(std::ostream& output, const std::string& path) -> bool {
+  auto archive = PuzzleArchive::open(path);
+  if (!archive.has_value()) {
+    output << errorMessage(archive.error()) << ": " << path << '\n';
+    return false;
+  }
+
+  const auto sudoku_size = archive->getSudokuSize();
+  const auto cells = static_cast<std::size_t>(sudoku_size) * static_cast<std::size_t>(sudoku_size);
+  const bool solutions = (archive->getFlags() & ArchiveSolutions) != 0;
+
+  std::array<std::uint8_t, sudoku::MaxCells> digits{};
+  for (std::uint64_t index = 0; index < archive->getCount(); index++) {
+    auto read = archive->read(index, digits);
+    if (!read.has_value()) {
+      output << errorMessage(read.error()) << ": " << path << " (record " << index << ")" << '\n';
+      return false;
+    }
+    const bool empty = std::all_of(digits.begin(), digits.begin() + cells, [](auto digit) { return digit == 0; });
+    if (solutions && empty) {
+      output << "No valid Sudoku solution found" << '\n';
+    } else {
+      writeSolution(output, sudoku_size, digits);
+    }
+    output << '\n';
+  }
+  return true;
+}
+
+auto solveArchive(const PuzzleArchive& input, PuzzleArchive& output, unsigned jobs,
+                  std::span<PhaseObserver* const> observers, const SearchOptions& search) -> bool {
+  const auto sudoku_size = input.getSudokuSize();
+  if (output.getSudokuSize() != sudoku_size || output.getCount() != input.getCount()) {
+    return false;
+  }
+
+  const int grid_size = static_cast<int>(sudoku_size);
+  std::atomic<bool> all_solved(true);
+  auto solve = [&](std::size_t index, PhaseObserver* notify) {
+    if (notify != nullptr) {
+      notify->puzzleStarted(static_cast<int>(index + 1));
+      notify->phaseStarted(Phase::Parse);
+    }
+
+    // unpacking a record takes the place of parsing its text, and a corrupt record counts as unsolved
+    std::array<std::uint8_t, sudoku::MaxCells> digits{};
+    if (!input.read(index, digits).has_value()) {
+      all_solved.store(false, std::memory_order_relaxed);
+      if (notify != nullptr) {
+        notify->phaseFinished(Phase::Parse);
+        notify->puzzleFinished(false);
+      }
+      return;
+    }
+    sudoku::Puzzle puzzle(sudoku_size);
+    for (int cell = 0; cell < grid_size * grid_size; cell++) {
+      if (digits[cell] != sudoku::Puzzle::EmptyCell) {
+        puzzle.setCellValue((cell / grid_size) + 1, (cell % grid_size) + 1, digits[cell]);
+      }
+    }
+
+    if (notify != nullptr) {
+      notify->phaseFinished(Phase::Parse);
+      notify->puzzleParsed(sudoku_size);
+    }
+
+    // a puzzle without a solution keeps its empty record
+    std::array<std::uint8_t, sudoku::MaxCells> solution{};
+    bool solved = solvePuzzle(puzzle, solution, notify, search);
+    if (solved) {
+      if (notify != nullptr) {
+        notify->phaseStarted(Phase::Output);
+      }
+      solved = output.write(index, solution).has_value();
+      if (notify != nullptr) {
+        notify->phaseFinished(Phase::Output);
+      }
+    }
+    if (!solved) {
+      all_solved.store(false, std::memory_order_relaxed);
+    }
+
+    if (notify != nullptr) {
+      notify->puzzleFinished(solved);
+    }
+  };
+
+  forEachParallel(input.getCount(), std::max(jobs, 1U), [&](std::size_t index, unsigned worker) {
+    solve(index, worker < observers.size() ? observers[worker] : nullptr);
+  });
+  return all_solved.load();
+}
+
+auto archiveMain(const Options& options, std::istream& input, std::ostream& output,
+                 std::span<PhaseObserver* const> observers) -> bool {
+  if (!options.pack_archive.empty()) {
+    return packArchive(input, output, options.pack_archive, options.solutions);
+  }
+  if (!options.unpack_archive.empty()) {
+    return unpackArchive(output, options.unpack_archive);
+  }
+  if (options.input_archive.empty() || options.output_archive.empty()) {
+    output << "Error: Solving an archive needs both --input-archive and --output-archive" << '\n';
+    return false;
+  }
+
+  auto puzzles = PuzzleArchive::open(options.input_archive);
+  if (!puzzles.has_value()) {
+    output << errorMessage(puzzles.error()) << ": " << options.input_archive << '\n';
+    return false;
+  }
+  auto solutions = PuzzleArchive::create(options.output_archive, puzzles->getSudokuSize(), ArchiveSolutions,
+                                         puzzles->getCount());
+  if (!solutions.has_value()) {
+    output << errorMessage(solutions.error()) << ": " << options.output_archive << '\n';
+    return false;
+  }
+  return solveArchive(puzzles.value(), solutions.value(), options.jobs, observers, options.search);
+}
+
+}  // namespace app
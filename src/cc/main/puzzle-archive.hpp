@@ -0,0 +1,215 @@
+#ifndef APP_PUZZLE_ARCHIVE_HPP_
+#define APP_PUZZLE_ARCHIVE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+
+#include "options.hpp"
+#include "src/cc/libsudoku/expected.hpp"
+#include "src/cc/libsudoku/sudoku-math.hpp"
+#include "sudoku-processor.hpp"
+
+namespace app {
+
+/**
+ * Flag of an archive holding solutions rather than puzzles. A record without any filled cell
+ * is a puzzle without a solution.
+ */
+constexpr std::uint32_t ArchiveSolutions = 1U << 0U;
+
+/**
+ * The header at the start of every puzzle archive, followed by the records, see \link PuzzleArchive .
+ *
+ * The header is written as is, in native byte order, like dlx::SearchTrace .
+ */
+struct ArchiveHeader {
+  // The magic bytes identifying an archive, see ArchiveMagic
+  std::array<char, 8> magic;
+
+  // The version of the format, see ArchiveVersion
+  std::uint32_t version;
+
+  // The flags of the archive, such as ArchiveSolutions
+  std::uint32_t flags;
+
+  // The size of every grid in the archive: 4, 9 or 16
+  std::uint32_t sudoku_size;
+
+  // The number of bytes per record, see \link archiveRecordBytes()
+  std::uint32_t record_bytes;
+
+  // The number of records following the header
+  std::uint64_t count;
+};
+
+/**
+ * The reasons a puzzle archive cannot be used, see \link PuzzleArchive .
+ */
+enum class ArchiveError : std::uint8_t {
+  // The file cannot be opened, created, resized or mapped into memory, or is not mapped for writing
+  Io,
+
+  // The file does not start with an archive header, is shorter than its header says,
+  // or holds a cell code above the grid size
+  Format
+};
+
+/**
+ * Returns a human-readable message for the given archive error.
+ */
+auto errorMessage(ArchiveError error) -> std::string;
+
+/**
+ * Returns the number of bits a cell of a grid of the given size is packed into: 4 bits for
+ * grids up to 9x9, and 5 bits for 16x16, whose numbers 1..16 and the empty cell take 17 codes.
+ */
+auto archiveCellBits(sudoku::SudokuSize sudoku_size) -> int;
+
+/**
+ * Returns the number of bytes of a record of a grid of the given size: its cells, packed
+ * row by row, rounded up to whole bytes so that no two records share a byte.
+ */
+auto archiveRecordBytes(sudoku::SudokuSize sudoku_size) -> std::size_t;
+
+/**
+ * A PuzzleArchive is a binary file of Sudoku grids of a single size, mapped into memory.
+ *
+ * The file is an \link ArchiveHeader followed by fixed-size records, one grid each. Every cell
+ * holds its number, or 0 if empty, in \link archiveCellBits() bits, so that a 9x9 grid takes
+ * 41 bytes instead of the 162 or more of the text format, and no parsing is needed to read it.
+ * As records have a fixed size, the record at any index is found without reading the others,
+ * and the records of a batch can be read and written by several threads at once.
+ *
+ * Archives are opened read-only, or created writable with a number of empty records, which can
+ * be resized while writing. Changes are written back to the file by the operating system.
+ */
+class PuzzleArchive {
+ public:
+  /**
+   * Opens an existing archive for reading.
+   */
+  static auto open(const std::string& path) -> sudoku::Expected<PuzzleArchive, ArchiveError>;
+
+  /**
+   * Creates a writable archive of count empty records, replacing any existing file.
+   */
+  static auto create(const std::string& path, sudoku::SudokuSize sudoku_size, std::uint32_t flags,
+                     std::uint64_t count) -> sudoku::Expected<PuzzleArchive, ArchiveError>;
+
+  PuzzleArchive(const PuzzleArchive&) = delete;
+  auto operator=(const PuzzleArchive&) -> PuzzleArchive& = delete;
+  PuzzleArchive(PuzzleArchive&& other) noexcept;
+  auto operator=(PuzzleArchive&& other) noexcept -> PuzzleArchive&;
+
+  /**
+   * Unmaps and closes the file.
+   */
+  ~PuzzleArchive();
+
+  /**
+   * Get the size of every grid in the archive.
+   */
+  [[nodiscard]] auto getSudokuSize() const -> sudoku::SudokuSize;
+
+  /**
+   * Get the flags of the archive, such as ArchiveSolutions .
+   */
+  [[nodiscard]] auto getFlags() const -> std::uint32_t;
+
+  /**
+   * Get the number of records.
+   */
+  [[nodiscard]] auto getCount() const -> std::uint64_t;
+
+  /**
+   * Unpacks the record at the given index (below getCount()) into a grid of digits, row by row,
+   * with sudoku::Puzzle::EmptyCell for empty cells.
+   *
+   * \param digits The grid to unpack into, of at least N*N cells.
+   * \return nothing, or ArchiveError::Format if a cell holds a code above N.
+   */
+  auto read(std::uint64_t index, std::span<std::uint8_t> digits) const -> sudoku::Expected<void, ArchiveError>;
+
+  /**
+   * Packs a grid of digits (0..N, row by row) into the record at the given index (below getCount()).
+   *
+   * \return nothing, or ArchiveError::Io if the archive is not writable.
+   */
+  auto write(std::uint64_t index, std::span<const std::uint8_t> digits) -> sudoku::Expected<void, ArchiveError>;
+
+  /**
+   * Grows or shrinks a writable archive to the given number of records. New records are empty.
+   *
+   * \return if the file could be resized and mapped again.
+   */
+  auto resize(std::uint64_t count) -> bool;
+
+ private:
+  PuzzleArchive(int descriptor, void* mapping, std::size_t mapped_bytes, bool writable);
+
+  /**
+   * Get the first byte of the record at the given index.
+   */
+  [[nodiscard]] auto record(std::uint64_t index) const -> std::uint8_t*;
+
+  // The file descriptor of the archive, or -1 once moved from
+  int descriptor;
+
+  // The mapping of the whole file, starting with the header
+  void* mapping;
+  std::size_t mapped_bytes;
+
+  // Whether the file is mapped for writing
+  bool writable;
+};
+
+/**
+ * Reads in a batch of Sudokus in the text format of \link processBatch() , and writes them to a new
+ * archive at the given path. The first grid determines the size of the archive. The number of
+ * records written is written to output, as well as an error for every Sudoku that was not written.
+ *
+ * \param solutions Whether the batch holds the solutions written by \link processBatch() , in which
+ *                  case "No valid Sudoku solution found" is written as an empty record.
+ * \return if every Sudoku of the batch was written to the archive.
+ */
+auto packArchive(std::istream& input, std::ostream& output, const std::string& path, bool solutions) -> bool;
+
+/**
+ * Writes the records of the archive at the given path to output, in the text format of
+ * \link processBatch() , which \link parseInput() reads back.
+ *
+ * \return if the archive could be read, stopping at the first record holding a cell code above the grid size.
+ */
+auto unpackArchive(std::ostream& output, const std::string& path) -> bool;
+
+/**
+ * Solves every puzzle of the input archive into the record at the same index of the output archive,
+ * on the given number of worker threads, see \link solvePuzzle() . The output archive must hold
+ * solutions of the same size and as many records; puzzles without a solution, and records holding a cell
+ * code above the grid size, are left empty.
+ *
+ * \param observers The observer of each worker, one per job, notified of each Sudoku it solves and of its
+ *                  processing phases, or empty to not observe the puzzles. The input line reported for a
+ *                  Sudoku is its index in the archive, from 1.
+ * \return if a solution was found for every puzzle.
+ */
+auto solveArchive(const PuzzleArchive& input, PuzzleArchive& output, unsigned jobs,
+                  std::span<PhaseObserver* const> observers = {}, const SearchOptions& search = {}) -> bool;
+
+/**
+ * Command-line entry for the archive modes, see \link Options : packing a batch read from input,
+ * unpacking an archive to output, or solving an archive into another.
+ *
+ * \param observers The observer of each worker when solving, one per job, or empty, see \link solveArchive() .
+ * \return if the selected mode succeeded.
+ */
+auto archiveMain(const Options& options, std::istream& input, std::ostream& output,
+                 std::span<PhaseObserver* const> observers) -> bool;
+
+}  // namespace app
+
+#endif  // APP_PUZZLE_ARCHIVE_HPP_
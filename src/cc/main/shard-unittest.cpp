@@ -0,0 +1,119 @@
+#include "shard.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace app {
+
+namespace {
+
+/**
+ * An empty 4x4 Sudoku, having 288 solutions
+ */
+constexpr const char* EmptySudoku = "_ _ _ _\n_ _ _ _\n_ _ _ _\n_ _ _ _\n";
+
+/**
+ * Test: the units of a split, searched and merged separately, count every solution,
+ * and report the same first solution as a single search
+ */
+TEST(MainShard, SplitWorkMerge) {
+  auto directory = std::filesystem::temp_directory_path() / "sudoku-shard-unittest";
+  std::filesystem::remove_all(directory);
+
+  std::istringstream split_input(EmptySudoku);
+  std::ostringstream split_output;
+  ASSERT_TRUE(splitSudoku(split_input, split_output, 2, directory.string()));
+
+  // every unit is searched as if by a separate worker process, saving its output as a result
+  std::vector<std::filesystem::path> units(std::filesystem::directory_iterator(directory), {});
+  for (const auto& unit : units) {
+    std::istringstream work_input(EmptySudoku);
+    std::ofstream result(unit.string() + ".result");
+    ASSERT_TRUE(workSudoku(work_input, result, unit.string(), true));
+  }
+  EXPECT_LT(1, units.size());
+  EXPECT_EQ("Units: " + std::to_string(units.size()) + "\n", split_output.str());
+
+  std::istringstream merge_input(EmptySudoku);
+  std::ostringstream merge_output;
+  ASSERT_TRUE(mergeSudoku(merge_input, merge_output, directory.string()));
+
+  std::istringstream input(EmptySudoku);
+  std::ostringstream expected;
+  ASSERT_TRUE(processSudoku(input, expected));
+  EXPECT_EQ(expected.str() + "Solutions: 288\n", merge_output.str());
+
+  // the results do not belong to another puzzle, nor do its units
+  constexpr const char* OtherSudoku = "1 _ _ _\n_ _ _ _\n_ _ _ _\n_ _ _ _\n";
+  std::istringstream other_input(OtherSudoku);
+  std::ostringstream other_output;
+  EXPECT_FALSE(mergeSudoku(other_input, other_output, directory.string()));
+  EXPECT_NE(std::string::npos, other_output.str().find("do not belong to this Sudoku"));
+
+  std::istringstream other_work_input(OtherSudoku);
+  std::ostringstream other_work_output;
+  EXPECT_FALSE(workSudoku(other_work_input, other_work_output, units.front().string(), true));
+
+  // a missing result fails the merge
+  std::filesystem::remove(directory / "unit-0.unit.result");
+  std::istringstream incomplete_input(EmptySudoku);
+  std::ostringstream incomplete_output;
+  EXPECT_FALSE(mergeSudoku(incomplete_input, incomplete_output, directory.string()));
+  EXPECT_NE(std::string::npos, incomplete_output.str().find("Missing results for 1 work units"));
+
+  std::filesystem::remove_all(directory);
+}
+
+/**
+ * Test: a checkpointed count leaves a final checkpoint, from which a new count resumes
+ */
+TEST(MainShard, CountWithCheckpoint) {
+  auto checkpoint = std::filesystem::temp_directory_path() / "sudoku-shard-unittest.checkpoint";
+  std::filesystem::remove(checkpoint);
+
+  std::istringstream plain_input(EmptySudoku);
+  std::ostringstream plain_output;
+  ASSERT_TRUE(countSudoku(plain_input, plain_output, "", 0));
+  EXPECT_EQ("Solutions: 288\n", plain_output.str());
+
+  std::istringstream first_input(EmptySudoku);
+  std::ostringstream first_output;
+  ASSERT_TRUE(countSudoku(first_input, first_output, checkpoint.string(), 10));
+  EXPECT_EQ("Solutions: 288\n", first_output.str());
+  ASSERT_TRUE(std::filesystem::exists(checkpoint));
+
+  std::istringstream resumed_input(EmptySudoku);
+  std::ostringstream resumed_output;
+  ASSERT_TRUE(countSudoku(resumed_input, resumed_output, checkpoint.string(), 10));
+  EXPECT_EQ("Solutions: 288\n", resumed_output.str());
+
+  // the checkpoint of another Sudoku does not belong to this one
+  std::istringstream other_input("1 _ _ _\n_ _ _ _\n_ _ _ _\n_ _ _ _\n");
+  std::ostringstream other_output;
+  EXPECT_FALSE(countSudoku(other_input, other_output, checkpoint.string(), 10));
+  EXPECT_NE(std::string::npos, other_output.str().find("Checkpoint does not belong"));
+
+  std::filesystem::remove(checkpoint);
+}
+
+/**
+ * Test: the memoized count equals the enumerated count, also when the cache is too small
+ */
+TEST(MainShard, CountMemoized) {
+  std::istringstream input(EmptySudoku);
+  std::ostringstream output;
+  ASSERT_TRUE(countSudokuMemoized(input, output, 1U << 20U));
+  EXPECT_EQ(0, output.str().find("Solutions: 288\nSubproblems: "));
+
+  std::istringstream small_input(EmptySudoku);
+  std::ostringstream small_output;
+  ASSERT_TRUE(countSudokuMemoized(small_input, small_output, 0));
+  EXPECT_EQ("Solutions: 288\nSubproblems: 0, reused: 0 (cache full)\n", small_output.str());
+}
+
+}  // namespace
+}  // namespace app
@@ -0,0 +1,271 @@
+#include "shard.hpp"
+
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+#include "src/cc/libdlx/checkpoint.hpp"
+#include "src/cc/libdlx/work-unit.hpp"
+#include "src/cc/libsudoku/solver.hpp"
+#include "src/cc/libsudoku/sudoku-matrix.hpp"
+
+namespace app {
+
+namespace {
+/**
+ * A puzzle prepared for searching: its size, and a solver over its residual matrix
+ */
+struct PreparedSudoku {
+  sudoku::SudokuSize size;
+  std::unique_ptr<sudoku::Solver> solver;
+};
+
+/**
+ * Helper method to read a puzzle from input and build a solver over its residual matrix.
+ * If that fails, the reason is written to output.
+ */
+auto prepareSudoku(std::istream& input, std::ostream& output, std::pmr::memory_resource* resource)
+    -> std::optional<PreparedSudoku> {
+  auto puzzle = parseInput(input);
+  if (!puzzle.has_value()) {
+    output << errorMessage(puzzle.error()) << '\n';
+    return std::nullopt;
+  }
+
+  auto matrix = sudoku::SudokuMatrix::fromPuzzle(puzzle.value(), resource);
+  if (!matrix.has_value()) {
+    output << "No valid Sudoku solution found" << '\n';
+    return std::nullopt;
+  }
+
+  return PreparedSudoku{puzzle.value().getSudokuSize(), std::make_unique<sudoku::Solver>(std::move(matrix.value()))};
+}
+
+// The solver of a checkpointed count, to request a checkpoint from on a signal
+std::atomic<sudoku::Solver*> counting_solver = nullptr;
+
+// Whether a signal asked the checkpointed count to stop
+volatile std::sig_atomic_t stop_requested = 0;
+
+/**
+ * Signal handler stopping a checkpointed count at its next search node, after a checkpoint.
+ */
+void requestStop(int /*signal*/) {
+  stop_requested = 1;
+  auto* solver = counting_solver.load();
+  if (solver != nullptr) {
+    solver->requestCheckpoint();
+  }
+}
+}  // namespace
+
+auto splitSudoku(std::istream& input, std::ostream& output, std::size_t depth, const std::string& directory) -> bool {
+  std::pmr::monotonic_buffer_resource arena;
+  auto sudoku = prepareSudoku(input, output, &arena);
+  if (!sudoku.has_value()) {
+    return false;
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+
+  auto units = sudoku->solver->split(depth);
+  for (const auto& unit : units) {
+    auto path = std::filesystem::path(directory) / ("unit-" + std::to_string(unit.id) + ".unit");
+    std::ofstream file(path);
+    dlx::writeWorkUnit(file, unit);
+    if (!file) {
+      output << "Error: Cannot write work unit to " << path.string() << '\n';
+      return false;
+    }
+  }
+
+  output << "Units: " << units.size() << '\n';
+  return true;
+}
+
+auto workSudoku(std::istream& input, std::ostream& output, const std::string& unit_file, bool count) -> bool {
+  std::ifstream file(unit_file);
+  auto unit = dlx::readWorkUnit(file);
+  if (!unit.has_value()) {
+    output << "Error: Cannot read work unit: " << unit_file << '\n';
+    return false;
+  }
+
+  std::pmr::monotonic_buffer_resource arena;
+  auto sudoku = prepareSudoku(input, output, &arena);
+  if (!sudoku.has_value()) {
+    return false;
+  }
+
+  auto result = sudoku->solver->solveUnit(unit.value(), count);
+  if (!result.has_value()) {
+    output << "Error: Work unit does not belong to this Sudoku: " << unit_file << '\n';
+    return false;
+  }
+
+  dlx::writeWorkResult(output, result.value());
+  return true;
+}
+
+auto mergeSudoku(std::istream& input, std::ostream& output, const std::string& directory) -> bool {
+  std::vector<dlx::WorkResult> results;
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+    if (entry.path().extension() != ".result") {
+      continue;
+    }
+
+    std::ifstream file(entry.path());
+    auto result = dlx::readWorkResult(file);
+    if (!result.has_value()) {
+      output << "Error: Cannot read work result: " << entry.path().string() << '\n';
+      return false;
+    }
+    results.push_back(std::move(result.value()));
+  }
+
+  if (results.empty()) {
+    output << "Error: No work results in " << directory << '\n';
+    return false;
+  }
+
+  auto merged = dlx::mergeResults(results);
+  if (!merged.has_value()) {
+    output << "Error: Work results of different splits in " << directory << '\n';
+    return false;
+  }
+  if (!merged->missing.empty()) {
+    output << "Error: Missing results for " << merged->missing.size() << " work units in " << directory << '\n';
+    return false;
+  }
+
+  std::pmr::monotonic_buffer_resource arena;
+  auto sudoku = prepareSudoku(input, output, &arena);
+  if (!sudoku.has_value()) {
+    return false;
+  }
+  if (merged->fingerprint != sudoku->solver->fingerprint()) {
+    output << "Error: Work results do not belong to this Sudoku: " << directory << '\n';
+    return false;
+  }
+
+  // covering the rows of the first solution leaves nothing to search but that solution
+  std::array<std::uint8_t, sudoku::MaxCells> digits{};
+  if (merged->solutions == 0 || !sudoku->solver->coverRows(merged->first) || !sudoku->solver->next() ||
+      !sudoku->solver->getSolution(digits)) {
+    output << "No valid Sudoku solution found" << '\n';
+    return false;
+  }
+
+  writeSolution(output, sudoku->size, digits);
+
+  if (merged->exhaustive) {
+    output << "Solutions: " << merged->solutions << '\n';
+  }
+  return true;
+}
+
+auto countSudoku(std::istream& input, std::ostream& output, const std::string& checkpoint_file,
+                 std::uint64_t interval) -> bool {
+  std::pmr::monotonic_buffer_resource arena;
+  auto sudoku = prepareSudoku(input, output, &arena);
+  if (!sudoku.has_value()) {
+    return false;
+  }
+  auto& solver = *sudoku->solver;
+
+  if (checkpoint_file.empty()) {
+    while (solver.next()) {
+    }
+    output << "Solutions: " << solver.getSolutions() << '\n';
+    return true;
+  }
+
+  std::error_code error;
+  if (std::filesystem::exists(checkpoint_file, error)) {
+    auto checkpoint = dlx::loadCheckpoint(checkpoint_file);
+    if (!checkpoint.has_value() || !solver.resume(checkpoint.value())) {
+      output << "Error: Checkpoint does not belong to this Sudoku: " << checkpoint_file << '\n';
+      return false;
+    }
+  }
+
+  // a failed write pauses the search, as its progress could no longer be resumed
+  bool saved = true;
+  solver.setCheckpointHandler(interval, [&](const dlx::Checkpoint& checkpoint) {
+    saved = dlx::saveCheckpoint(checkpoint_file, checkpoint);
+    return saved && stop_requested == 0;
+  });
+
+  stop_requested = 0;
+  counting_solver.store(&solver);
+  auto* previous_interrupt = std::signal(SIGINT, requestStop);
+  auto* previous_terminate = std::signal(SIGTERM, requestStop);
+
+  while (solver.next()) {
+  }
+
+  std::signal(SIGINT, previous_interrupt);
+  std::signal(SIGTERM, previous_terminate);
+  counting_solver.store(nullptr);
+
+  if (!solver.isPaused()) {
+    // the final checkpoint reports the count at once when resumed
+    saved = dlx::saveCheckpoint(checkpoint_file, solver.checkpoint().value());
+  }
+  if (!saved) {
+    output << "Error: Cannot write checkpoint to " << checkpoint_file << '\n';
+    return false;
+  }
+  if (solver.isPaused()) {
+    output << "Stopped at " << solver.getSolutions() << " solutions, resume from checkpoint " << checkpoint_file
+           << '\n';
+    return false;
+  }
+
+  output << "Solutions: " << solver.getSolutions() << '\n';
+  return true;
+}
+
+auto countSudokuMemoized(std::istream& input, std::ostream& output, std::size_t max_bytes) -> bool {
+  std::pmr::monotonic_buffer_resource arena;
+  auto sudoku = prepareSudoku(input, output, &arena);
+  if (!sudoku.has_value()) {
+    return false;
+  }
+
+  auto count = sudoku->solver->countSolutions(max_bytes);
+  if (count->saturated) {
+    output << "Solutions: more than " << count->solutions << '\n';
+  } else {
+    output << "Solutions: " << count->solutions << '\n';
+  }
+  output << "Subproblems: " << count->subproblems << ", reused: " << count->hits
+         << (count->cache_full ? " (cache full)" : "") << '\n';
+  return true;
+}
+
+auto shardMain(const Options& options, std::istream& input, std::ostream& output) -> bool {
+  if (!options.split_directory.empty()) {
+    return splitSudoku(input, output, options.split_depth, options.split_directory);
+  }
+  if (!options.work_unit.empty()) {
+    return workSudoku(input, output, options.work_unit, options.count);
+  }
+  if (!options.merge_directory.empty()) {
+    return mergeSudoku(input, output, options.merge_directory);
+  }
+  if (options.memo) {
+    return countSudokuMemoized(input, output, options.memo_megabytes << 20U);
+  }
+  return countSudoku(input, output, options.checkpoint_file, options.checkpoint_interval);
+}
+
+}  // namespace app
@@ -0,0 +1,79 @@
+#ifndef APP_SHARD_HPP_
+#define APP_SHARD_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "options.hpp"
+
+namespace app {
+
+/**
+ * Reads a puzzle from input, and splits its search into work units at the given depth,
+ * see dlx::Solver::split() . Every unit is written to directory as unit-<id>.unit,
+ * and the number of units to output.
+ *
+ * \return if the puzzle could be read and split, and all units were written.
+ */
+auto splitSudoku(std::istream& input, std::ostream& output, std::size_t depth, const std::string& directory) -> bool;
+
+/**
+ * Reads a puzzle from input, and searches the subtree of the unit in the given file.
+ * The result is written to output, see dlx::writeWorkResult() .
+ *
+ * Every worker must read the same puzzle that was split.
+ *
+ * \param count Whether to count all solutions in the subtree, or to stop at the first.
+ * \return if the unit could be read and belongs to the puzzle.
+ */
+auto workSudoku(std::istream& input, std::ostream& output, const std::string& unit_file, bool count) -> bool;
+
+/**
+ * Reads a puzzle from input, and merges the results of its units in all *.result files
+ * of directory, see dlx::mergeResults() .
+ *
+ * The first solution of the merged search is written to output, in the same format as
+ * \link processSudoku() . If every unit was searched exhaustively, it is followed by the
+ * total number of solutions.
+ *
+ * \return if a result was found for every unit of a split of this puzzle, and the puzzle has a solution.
+ */
+auto mergeSudoku(std::istream& input, std::ostream& output, const std::string& directory) -> bool;
+
+/**
+ * Reads a puzzle from input, and counts all its solutions. The count is written to output.
+ *
+ * With a checkpoint file, the search is checkpointed to that file every interval search nodes,
+ * and when the process receives SIGINT or SIGTERM, see dlx::Solver::setCheckpointHandler() .
+ * On a signal, the search stops after saving its checkpoint. If the file exists, the search is
+ * resumed from it in the first place, so that a count can be continued by a new process after a
+ * restart or preemption. A completed count leaves a final checkpoint, which reports it at once.
+ *
+ * \param checkpoint_file The file to checkpoint to and resume from, or empty to not checkpoint.
+ * \return if all solutions were counted.
+ */
+auto countSudoku(std::istream& input, std::ostream& output, const std::string& checkpoint_file,
+                 std::uint64_t interval) -> bool;
+
+/**
+ * Reads a puzzle from input, and counts all its solutions via memoized subproblem counts,
+ * see dlx::Solver::countSolutions() . The count is written to output, followed by the number of
+ * distinct subproblems counted and the number of times a count was reused.
+ *
+ * \param max_bytes The memory the cache may grow to. Beyond it, the count is still exact.
+ * \return if the puzzle could be read.
+ */
+auto countSudokuMemoized(std::istream& input, std::ostream& output, std::size_t max_bytes) -> bool;
+
+/**
+ * Command-line entry for the split, work, merge and count modes, see \link Options .
+ *
+ * \return if the selected mode succeeded.
+ */
+auto shardMain(const Options& options, std::istream& input, std::ostream& output) -> bool;
+
+}  // namespace app
+
+#endif  // APP_SHARD_HPP_
@@ -2,6 +2,7 @@
 #include "sudoku-processor.hpp"
 
 #include <sstream>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -31,5 +32,268 @@ _ 4 1 _
 )");
 }
 
+/**
+ * Test: the reduced matrix yields the same solution
+ */
+TEST(MainSudokuProcessor, Reduce) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3)");
+  std::ostringstream output;
+  SearchOptions search;
+  search.reduce = true;
+
+  EXPECT_TRUE(processSudoku(input, output, nullptr, search));
+  EXPECT_EQ(output.str(), R"(4 3 2 1 
+2 1 3 4 
+3 4 1 2 
+1 2 4 3 
+)");
+}
+
+/**
+ * Test: the dancing cells engine writes the same solution, and reports unsolvable puzzles
+ */
+TEST(MainSudokuProcessor, DancingCells) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3)");
+  std::ostringstream output;
+  SearchOptions search;
+  search.dancing_cells = true;
+
+  EXPECT_TRUE(processSudoku(input, output, nullptr, search));
+  EXPECT_EQ(output.str(), R"(4 3 2 1 
+2 1 3 4 
+3 4 1 2 
+1 2 4 3 
+)");
+
+  // no digit fits the last cell of the first row, without conflicting givens
+  std::istringstream unsolvable(R"(1 2 3 _
+_ _ _ 4
+_ _ _ _
+_ _ _ _)");
+  std::ostringstream none;
+  EXPECT_FALSE(processSudoku(unsolvable, none, nullptr, search));
+  EXPECT_EQ("No valid Sudoku solution found\n", none.str());
+}
+
+/**
+ * Test: the bitset engine writes the same solution for grids up to 9x9, and reports unsolvable puzzles
+ */
+TEST(MainSudokuProcessor, Bitset) {
+  SearchOptions search;
+  search.bitset = true;
+
+  const std::string small = "4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n";
+  const std::string nine = "5 3 _ _ 7 _ _ _ _\n6 _ _ 1 9 5 _ _ _\n_ 9 8 _ _ _ _ 6 _\n"
+                           "8 _ _ _ 6 _ _ _ 3\n4 _ _ 8 _ 3 _ _ 1\n7 _ _ _ 2 _ _ _ 6\n"
+                           "_ 6 _ _ _ _ 2 8 _\n_ _ _ 4 1 9 _ _ 5\n_ _ _ _ 8 _ _ 7 9\n";
+  for (const auto& puzzle : {small, nine}) {
+    std::istringstream expected_input(puzzle);
+    std::ostringstream expected;
+    ASSERT_TRUE(processSudoku(expected_input, expected));
+
+    std::istringstream input(puzzle);
+    std::ostringstream output;
+    EXPECT_TRUE(processSudoku(input, output, nullptr, search));
+    EXPECT_EQ(expected.str(), output.str());
+  }
+
+  std::istringstream unsolvable(R"(1 2 3 _
+_ _ _ 4
+_ _ _ _
+_ _ _ _)");
+  std::ostringstream none;
+  EXPECT_FALSE(processSudoku(unsolvable, none, nullptr, search));
+  EXPECT_EQ("No valid Sudoku solution found\n", none.str());
+}
+
+/**
+ * Test: solve a batch of sudokus, including an invalid one
+ */
+TEST(MainSudokuProcessor, Batch) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+4 4 _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+)");
+  std::ostringstream output;
+
+  bool result = processBatch(input, output);
+
+  EXPECT_FALSE(result);
+
+  EXPECT_EQ(output.str(), R"(4 3 2 1 
+2 1 3 4 
+3 4 1 2 
+1 2 4 3 
+
+No valid Sudoku solution found
+
+4 3 2 1 
+2 1 3 4 
+3 4 1 2 
+1 2 4 3 
+
+)");
+}
+
+/**
+ * Test: malformed input is reported with an error code and position
+ */
+TEST(MainSudokuProcessor, ParseErrors) {
+  std::istringstream empty("");
+  auto result = parseInput(empty);
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(ParseErrorCode::EmptyInput, result.error().code);
+
+  std::istringstream size("1 2 3\n");
+  result = parseInput(size);
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(ParseErrorCode::InvalidSize, result.error().code);
+  EXPECT_EQ(3, result.error().found);
+
+  std::istringstream length("4 _ _ 1\n_ 1 3\n");
+  result = parseInput(length);
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(ParseErrorCode::InvalidLineLength, result.error().code);
+  EXPECT_EQ(2, result.error().row);
+
+  std::istringstream lines("4 _ _ 1\n_ 1 3 _\n");
+  result = parseInput(lines);
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(ParseErrorCode::MissingLines, result.error().code);
+  EXPECT_EQ("Error: Read 2 lines. Expected to read 4 lines instead", errorMessage(result.error()));
+
+  // 5 is out of range for a 4x4 sudoku
+  std::istringstream range("4 _ _ 1\n_ 1 3 _\n_ 4 5 _\n1 _ _ 3\n");
+  result = parseInput(range);
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(ParseErrorCode::InvalidCharacter, result.error().code);
+  EXPECT_EQ(3, result.error().row);
+  EXPECT_EQ(3, result.error().column);
+  EXPECT_EQ("Error: Invalid character '5' at row 3, column 3", errorMessage(result.error()));
+}
+
+/**
+ * Test: a batch skips malformed sudokus and carries on
+ */
+TEST(MainSudokuProcessor, MalformedBatch) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 x _
+1 _ _ 3
+
+4 _ _
+_ 1 3
+
+4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+)");
+  std::ostringstream output;
+
+  bool result = processBatch(input, output);
+
+  EXPECT_FALSE(result);
+
+  EXPECT_EQ(output.str(), R"(Error: Invalid character 'x' at row 3, column 3
+
+Error: Unrecognized Sudoku size:3. Valid sizes are: 4, 9, 16
+
+4 3 2 1 
+2 1 3 4 
+3 4 1 2 
+1 2 4 3 
+
+)");
+}
+
+/**
+ * Test: validate a batch of sudokus without solving them
+ */
+TEST(MainSudokuProcessor, ValidateBatch) {
+  std::istringstream input(R"(4 3 2 1
+2 1 3 4
+3 4 1 2
+1 2 4 3
+
+4 4 _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+)");
+  std::ostringstream output;
+
+  bool result = processBatch(input, output, nullptr, validateSudoku);
+
+  EXPECT_FALSE(result);
+
+  EXPECT_EQ(output.str(), R"(Valid complete Sudoku
+
+Invalid Sudoku, conflicting cells: (1,1) (1,2) (3,2)
+
+Valid partial Sudoku
+
+)");
+}
+
+/**
+ * Test: list the redundant givens of a batch of sudokus
+ */
+TEST(MainSudokuProcessor, MinimalityBatch) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+4 _ 2 _
+2 _ _ _
+_ _ _ _
+_ _ _ 3
+
+_ _ _ _
+_ _ _ _
+_ _ _ _
+_ _ _ _
+
+1 1 _ _
+_ _ _ _
+_ _ _ _
+_ _ _ _)");
+  std::ostringstream output;
+
+  EXPECT_FALSE(processBatch(input, output, nullptr, checkMinimalityWith(2)));
+  EXPECT_EQ(output.str(), R"(Redundant givens: (1,1)=4 (1,4)=1 (2,2)=1 (2,3)=3 (3,2)=4 (3,3)=1 (4,1)=1 (4,4)=3
+
+Minimal Sudoku, every given is necessary
+
+Sudoku has multiple solutions
+
+No valid Sudoku solution found
+
+)");
+}
+
 }  // namespace
 }  // namespace app
\ No newline at end of file
@@ -2,11 +2,20 @@
 #include "sudoku-processor.hpp"
 
 #include <algorithm>
-#include <cstdlib>
+#include <array>
+#include <cctype>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <sstream>
 
+#include "corpus-reader.hpp"
+#include "src/cc/libdlx/bitset-solver.hpp"
+#include "src/cc/libdlx/dancing-cells-solver.hpp"
+#include "src/cc/libsudoku/minimality.hpp"
+#include "src/cc/libsudoku/puzzle.hpp"
 #include "src/cc/libsudoku/solver.hpp"
+#include "src/cc/libsudoku/validation.hpp"
 
 namespace app {
 
@@ -20,49 +29,403 @@ const char TokenEmptyCell = '_';
  */
 const int BaseSixteen = 16;
 
+auto number2char(int number, sudoku::SudokuSize sudoku_size) -> char;
+
+auto phaseName(Phase phase) -> const char* {
+  switch (phase) {
+    case Phase::Parse:
+      return "parse";
+    case Phase::ApplyGivens:
+      return "givens";
+    case Phase::BuildMatrix:
+      return "build";
+    case Phase::Search:
+      return "search";
+    case Phase::Output:
+      return "output";
+  }
+  return "unknown";
+}
+
+void PhaseObserverList::add(PhaseObserver* observer) {
+  this->observers.push_back(observer);
+}
+
+auto PhaseObserverList::empty() const -> bool {
+  return this->observers.empty();
+}
+
+void PhaseObserverList::puzzleStarted(int line) {
+  for (auto* observer : this->observers) {
+    observer->puzzleStarted(line);
+  }
+}
+
+void PhaseObserverList::puzzleFinished(bool solved) {
+  for (auto* observer : this->observers) {
+    observer->puzzleFinished(solved);
+  }
+}
+
+void PhaseObserverList::puzzleParsed(sudoku::SudokuSize size) {
+  for (auto* observer : this->observers) {
+    observer->puzzleParsed(size);
+  }
+}
+
+void PhaseObserverList::searchFinished(std::uint64_t nodes) {
+  for (auto* observer : this->observers) {
+    observer->searchFinished(nodes);
+  }
+}
+
+auto PhaseObserverList::getSearchTrace() -> dlx::SearchTrace* {
+  for (auto* observer : this->observers) {
+    if (auto* trace = observer->getSearchTrace()) {
+      return trace;
+    }
+  }
+  return nullptr;
+}
+
+void PhaseObserverList::splitFinished(const SplitReport& report) {
+  for (auto* observer : this->observers) {
+    observer->splitFinished(report);
+  }
+}
+
+void PhaseObserverList::phaseStarted(Phase phase) {
+  for (auto* observer : this->observers) {
+    observer->phaseStarted(phase);
+  }
+}
+
+void PhaseObserverList::phaseFinished(Phase phase) {
+  for (auto* observer : this->observers) {
+    observer->phaseFinished(phase);
+  }
+}
+
 /**
- * Helper method to parse input Sudoku from given stream
+ * Helper to notify an optional observer of the start and end of a phase.
+ * The phase is finished when this helper goes out of scope.
  */
-auto parseInput(std::istream& input) -> std::unique_ptr<sudoku::Solver>;
+class PhaseScope {
+ public:
+  PhaseScope(PhaseObserver* observer, Phase phase)
+      : observer(observer), phase(phase) {
+    if (this->observer != nullptr) {
+      this->observer->phaseStarted(this->phase);
+    }
+  }
+
+  ~PhaseScope() {
+    if (this->observer != nullptr) {
+      this->observer->phaseFinished(this->phase);
+    }
+  }
+
+  PhaseScope(const PhaseScope&) = delete;
+  auto operator=(const PhaseScope&) -> PhaseScope& = delete;
+  PhaseScope(PhaseScope&&) = delete;
+  auto operator=(PhaseScope&&) -> PhaseScope& = delete;
+
+ private:
+  PhaseObserver* observer;
+  Phase phase;
+};
 
 /**
- * Helper method to write Sudoku solution to given stream
+ * Helper method to search the residual problem of a Sudoku with an engine over its description,
+ * dlx::DancingCellsSolver or dlx::BitsetSolver , notifying the observer of the same phases as the
+ * dancing links search in \link solvePuzzle() .
+ *
+ * \return if a solution was found and decoded into digits.
  */
-void writeSolution(std::ostream& output, std::unique_ptr<sudoku::Solution> solution);
+template <typename Engine>
+auto searchDescribed(const sudoku::SudokuProblem& problem, std::span<std::uint8_t> digits, PhaseObserver* observer,
+                     std::pmr::memory_resource* resource) -> bool {
+  // Build the sparse sets or bitsets of the residual exact cover problem
+  std::optional<Engine> solver;
+  {
+    PhaseScope scope(observer, Phase::BuildMatrix);
+    solver.emplace(problem.problem, resource);
+  }
+
+  // Search for a solution
+  bool found = false;
+  {
+    PhaseScope scope(observer, Phase::Search);
+    found = solver->next();
+  }
+
+  if (observer != nullptr) {
+    observer->searchFinished(solver->getNodes());
+  }
+
+  if (!found) {
+    return false;
+  }
+
+  // Decode the givens and the rows found, mapped to their placements, into the grid
+  sudoku::decodeRows(problem.sudoku_size, problem.givens, digits);
+  sudoku::decodeRows(problem.sudoku_size, solver->getSolution(), problem.placements, digits);
+  return true;
+}
+
+auto solvePuzzle(const sudoku::Puzzle& puzzle, std::span<std::uint8_t> digits, PhaseObserver* observer,
+                 const SearchOptions& search) -> bool {
+  // Build and solve the puzzle inside a per-puzzle arena, released at once afterwards
+  std::pmr::monotonic_buffer_resource arena;
+
+  // Apply the given cells, leaving only the residual exact cover problem
+  std::optional<sudoku::Expected<sudoku::SudokuProblem, sudoku::InputError>> problem;
+  {
+    PhaseScope scope(observer, Phase::ApplyGivens);
+    problem = sudoku::SudokuMatrix::describe(puzzle, &arena);
+  }
+
+  if (!problem->has_value()) {
+    // Conflicting givens make the Sudoku unsolvable, so fail fast without searching
+    return false;
+  }
+
+  if (search.bitset && puzzle.getSudokuSize() != sudoku::SudokuSize::Sixteen) {
+    return searchDescribed<dlx::BitsetSolver>(problem->value(), digits, observer, &arena);
+  }
+  if (search.dancing_cells) {
+    return searchDescribed<dlx::DancingCellsSolver>(problem->value(), digits, observer, &arena);
+  }
+
+  // Build the residual exact cover matrix
+  std::optional<sudoku::Solver> solver;
+  {
+    PhaseScope scope(observer, Phase::BuildMatrix);
+    solver.emplace(std::make_unique<sudoku::SudokuMatrix>(problem->value(), &arena));
+    if (search.reduce) {
+      solver->reduce();
+    }
+  }
+
+  if (observer != nullptr) {
+    solver->setTrace(observer->getSearchTrace());
+  }
+  if (search.seed.has_value()) {
+    solver->randomize(search.seed.value(), search.restart_unit);
+  }
+  if (search.generic_rows) {
+    solver->useGenericRows();
+  }
+
+  // Search for a solution
+  bool found = false;
+  {
+    PhaseScope scope(observer, Phase::Search);
+    found = solver->next();
+  }
+
+  if (observer != nullptr) {
+    observer->searchFinished(solver->getNodes());
+  }
+
+  // Decode the solution straight into the grid of digits
+  return found && solver->getSolution(digits);
+}
 
 /**
  * Reads in a partial Sudoku form input and writes Sudoku solution to output.
  */
-auto processSudoku(std::istream& input, std::ostream& output) -> bool {
-  try {
-    // Parse input
-    auto solver = parseInput(input);
-    auto result = solver->solve();
-
-    // Check if a solution was found
-    if (!result.has_value()) {
-      output << "No valid Sudoku solution found" << '\n';
-      return false;
+auto processSudoku(std::istream& input, std::ostream& output, PhaseObserver* observer,
+                   const SearchOptions& search) -> bool {
+  // Parse input
+  std::optional<sudoku::Expected<sudoku::Puzzle, ParseError>> puzzle;
+  {
+    PhaseScope scope(observer, Phase::Parse);
+    puzzle = parseInput(input);
+  }
+
+  if (!puzzle->has_value()) {
+    output << errorMessage(puzzle->error()) << '\n';
+    return false;
+  }
+
+  if (observer != nullptr) {
+    observer->puzzleParsed(puzzle->value().getSudokuSize());
+  }
+
+  // Solve into a grid of digits on the stack
+  std::array<std::uint8_t, sudoku::MaxCells> digits{};
+  if (!solvePuzzle(puzzle->value(), digits, observer, search)) {
+    output << "No valid Sudoku solution found" << '\n';
+    return false;
+  }
+
+  PhaseScope scope(observer, Phase::Output);
+  writeSolution(output, puzzle->value().getSudokuSize(), digits);
+  return true;
+}
+
+/**
+ * Reads in a (partial) Sudoku from input and writes whether it observes the Sudoku rules to output.
+ */
+auto validateSudoku(std::istream& input, std::ostream& output, PhaseObserver* observer) -> bool {
+  // Parse input
+  std::optional<sudoku::Expected<sudoku::Puzzle, ParseError>> puzzle;
+  {
+    PhaseScope scope(observer, Phase::Parse);
+    puzzle = parseInput(input);
+  }
+
+  if (!puzzle->has_value()) {
+    output << errorMessage(puzzle->error()) << '\n';
+    return false;
+  }
+
+  if (observer != nullptr) {
+    observer->puzzleParsed(puzzle->value().getSudokuSize());
+  }
+
+  // Check the rules, instead of searching for a solution
+  sudoku::Validation validation;
+  {
+    PhaseScope scope(observer, Phase::Search);
+    validation = sudoku::validate(puzzle->value());
+  }
+
+  PhaseScope scope(observer, Phase::Output);
+  if (!validation.isValid()) {
+    output << "Invalid Sudoku, conflicting cells:";
+    for (auto conflict : validation.conflicts) {
+      output << " (" << conflict.row << "," << conflict.column << ")";
     }
+    output << '\n';
+    return false;
+  }
+
+  output << (validation.complete ? "Valid complete Sudoku" : "Valid partial Sudoku") << '\n';
+  return true;
+}
+
+/**
+ * Reads in a Sudoku from input and writes which of its givens are redundant to output.
+ */
+auto checkSudokuMinimality(std::istream& input, std::ostream& output, PhaseObserver* observer, unsigned threads)
+    -> bool {
+  // Parse input
+  std::optional<sudoku::Expected<sudoku::Puzzle, ParseError>> puzzle;
+  {
+    PhaseScope scope(observer, Phase::Parse);
+    puzzle = parseInput(input);
+  }
+
+  if (!puzzle->has_value()) {
+    output << errorMessage(puzzle->error()) << '\n';
+    return false;
+  }
 
-    writeSolution(output, std::move(result.value()));
-    return true;
+  const auto size = puzzle->value().getSudokuSize();
+  if (observer != nullptr) {
+    observer->puzzleParsed(size);
+  }
+
+  // Check every given, each with a uniqueness count
+  std::optional<sudoku::Expected<sudoku::Minimality, sudoku::InputError>> minimality;
+  {
+    PhaseScope scope(observer, Phase::Search);
+    minimality = sudoku::checkMinimality(puzzle->value(), threads);
+  }
+
+  PhaseScope scope(observer, Phase::Output);
+  if (!minimality->has_value() || minimality->value().solutions == 0) {
+    output << "No valid Sudoku solution found" << '\n';
+    return false;
+  }
 
-  } catch (const char* error_msg) {
-    output << error_msg << '\n';
+  const auto& result = minimality->value();
+  if (!result.isUnique()) {
+    output << "Sudoku has multiple solutions" << '\n';
+    return false;
+  }
+
+  if (!result.isMinimal()) {
+    output << "Redundant givens:";
+    for (auto given : result.redundant) {
+      output << " (" << given.row << "," << given.column << ")=" << number2char(given.number, size);
+    }
+    output << '\n';
+    return false;
   }
-  return false;
+
+  output << "Minimal Sudoku, every given is necessary" << '\n';
+  return true;
+}
+
+auto solveWith(const SearchOptions& search) -> PuzzleProcessor {
+  return [search](std::istream& input, std::ostream& output, PhaseObserver* observer) {
+    return processSudoku(input, output, observer, search);
+  };
+}
+
+auto checkMinimalityWith(unsigned threads) -> PuzzleProcessor {
+  return [threads](std::istream& input, std::ostream& output, PhaseObserver* observer) {
+    return checkSudokuMinimality(input, output, observer, threads);
+  };
+}
+
+/**
+ * Reads in a batch of partial Sudokus from input and writes their solutions to output.
+ */
+auto processBatch(std::istream& input, std::ostream& output, PhaseObserver* observer,
+                  const PuzzleProcessor& process) -> bool {
+  CorpusReader reader(input);
+  bool all_solved = true;
+
+  std::string puzzle;
+  while (reader.next(puzzle)) {
+    if (observer != nullptr) {
+      observer->puzzleStarted(reader.getLine());
+    }
+
+    std::istringstream puzzle_input(puzzle);
+    bool solved = process(puzzle_input, output, observer);
+    output << '\n';
+
+    if (observer != nullptr) {
+      observer->puzzleFinished(solved);
+    }
+
+    all_solved = all_solved && solved;
+  }
+
+  return all_solved;
 }
 
-auto char2number(char value, sudoku::SudokuSize sudoku_size) -> int {
-  std::string str{value};
-  int number = static_cast<int>(strtol(str.c_str(), nullptr, BaseSixteen));
+/**
+ * Helper method to interpret a character as a number for a Sudoku of the given size
+ *
+ * \return the number (1..N), or std::nullopt if the character is not a number in range.
+ */
+auto char2number(char value, sudoku::SudokuSize sudoku_size) -> std::optional<int> {
+  int number = 0;
+  if (value >= '0' && value <= '9') {
+    number = value - '0';
+  } else if (value >= 'A' && value <= 'F') {
+    number = value - 'A' + 10;
+  } else if (value >= 'a' && value <= 'f') {
+    number = value - 'a' + 10;
+  } else {
+    return std::nullopt;
+  }
 
   // Sudokus of 16x16 start at 0 instead of 1 (digit range: 0..F)
   if (sudoku_size == sudoku::SudokuSize::Sixteen) {
     number++;
   }
 
+  if (number < 1 || number > static_cast<int>(sudoku_size)) {
+    return std::nullopt;
+  }
+
   return number;
 }
 
@@ -76,94 +439,121 @@ auto number2char(int number, sudoku::SudokuSize sudoku_size) -> char {
   return chars.at(number % BaseSixteen);
 }
 
+auto errorMessage(const ParseError& error) -> std::string {
+  std::stringstream msg;
+
+  switch (error.code) {
+    case ParseErrorCode::EmptyInput:
+      msg << "Error: Input stream is empty";
+      break;
+    case ParseErrorCode::InvalidSize:
+      msg << "Error: Unrecognized Sudoku size:" << error.found << ". Valid sizes are: 4, 9, 16";
+      break;
+    case ParseErrorCode::InvalidLineLength:
+      msg << "Error: All lines should be of equal size. Read: " << error.found << ". expected: " << error.expected
+          << " (row " << error.row << ")";
+      break;
+    case ParseErrorCode::MissingLines:
+      msg << "Error: Read " << error.found << " lines. Expected to read " << error.expected << " lines instead";
+      break;
+    case ParseErrorCode::InvalidCharacter:
+      msg << "Error: Invalid character '" << static_cast<char>(error.found) << "' at row " << error.row
+          << ", column " << error.column;
+      break;
+  }
+
+  return msg.str();
+}
+
 /**
- * Helper method to parse input Sudoku from given stream
+ * Helper method to remove all whitespace from the given line
  */
-auto parseInput(std::istream& input) -> std::unique_ptr<sudoku::Solver> {
+void removeWhitespace(std::string& str) {
+  str.erase(std::remove_if(str.begin(), str.end(), [](unsigned char token) { return std::isspace(token) != 0; }), str.end());
+}
+
+auto parseInput(std::istream& input) -> sudoku::Expected<sudoku::Puzzle, ParseError> {
+  using Error = sudoku::Unexpected<ParseError>;
+
   std::string str;
   sudoku::SudokuSize size = sudoku::SudokuSize::Nine;
 
   // First line determines sudoku size
   if (!std::getline(input, str)) {
-    throw "Error: Input stream is empty";
+    return Error({.code = ParseErrorCode::EmptyInput});
   }
 
   // remove whitespace and get length
-  str.erase(std::remove_if(str.begin(), str.end(), isspace), str.end());
-  std::size_t input_length = str.length();
+  removeWhitespace(str);
+  const int input_length = static_cast<int>(str.length());
 
   // determine sudoku size based on the length of the first input line
   switch (input_length) {
-    case static_cast<std::size_t>(sudoku::SudokuSize::Four):
+    case static_cast<int>(sudoku::SudokuSize::Four):
       size = sudoku::SudokuSize::Four;
       break;
-    case static_cast<std::size_t>(sudoku::SudokuSize::Nine):
+    case static_cast<int>(sudoku::SudokuSize::Nine):
       size = sudoku::SudokuSize::Nine;
       break;
-    case static_cast<std::size_t>(sudoku::SudokuSize::Sixteen):
+    case static_cast<int>(sudoku::SudokuSize::Sixteen):
       size = sudoku::SudokuSize::Sixteen;
       break;
     default:
-      std::stringstream msg;
-      msg << "Error: Unrecognized Sudoku size:" << input_length << ". Valid sizes are: 4, 9, 16";
-      throw msg.str();
+      return Error({.code = ParseErrorCode::InvalidSize, .row = 1, .found = input_length});
   }
 
-  auto matrix = std::make_unique<sudoku::SudokuMatrix>(size);
-  auto solver = std::make_unique<sudoku::Solver>(std::move(matrix));
+  sudoku::Puzzle puzzle(size);
 
   // Read in input line by line
-  for (int row = 1; row <= static_cast<int>(input_length); row++) {
+  for (int row = 1; row <= input_length; row++) {
     // remove whitespace and get length
-    str.erase(std::remove_if(str.begin(), str.end(), isspace), str.end());
-    std::size_t cur_length = str.length();
+    removeWhitespace(str);
+    const int cur_length = static_cast<int>(str.length());
 
     // Check if this line is complete
     if (cur_length != input_length) {
-      std::stringstream msg;
-      msg << "Error: All lines should be of equal size. Read: " << cur_length << ". expected: " << input_length;
-      throw msg.str();
+      return Error({.code = ParseErrorCode::InvalidLineLength, .row = row, .found = cur_length, .expected = input_length});
     }
 
     // parse current row
     int column = 1;
-    for (char& token : str) {
+    for (char token : str) {
       if (token != TokenEmptyCell) {
-        // Interpret number as int
-        int number = char2number(token, size);
-        solver->setInput(row, column, number);
+        // Interpret number as int, which must be in range for this size
+        auto number = char2number(token, size);
+        if (!number.has_value()) {
+          return Error({.code = ParseErrorCode::InvalidCharacter, .row = row, .column = column, .found = token});
+        }
+        puzzle.setCellValue(row, column, number.value());
       }
       column++;
     }
 
     // read in next row
-    if (row < static_cast<int>(input_length)) {
+    if (row < input_length) {
       if (!std::getline(input, str)) {
-        std::stringstream msg;
-        msg << "Error: Read " << (row) << " lines. Expected to read " << input_length << " lines instead";
-        throw msg.str();
+        return Error({.code = ParseErrorCode::MissingLines, .found = row, .expected = input_length});
       }
     }
   }
 
-  return solver;
+  return puzzle;
 }
 
 /**
  * Helper method to write Sudoku solution to given stream
  */
-void writeSolution(std::ostream& output, std::unique_ptr<sudoku::Solution> solution) {
-  auto sudoku_size = solution->getSudokuSize();
+void writeSolution(std::ostream& output, sudoku::SudokuSize sudoku_size, std::span<const std::uint8_t> digits) {
   int grid_size = static_cast<int>(sudoku_size);
 
-  for (int row = 1; row <= grid_size; row++) {
-    for (int column = 1; column <= grid_size; column++) {
+  for (int row = 0; row < grid_size; row++) {
+    for (int column = 0; column < grid_size; column++) {
       // Get number value at given cell and print with the appropiate character
-      int number = solution->getCellValue(row, column);
-      output << number2char(number, sudoku_size) << " ";
+      int number = digits[row * grid_size + column];
+      output << (number == sudoku::Puzzle::EmptyCell ? TokenEmptyCell : number2char(number, sudoku_size)) << " ";
     }
     output << '\n';
   }
 }
 
-}  // namespace app
\ No newline at end of file
+}  // namespace app
@@ -1,8 +1,19 @@
 #ifndef APP_SUDOKU_PROCESSOR_HPP_
 #define APP_SUDOKU_PROCESSOR_HPP_
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
+
+#include "src/cc/libdlx/search-trace.hpp"
+#include "src/cc/libdlx/solver.hpp"
+#include "src/cc/libsudoku/expected.hpp"
+#include "src/cc/libsudoku/puzzle.hpp"
 
 namespace app {
 
@@ -11,18 +22,314 @@ namespace app {
  */
 extern const char TokenEmptyCell;
 
+/**
+ * The reasons input text cannot be parsed into a Sudoku, see \link parseInput() .
+ */
+enum class ParseErrorCode : std::uint8_t {
+  // The input has no lines at all
+  EmptyInput,
+
+  // The first line does not have 4, 9 or 16 cells
+  InvalidSize,
+
+  // A line has a different number of cells than the first line
+  InvalidLineLength,
+
+  // The input has fewer lines than cells per line
+  MissingLines,
+
+  // A cell is neither empty nor a number in the range of the Sudoku size
+  InvalidCharacter
+};
+
+/**
+ * Describes why and where input text cannot be parsed into a Sudoku.
+ */
+struct ParseError {
+  // The reason parsing failed
+  ParseErrorCode code;
+
+  // The row (1..N) and column (1..N) of the Sudoku at which parsing failed, or 0 if not applicable
+  int row = 0;
+  int column = 0;
+
+  // What was found instead: a number of cells or lines, or the invalid character
+  int found = 0;
+
+  // What was expected instead: a number of cells or lines
+  int expected = 0;
+};
+
+/**
+ * Returns a human-readable message for the given parse error.
+ */
+auto errorMessage(const ParseError& error) -> std::string;
+
+/**
+ * Parses a partial Sudoku from the given stream, in the format of \link processSudoku() .
+ *
+ * Malformed input is reported as an error, never by throwing, so that a batch can skip
+ * a malformed Sudoku as cheaply as a valid one.
+ */
+auto parseInput(std::istream& input) -> sudoku::Expected<sudoku::Puzzle, ParseError>;
+
+/**
+ * The phases of processing a single Sudoku, in order.
+ */
+enum class Phase : std::uint8_t {
+  // Parsing the input text into a puzzle
+  Parse,
+
+  // Applying the given cells of the puzzle to the exact cover problem
+  ApplyGivens,
+
+  // Constructing the (residual) exact cover matrix
+  BuildMatrix,
+
+  // Searching for a solution
+  Search,
+
+  // Writing the solution
+  Output
+};
+
+/**
+ * Number of phases in \link Phase .
+ */
+constexpr int NumPhases = 5;
+
+/**
+ * Returns a short, human-readable name for the given phase.
+ */
+auto phaseName(Phase phase) -> const char*;
+
+/**
+ * The outcome of a Sudoku whose search was split into work units, searched by several workers,
+ * see \link PhaseObserver::splitFinished() .
+ */
+struct SplitReport {
+  // The input line the Sudoku starts at, and the size of its grid
+  int line = 0;
+  sudoku::SudokuSize size = sudoku::SudokuSize::Nine;
+
+  // Whether a solution was found
+  bool solved = false;
+
+  // The wall-clock time from its first unit starting until its last unit finished
+  std::chrono::nanoseconds latency{0};
+
+  // The wall-clock time spent on its units, summed over the workers
+  std::chrono::nanoseconds busy{0};
+
+  // Number of search nodes visited by all of its units
+  std::uint64_t nodes = 0;
+};
+
+/**
+ * A PhaseObserver is notified when processing a Sudoku enters and leaves each \link Phase .
+ *
+ * Observers are used to instrument \link processSudoku() , for example with timers or
+ * hardware performance counters. Phases are never nested.
+ *
+ * When processing a batch, see \link processBatch() , the observer is also notified
+ * when processing each Sudoku starts and finishes.
+ */
+class PhaseObserver {
+ public:
+  virtual ~PhaseObserver() = default;
+
+  /**
+   * Called right before processing the Sudoku starting at the given input line.
+   */
+  virtual void puzzleStarted(int /*line*/) {}
+
+  /**
+   * Called right after processing a Sudoku, with whether a solution was found.
+   */
+  virtual void puzzleFinished(bool /*solved*/) {}
+
+  /**
+   * Called right after a Sudoku was parsed successfully, with the size of its grid.
+   */
+  virtual void puzzleParsed(sudoku::SudokuSize /*size*/) {}
+
+  /**
+   * Called right after the search for a solution finished, with the number of search nodes
+   * visited, see dlx::Solver::getNodes() .
+   */
+  virtual void searchFinished(std::uint64_t /*nodes*/) {}
+
+  /**
+   * Returns the trace to record the search decisions into, or nullptr if not tracing.
+   */
+  virtual auto getSearchTrace() -> dlx::SearchTrace* { return nullptr; }
+
+  /**
+   * Called instead of all other notifications for a Sudoku whose search was split into work units
+   * across the workers of a batch, see \link runBatch() , once its last unit finished.
+   */
+  virtual void splitFinished(const SplitReport& /*report*/) {}
+
+  /**
+   * Called right before the given phase starts.
+   */
+  virtual void phaseStarted(Phase phase) = 0;
+
+  /**
+   * Called right after the given phase finished.
+   */
+  virtual void phaseFinished(Phase phase) = 0;
+};
+
+/**
+ * A PhaseObserver forwarding all notifications to a list of other observers, in order.
+ */
+class PhaseObserverList : public PhaseObserver {
+ public:
+  /**
+   * Adds an observer to the end of the list. The observer must outlive this list.
+   */
+  void add(PhaseObserver* observer);
+
+  /**
+   * Returns if the list contains no observers.
+   */
+  [[nodiscard]] auto empty() const -> bool;
+
+  void puzzleStarted(int line) override;
+  void puzzleFinished(bool solved) override;
+  void puzzleParsed(sudoku::SudokuSize size) override;
+  void searchFinished(std::uint64_t nodes) override;
+  auto getSearchTrace() -> dlx::SearchTrace* override;
+  void splitFinished(const SplitReport& report) override;
+  void phaseStarted(Phase phase) override;
+  void phaseFinished(Phase phase) override;
+
+ private:
+  std::vector<PhaseObserver*> observers;
+};
+
+/**
+ * Options for the search for a solution, see \link processSudoku() .
+ */
+struct SearchOptions {
+  // Seed of a randomized search with restarts, or std::nullopt for the deterministic search,
+  // see dlx::Solver::randomize()
+  std::optional<std::uint64_t> seed;
+
+  // Number of search nodes per unit of the restart budget of a randomized search
+  std::uint64_t restart_unit = dlx::DefaultRestartUnit;
+
+  // Whether to use the generic search path instead of the one specialized for four-node rows,
+  // see dlx::Solver::useGenericRows()
+  bool generic_rows = false;
+
+  // Whether to shrink the residual matrix before searching, see dlx::reduce()
+  bool reduce = false;
+
+  // Whether to search with the sparse-set engine dlx::DancingCellsSolver instead of dancing links.
+  // The randomized search, generic rows and search traces only apply to dancing links.
+  bool dancing_cells = false;
+
+  // Whether to search grids of up to 9x9 with the dense engine dlx::BitsetSolver instead, which is
+  // slower for 16x16 grids, see there. As for dancing cells, the randomized search, generic rows
+  // and search traces only apply to dancing links.
+  bool bitset = false;
+};
+
 /**
  * Reads in a partial Sudoku form input and writes Sudoku solution to output.
  *
  * \param input Stream of lines defining partial input Sudoku.
  *              For a Sudoku of size N, there should be N lines of length N .
- *              Each line can contain numbers 1..N (using 1..F for size 16).
+ *              Each line can contain numbers 1..N (using 0..F for size 16).
  *              Character '_' is used to define an empty cell.
  *              Lines can contain optional spaces, these are ignored.
+ *              If the input is malformed, an error message is written instead.
+ * \param observer Optional observer notified of each processing phase.
+ * \param search Options for the search for a solution.
  * \return if a solution was found and written to output.
  */
-auto processSudoku(std::istream& input, std::ostream& output) -> bool;
+auto processSudoku(std::istream& input, std::ostream& output, PhaseObserver* observer = nullptr,
+                   const SearchOptions& search = {}) -> bool;
+
+/**
+ * Solves a parsed Sudoku into a grid of digits, as \link processSudoku() does after parsing.
+ *
+ * Observers are notified of the ApplyGivens, BuildMatrix and Search phases.
+ *
+ * \param digits The grid to decode the solution into, row by row, of at least N*N cells.
+ * \param observer Optional observer notified of each processing phase.
+ * \param search Options for the search for a solution.
+ * \return if a solution was found and decoded into digits.
+ */
+auto solvePuzzle(const sudoku::Puzzle& puzzle, std::span<std::uint8_t> digits, PhaseObserver* observer = nullptr,
+                 const SearchOptions& search = {}) -> bool;
+
+/**
+ * Reads in a (partial) Sudoku from input and writes whether it observes the Sudoku rules to output.
+ *
+ * The Sudoku is checked via sudoku::validate() , without building an exact cover matrix or
+ * searching for a solution. If the Sudoku has conflicts, all conflicting cells are listed.
+ * Observers are notified of the Parse phase, and of the Search phase for the check itself.
+ *
+ * \param input Stream of lines defining the Sudoku, in the format of \link processSudoku() .
+ * \param observer Optional observer notified of each processing phase.
+ * \return if the Sudoku has no conflicting cells.
+ */
+auto validateSudoku(std::istream& input, std::ostream& output, PhaseObserver* observer = nullptr) -> bool;
+
+/**
+ * Reads in a Sudoku from input and writes which of its givens are redundant to output.
+ *
+ * A given is redundant if the solution stays unique without it, see sudoku::checkMinimality() .
+ * Observers are notified of the Parse phase, and of the Search phase for all checks together.
+ *
+ * \param input Stream of lines defining the Sudoku, in the format of \link processSudoku() .
+ * \param observer Optional observer notified of each processing phase.
+ * \param threads The number of threads checking the givens, or 0 for the number of hardware threads.
+ * \return if the Sudoku has a unique solution and none of its givens is redundant.
+ */
+auto checkSudokuMinimality(std::istream& input, std::ostream& output, PhaseObserver* observer = nullptr,
+                           unsigned threads = 0) -> bool;
+
+/**
+ * Processes a single Sudoku from input to output, such as \link processSudoku() .
+ */
+using PuzzleProcessor = std::function<bool(std::istream& input, std::ostream& output, PhaseObserver* observer)>;
+
+/**
+ * Returns a processor solving each Sudoku via \link processSudoku() with the given search options.
+ */
+auto solveWith(const SearchOptions& search) -> PuzzleProcessor;
+
+/**
+ * Returns a processor checking each Sudoku via \link checkSudokuMinimality() with the given threads.
+ */
+auto checkMinimalityWith(unsigned threads) -> PuzzleProcessor;
+
+/**
+ * Reads in a batch of partial Sudokus from input and writes their solutions to output.
+ *
+ * The input lists Sudokus in the format of \link processSudoku() , separated by one
+ * or more empty lines. Solutions (or error messages) are written in the same order,
+ * each followed by an empty line. A Sudoku without a valid solution does not stop
+ * the batch.
+ *
+ * \param observer Optional observer notified of each Sudoku and processing phase.
+ * \param process How to process each Sudoku, e.g. \link validateSudoku() to only validate.
+ * \return if a solution was found for every Sudoku in the batch.
+ */
+auto processBatch(std::istream& input, std::ostream& output, PhaseObserver* observer = nullptr,
+                  const PuzzleProcessor& process = solveWith({})) -> bool;
+
+/**
+ * Writes a solved grid of digits to output, in the format of \link processSudoku() .
+ * Empty cells (sudoku::Puzzle::EmptyCell) are written as TokenEmptyCell, so that a partial grid
+ * is written in the input format.
+ */
+void writeSolution(std::ostream& output, sudoku::SudokuSize sudoku_size, std::span<const std::uint8_t> digits);
 
 }  // namespace app
 
-#endif  // APP_SUDOKU_PROCESSOR_HPP_
\ No newline at end of file
+#endif  // APP_SUDOKU_PROCESSOR_HPP_
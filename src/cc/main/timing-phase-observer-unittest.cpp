@@ -0,0 +1,55 @@
+#include "timing-phase-observer.hpp"
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace app {
+
+namespace {
+
+/**
+ * Test: every phase of every sudoku in a batch is timed, and the slowest are tracked
+ */
+TEST(MainTimingPhaseObserver, Batch) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+)");
+  std::ostringstream output;
+  TimingPhaseObserver observer(2);
+
+  EXPECT_TRUE(processBatch(input, output, &observer));
+
+  EXPECT_EQ(3, observer.getTotalHistogram().getCount());
+  for (int phase = 0; phase < NumPhases; phase++) {
+    EXPECT_EQ(3, observer.getPhaseHistogram(static_cast<Phase>(phase)).getCount());
+  }
+
+  // only the top-2 slowest are tracked, each identified by its first input line
+  auto slowest = observer.getSlowest();
+  EXPECT_EQ(2, slowest.size());
+  EXPECT_GE(slowest[0].first, slowest[1].first);
+  for (auto [latency, line] : slowest) {
+    EXPECT_TRUE(line == 1 || line == 6 || line == 11);
+  }
+
+  std::ostringstream report;
+  observer.writeReport(report);
+  EXPECT_NE(std::string::npos, report.str().find("search"));
+  EXPECT_NE(std::string::npos, report.str().find("Slowest Sudokus by input line:"));
+}
+
+}  // namespace
+}  // namespace app
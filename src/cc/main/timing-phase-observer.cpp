@@ -0,0 +1,128 @@
+#include "timing-phase-observer.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+
+namespace app {
+
+/**
+ * Column width of the human-readable report
+ */
+const int ReportColumnWidth = 12;
+
+/**
+ * Nanoseconds per microsecond, the unit of the human-readable report
+ */
+const double NanosPerMicro = 1000.0;
+
+TimingPhaseObserver::TimingPhaseObserver(int top_slowest)
+    : top_slowest(top_slowest), current_line(0), current_total(0) {}
+
+void TimingPhaseObserver::puzzleStarted(int line) {
+  this->current_line = line;
+  this->current_total = 0;
+}
+
+void TimingPhaseObserver::puzzleFinished(bool /*solved*/) {
+  this->total.record(this->current_total);
+  this->addSlowest(std::make_pair(this->current_total, this->current_line));
+}
+
+void TimingPhaseObserver::addSlowest(std::pair<std::uint64_t, int> entry) {
+  if (this->top_slowest <= 0) {
+    return;
+  }
+
+  // keep the top-K slowest in a min-heap, so the fastest of them is replaced first
+  if (static_cast<int>(this->slowest.size()) < this->top_slowest) {
+    this->slowest.push_back(entry);
+    std::push_heap(this->slowest.begin(), this->slowest.end(), std::greater<>());
+  } else if (entry > this->slowest.front()) {
+    std::pop_heap(this->slowest.begin(), this->slowest.end(), std::greater<>());
+    this->slowest.back() = entry;
+    std::push_heap(this->slowest.begin(), this->slowest.end(), std::greater<>());
+  }
+}
+
+void TimingPhaseObserver::phaseStarted(Phase /*phase*/) {
+  this->phase_start = std::chrono::steady_clock::now();
+}
+
+void TimingPhaseObserver::phaseFinished(Phase phase) {
+  auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->phase_start);
+  auto nanos = static_cast<std::uint64_t>(latency.count());
+
+  this->phases[static_cast<int>(phase)].record(nanos);
+  this->current_total += nanos;
+}
+
+void TimingPhaseObserver::splitFinished(const SplitReport& report) {
+  auto nanos = static_cast<std::uint64_t>(report.latency.count());
+
+  this->phases[static_cast<int>(Phase::Search)].record(nanos);
+  this->total.record(nanos);
+  this->addSlowest(std::make_pair(nanos, report.line));
+}
+
+void TimingPhaseObserver::merge(const TimingPhaseObserver& other) {
+  for (int phase = 0; phase < NumPhases; phase++) {
+    this->phases[phase].merge(other.phases[phase]);
+  }
+  this->total.merge(other.total);
+  for (auto entry : other.slowest) {
+    this->addSlowest(entry);
+  }
+}
+
+auto TimingPhaseObserver::getPhaseHistogram(Phase phase) const -> const metrics::Histogram& {
+  return this->phases[static_cast<int>(phase)];
+}
+
+auto TimingPhaseObserver::getTotalHistogram() const -> const metrics::Histogram& {
+  return this->total;
+}
+
+auto TimingPhaseObserver::getSlowest() const -> std::vector<std::pair<std::uint64_t, int>> {
+  auto result = this->slowest;
+  std::sort(result.begin(), result.end(), std::greater<>());
+  return result;
+}
+
+/**
+ * Helper method to write one row of the latency report, in microseconds
+ */
+void writeHistogramRow(std::ostream& output, const char* name, const metrics::Histogram& histogram) {
+  output << std::left << std::setw(ReportColumnWidth) << name
+         << std::right << std::setw(ReportColumnWidth) << histogram.getCount()
+         << std::fixed << std::setprecision(1);
+
+  for (double percentile : {50.0, 90.0, 99.0}) {
+    output << std::setw(ReportColumnWidth) << static_cast<double>(histogram.getPercentile(percentile)) / NanosPerMicro;
+  }
+  output << std::setw(ReportColumnWidth) << static_cast<double>(histogram.getMax()) / NanosPerMicro << '\n';
+}
+
+void TimingPhaseObserver::writeReport(std::ostream& output) const {
+  output << std::left << std::setw(ReportColumnWidth) << "phase (us)" << std::right;
+  for (const char* column : {"count", "p50", "p90", "p99", "max"}) {
+    output << std::setw(ReportColumnWidth) << column;
+  }
+  output << '\n';
+
+  for (int phase = 0; phase < NumPhases; phase++) {
+    writeHistogramRow(output, phaseName(static_cast<Phase>(phase)), this->phases[phase]);
+  }
+  writeHistogramRow(output, "total", this->total);
+
+  if (!this->slowest.empty()) {
+    output << "Slowest Sudokus by input line:" << '\n';
+    for (auto [latency, line] : this->getSlowest()) {
+      output << "  line " << line << ": " << static_cast<double>(latency) / NanosPerMicro << " us" << '\n';
+    }
+  }
+
+  output << std::defaultfloat;
+}
+
+}  // namespace app
@@ -0,0 +1,97 @@
+#ifndef APP_TIMING_PHASE_OBSERVER_HPP_
+#define APP_TIMING_PHASE_OBSERVER_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "options.hpp"
+#include "src/cc/libmetrics/histogram.hpp"
+#include "sudoku-processor.hpp"
+
+namespace app {
+
+/**
+ * A PhaseObserver timing each processing phase and each Sudoku in a batch.
+ *
+ * The wall-clock latency of every phase is recorded in a latency histogram per phase,
+ * and the total latency of every Sudoku in a histogram over the batch. In addition,
+ * the top-K slowest Sudokus are tracked by the input line they start at, so that
+ * heavy-tailed inputs can be found in large batches.
+ *
+ * An observer is not thread-safe: in a batch of several workers, each worker records into
+ * an observer of its own, and these are merged once the batch finished, see \link merge() .
+ */
+class TimingPhaseObserver : public PhaseObserver {
+ public:
+  /**
+   * Constructs a new observer tracking the given number of slowest Sudokus.
+   */
+  explicit TimingPhaseObserver(int top_slowest = DefaultTopSlowest);
+
+  void puzzleStarted(int line) override;
+  void puzzleFinished(bool solved) override;
+  void phaseStarted(Phase phase) override;
+  void phaseFinished(Phase phase) override;
+
+  /**
+   * Records a split Sudoku as searched in a single Search phase lasting its latency.
+   */
+  void splitFinished(const SplitReport& report) override;
+
+  /**
+   * Adds everything recorded by another observer, such as that of another worker, to this observer.
+   */
+  void merge(const TimingPhaseObserver& other);
+
+  /**
+   * Returns the latency histogram, in nanoseconds, of the given phase.
+   */
+  [[nodiscard]] auto getPhaseHistogram(Phase phase) const -> const metrics::Histogram&;
+
+  /**
+   * Returns the latency histogram, in nanoseconds, of processing a whole Sudoku.
+   */
+  [[nodiscard]] auto getTotalHistogram() const -> const metrics::Histogram&;
+
+  /**
+   * Returns the slowest Sudokus as (latency in nanoseconds, input line) pairs, slowest first.
+   */
+  [[nodiscard]] auto getSlowest() const -> std::vector<std::pair<std::uint64_t, int>>;
+
+  /**
+   * Writes a human-readable report of the p50/p90/p99/max latency per phase
+   * and the slowest Sudokus.
+   */
+  void writeReport(std::ostream& output) const;
+
+ private:
+  // Number of slowest Sudokus to track
+  int top_slowest;
+
+  // Latency histograms, in nanoseconds, indexed by Phase
+  std::array<metrics::Histogram, NumPhases> phases;
+
+  // Latency histogram, in nanoseconds, of processing a whole Sudoku
+  metrics::Histogram total;
+
+  // The slowest Sudokus as a min-heap on latency, with at most top_slowest elements
+  std::vector<std::pair<std::uint64_t, int>> slowest;
+
+  // State of the Sudoku and phase currently being processed
+  int current_line;
+  std::uint64_t current_total;
+  std::chrono::steady_clock::time_point phase_start;
+
+  /**
+   * Helper method to track a Sudoku of the given (latency in nanoseconds, input line) among the slowest.
+   */
+  void addSlowest(std::pair<std::uint64_t, int> entry);
+};
+
+}  // namespace app
+
+#endif  // APP_TIMING_PHASE_OBSERVER_HPP_
@@ -0,0 +1,60 @@
+#include "trace-phase-observer.hpp"
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace app {
+
+namespace {
+
+/**
+ * Test Helper: an observer counting the search nodes reported for each Sudoku
+ */
+class NodeCounter : public PhaseObserver {
+ public:
+  void phaseStarted(Phase /*phase*/) override {}
+  void phaseFinished(Phase /*phase*/) override {}
+  void searchFinished(std::uint64_t nodes) override { this->nodes += nodes; }
+
+  std::uint64_t nodes = 0;
+};
+
+/**
+ * Test: the searches of a batch are recorded into a single trace
+ */
+TEST(MainTracePhaseObserver, Batch) {
+  std::istringstream input(R"(4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+_ _ _ _
+_ _ _ _
+_ _ _ _
+_ _ _ _
+)");
+  std::ostringstream output;
+  std::ostringstream trace_output;
+  NodeCounter counter;
+  {
+    TracePhaseObserver trace(trace_output);
+    PhaseObserverList observers;
+    observers.add(&counter);
+    observers.add(&trace);
+
+    EXPECT_TRUE(processBatch(input, output, &observers));
+  }
+
+  std::istringstream trace_input(trace_output.str());
+  auto events = dlx::readTrace(trace_input);
+  ASSERT_TRUE(events.has_value());
+
+  auto summary = dlx::summarizeTrace(events.value());
+  EXPECT_EQ(2, summary.solutions);
+  EXPECT_EQ(counter.nodes, summary.nodes);
+  EXPECT_LT(0, summary.nodes);
+}
+
+}  // namespace
+}  // namespace app
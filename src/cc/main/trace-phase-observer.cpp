@@ -0,0 +1,15 @@
+#include "trace-phase-observer.hpp"
+
+namespace app {
+
+TracePhaseObserver::TracePhaseObserver(std::ostream& output) : trace(output) {}
+
+void TracePhaseObserver::phaseStarted(Phase /*phase*/) {}
+
+void TracePhaseObserver::phaseFinished(Phase /*phase*/) {}
+
+auto TracePhaseObserver::getSearchTrace() -> dlx::SearchTrace* {
+  return &this->trace;
+}
+
+}  // namespace app
@@ -0,0 +1,34 @@
+#ifndef APP_TRACE_PHASE_OBSERVER_HPP_
+#define APP_TRACE_PHASE_OBSERVER_HPP_
+
+#include <iostream>
+
+#include "src/cc/libdlx/search-trace.hpp"
+#include "sudoku-processor.hpp"
+
+namespace app {
+
+/**
+ * A PhaseObserver recording the search decisions of every Sudoku into a binary trace,
+ * see dlx::SearchTrace . The traces of a batch are appended to each other, so that
+ * they are summarized together by the trace-summary tool.
+ */
+class TracePhaseObserver : public PhaseObserver {
+ public:
+  /**
+   * Constructs a new observer writing the trace to the given stream, which must outlive this observer.
+   */
+  explicit TracePhaseObserver(std::ostream& output);
+
+  void phaseStarted(Phase phase) override;
+  void phaseFinished(Phase phase) override;
+  auto getSearchTrace() -> dlx::SearchTrace* override;
+
+ private:
+  // The trace all searches are recorded into
+  dlx::SearchTrace trace;
+};
+
+}  // namespace app
+
+#endif  // APP_TRACE_PHASE_OBSERVER_HPP_
@@ -0,0 +1,27 @@
+#include <fstream>
+#include <iostream>
+
+#include "src/cc/libdlx/search-trace.hpp"
+
+/**
+ * Summarizes a search trace written with `sudoku --trace <file>` into per-depth
+ * branching statistics and an estimate of the search tree size.
+ *
+ *   trace-summary <file>
+ */
+auto main(int argc, char* argv[]) -> int {
+  if (argc != 2) {
+    std::cerr << "Usage: trace-summary <file>" << '\n';
+    return 1;
+  }
+
+  std::ifstream input(argv[1], std::ios::binary);
+  auto events = dlx::readTrace(input);
+  if (!events.has_value()) {
+    std::cerr << "Error: Not a search trace: " << argv[1] << '\n';
+    return 1;
+  }
+
+  dlx::writeTraceSummary(std::cout, dlx::summarizeTrace(events.value()));
+  return 0;
+}
@@ -0,0 +1,153 @@
+package main
+
+import (
+	"bufio"
+	"fmt"
+	"io"
+	"os"
+	"regexp"
+	"strconv"
+	"strings"
+	"syscall"
+	"time"
+)
+
+/**
+ * Number of untimed rounds over the corpus before the timed round, if not specified
+ */
+const DefaultWarmupRounds = 3
+
+/**
+ * Splits a corpus of Sudoku puzzles into the input text of each puzzle.
+ *
+ * A corpus lists puzzles in the input format of ProcessSudoku, separated by one
+ * or more empty lines.
+ */
+func ReadCorpus(input io.Reader) []string {
+	corpus := []string{}
+	var puzzle strings.Builder
+
+	scanner := bufio.NewScanner(input)
+	for scanner.Scan() {
+		line := scanner.Text()
+
+		if strings.TrimSpace(line) == "" {
+			// an empty line ends the current puzzle
+			if puzzle.Len() > 0 {
+				corpus = append(corpus, puzzle.String())
+				puzzle.Reset()
+			}
+			continue
+		}
+
+		puzzle.WriteString(line)
+		puzzle.WriteString("\n")
+	}
+
+	if puzzle.Len() > 0 {
+		corpus = append(corpus, puzzle.String())
+	}
+
+	return corpus
+}
+
+/**
+ * Solves every puzzle in the corpus and writes a benchmark record per puzzle
+ * to output.
+ *
+ * The corpus is first solved warmupRounds times without recording. The record
+ * format is shared by the C++, Go and Java ports so that tools/bench can
+ * combine and compare their results:
+ *
+ *   puzzle,<index>,<size>,<latency_ns>,<solution>
+ *   summary,<puzzles>,<total_ns>,<peak_rss_kb>
+ *
+ * where solution is the solved grid with all whitespace removed, or "none"
+ * when the puzzle could not be solved.
+ *
+ * @return if every puzzle in the corpus was solved.
+ */
+func RunBenchmark(corpus []string, warmupRounds int, output io.StringWriter) bool {
+	// Warm-up rounds, results are discarded
+	for round := 0; round < warmupRounds; round++ {
+		for _, puzzle := range corpus {
+			var solution strings.Builder
+			ProcessSudoku(strings.NewReader(puzzle), &solution)
+		}
+	}
+
+	// Timed round
+	regexWhitespace, _ := regexp.Compile("\\s+")
+	allSolved := true
+	var total time.Duration
+
+	for index, puzzle := range corpus {
+		var solution strings.Builder
+
+		start := time.Now()
+		solved := ProcessSudoku(strings.NewReader(puzzle), &solution)
+		latency := time.Since(start)
+		total += latency
+
+		// the first line of a puzzle determines the sudoku size
+		firstLine, _, _ := strings.Cut(puzzle, "\n")
+		size := len(regexWhitespace.ReplaceAllString(firstLine, ""))
+
+		result := "none"
+		if solved {
+			result = regexWhitespace.ReplaceAllString(solution.String(), "")
+		}
+
+		output.WriteString(fmt.Sprintf("puzzle,%d,%d,%d,%s\n", index+1, size, latency.Nanoseconds(), result))
+		allSolved = allSolved && solved
+	}
+
+	output.WriteString(fmt.Sprintf("summary,%d,%d,%d\n", len(corpus), total.Nanoseconds(), peakRssKb()))
+
+	return allSolved
+}
+
+/**
+ * Command-line entry for the benchmark mode: --benchmark <corpus> [--warmup <rounds>]
+ *
+ * @return if the arguments were valid and every puzzle in the corpus was solved.
+ */
+func BenchmarkMain(args []string, output io.StringWriter) bool {
+	corpusPath := ""
+	warmupRounds := DefaultWarmupRounds
+
+	for i := 0; i < len(args); i++ {
+		if args[i] == "--benchmark" && i+1 < len(args) {
+			i++
+			corpusPath = args[i]
+		} else if args[i] == "--warmup" && i+1 < len(args) {
+			i++
+			warmupRounds, _ = strconv.Atoi(args[i])
+		} else {
+			output.WriteString(fmt.Sprintf("Error: Unrecognized argument: %s\n", args[i]))
+			return false
+		}
+	}
+
+	input, err := os.Open(corpusPath)
+	if err != nil {
+		output.WriteString(fmt.Sprintf("Error: Cannot read corpus: %s\n", corpusPath))
+		return false
+	}
+	defer input.Close()
+
+	return RunBenchmark(ReadCorpus(input), warmupRounds, output)
+}
+
+/**
+ * Helper method to get the peak resident set size of this process in kilobytes
+ */
+func peakRssKb() int64 {
+	var usage syscall.Rusage
+	if err := syscall.Getrusage(syscall.RUSAGE_SELF, &usage); err != nil {
+		return -1
+	}
+
+	// On Linux, Maxrss is reported in kilobytes
+	return usage.Maxrss
+}
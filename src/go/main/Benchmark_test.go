@@ -0,0 +1,59 @@
+package main_test
+
+import (
+	"strings"
+	"testing"
+
+	"github.com/mleemansnl/sudoku-solver/src/go/main"
+	"github.com/stretchr/testify/suite"
+)
+
+// Test Suite: Benchmark
+type BenchmarkTestSuite struct {
+	suite.Suite
+}
+
+// Go run entry to testify test suite
+func TestBenchmarkTestSuite(t *testing.T) {
+	suite.Run(t, new(BenchmarkTestSuite))
+}
+
+/**
+ * Test: a corpus is split on empty lines
+ */
+func (suite *BenchmarkTestSuite) TestReadCorpus() {
+	input := `4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ 3
+
+  
+4 _ _ 1
+_ 1 3 _
+_ 4 1 _
+1 _ _ _
+`
+
+	corpus := main.ReadCorpus(strings.NewReader(input))
+
+	suite.Equal(2, len(corpus))
+	suite.Equal("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n", corpus[0])
+	suite.Equal("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ _\n", corpus[1])
+}
+
+/**
+ * Test: every puzzle yields a benchmark record with its solution
+ */
+func (suite *BenchmarkTestSuite) TestRecords() {
+	corpus := []string{"4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n"}
+	var output strings.Builder
+
+	result := main.RunBenchmark(corpus, 1, &output)
+
+	suite.True(result)
+
+	records := strings.Split(output.String(), "\n")
+	suite.True(strings.HasPrefix(records[0], "puzzle,1,4,"))
+	suite.True(strings.HasSuffix(records[0], ",4321213434121243"))
+	suite.True(strings.HasPrefix(records[1], "summary,1,"))
+}
@@ -3,6 +3,14 @@ package main
 import "os"
 
 func main() {
+	// Benchmark mode: solve a corpus of puzzles and report per-puzzle latencies
+	if len(os.Args) > 1 && os.Args[1] == "--benchmark" {
+		if !BenchmarkMain(os.Args[1:], os.Stdout) {
+			os.Exit(1)
+		}
+		return
+	}
+
 	if !ProcessSudoku(os.Stdin, os.Stdout) {
 		os.Exit(1)
 	}
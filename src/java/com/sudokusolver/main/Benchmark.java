@@ -0,0 +1,161 @@
+package com.sudokusolver.main;
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.PrintWriter;
+import java.io.StringReader;
+import java.io.StringWriter;
+import java.io.Writer;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
+
+public final class Benchmark {
+
+    private Benchmark() {
+    }
+
+    /**
+     * Number of untimed rounds over the corpus before the timed round, if not
+     * specified. The JVM needs these rounds to JIT-compile the solver hot paths.
+     */
+    public static final int DefaultWarmupRounds = 3;
+
+    /**
+     * Splits a corpus of Sudoku puzzles into the input text of each puzzle.
+     *
+     * A corpus lists puzzles in the input format of
+     * SudokuProcessor.processSudoku, separated by one or more empty lines.
+     */
+    public static List<String> readCorpus(BufferedReader input) throws IOException {
+        List<String> corpus = new ArrayList<>();
+        StringBuilder puzzle = new StringBuilder();
+
+        String line;
+        while ((line = input.readLine()) != null) {
+            if (line.isBlank()) {
+                // an empty line ends the current puzzle
+                if (puzzle.length() > 0) {
+                    corpus.add(puzzle.toString());
+                    puzzle.setLength(0);
+                }
+                continue;
+            }
+
+            puzzle.append(line).append('\n');
+        }
+
+        if (puzzle.length() > 0) {
+            corpus.add(puzzle.toString());
+        }
+
+        return corpus;
+    }
+
+    /**
+     * Solves every puzzle in the corpus and writes a benchmark record per puzzle
+     * to output.
+     *
+     * The corpus is first solved warmupRounds times without recording. The record
+     * format is shared by the C++, Go and Java ports so that tools/bench can
+     * combine and compare their results:
+     *
+     * <pre>
+     *   puzzle,&lt;index&gt;,&lt;size&gt;,&lt;latency_ns&gt;,&lt;solution&gt;
+     *   summary,&lt;puzzles&gt;,&lt;total_ns&gt;,&lt;peak_rss_kb&gt;
+     * </pre>
+     *
+     * where solution is the solved grid with all whitespace removed, or "none"
+     * when the puzzle could not be solved.
+     *
+     * @return if every puzzle in the corpus was solved.
+     */
+    public static boolean runBenchmark(List<String> corpus, int warmupRounds, Writer output) {
+        PrintWriter writer = new PrintWriter(output, true);
+
+        // Warm-up rounds, results are discarded
+        for (int round = 0; round < warmupRounds; round++) {
+            for (String puzzle : corpus) {
+                SudokuProcessor.processSudoku(new StringReader(puzzle), new StringWriter());
+            }
+        }
+
+        // Timed round
+        boolean allSolved = true;
+        long total = 0;
+
+        for (int index = 0; index < corpus.size(); index++) {
+            String puzzle = corpus.get(index);
+            StringWriter solution = new StringWriter();
+
+            final long start = System.nanoTime();
+            final boolean solved = SudokuProcessor.processSudoku(new StringReader(puzzle), solution);
+            final long latency = System.nanoTime() - start;
+            total += latency;
+
+            // the first line of a puzzle determines the sudoku size
+            final int size = puzzle.substring(0, puzzle.indexOf('\n')).replaceAll("\\s+", "").length();
+            final String result = solved ? solution.toString().replaceAll("\\s+", "") : "none";
+
+            writer.print("puzzle,%d,%d,%d,%s\n".formatted(index + 1, size, latency, result));
+            allSolved = allSolved && solved;
+        }
+
+        writer.print("summary,%d,%d,%d\n".formatted(corpus.size(), total, peakRssKb()));
+        writer.flush();
+
+        return allSolved;
+    }
+
+    /**
+     * Command-line entry for the benchmark mode: --benchmark &lt;corpus&gt;
+     * [--warmup &lt;rounds&gt;]
+     *
+     * @return if the arguments were valid and every puzzle in the corpus was
+     *         solved.
+     */
+    public static boolean benchmarkMain(String[] args, Writer output) {
+        PrintWriter writer = new PrintWriter(output, true);
+        String corpusPath = null;
+        int warmupRounds = DefaultWarmupRounds;
+
+        for (int i = 0; i < args.length; i++) {
+            if ("--benchmark".equals(args[i]) && i + 1 < args.length) {
+                corpusPath = args[++i];
+            } else if ("--warmup".equals(args[i]) && i + 1 < args.length) {
+                warmupRounds = Integer.parseInt(args[++i]);
+            } else {
+                writer.print("Error: Unrecognized argument: %s\n".formatted(args[i]));
+                writer.flush();
+                return false;
+            }
+        }
+
+        try (BufferedReader input = Files.newBufferedReader(Paths.get(corpusPath))) {
+            return runBenchmark(readCorpus(input), warmupRounds, output);
+        } catch (IOException e) {
+            writer.print("Error: Cannot read corpus: %s\n".formatted(corpusPath));
+            writer.flush();
+            return false;
+        }
+    }
+
+    /**
+     * Helper method to get the peak resident set size of this process in
+     * kilobytes, as reported by Linux in /proc/self/status.
+     */
+    private static long peakRssKb() {
+        try {
+            for (String line : Files.readAllLines(Path.of("/proc/self/status"))) {
+                if (line.startsWith("VmHWM:")) {
+                    return Long.parseLong(line.replaceAll("[^0-9]", ""));
+                }
+            }
+        } catch (IOException | NumberFormatException e) {
+            return -1;
+        }
+        return -1;
+    }
+}
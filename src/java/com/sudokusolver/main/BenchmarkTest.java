@@ -0,0 +1,58 @@
+package com.sudokusolver.main;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.StringReader;
+import java.io.StringWriter;
+import java.util.List;
+
+import org.junit.jupiter.api.Test;
+
+public class BenchmarkTest {
+
+    /**
+     * Test: a corpus is split on empty lines
+     */
+    @Test
+    void testReadCorpus() throws IOException {
+        BufferedReader input = new BufferedReader(new StringReader("""
+                4 _ _ 1
+                _ 1 3 _
+                _ 4 1 _
+                1 _ _ 3
+
+
+                4 _ _ 1
+                _ 1 3 _
+                _ 4 1 _
+                1 _ _ _
+                """));
+
+        List<String> corpus = Benchmark.readCorpus(input);
+
+        assertEquals(2, corpus.size());
+        assertEquals("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n", corpus.get(0));
+        assertEquals("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ _\n", corpus.get(1));
+    }
+
+    /**
+     * Test: every puzzle yields a benchmark record with its solution
+     */
+    @Test
+    void testRecords() {
+        List<String> corpus = List.of("4 _ _ 1\n_ 1 3 _\n_ 4 1 _\n1 _ _ 3\n");
+        StringWriter output = new StringWriter();
+
+        boolean result = Benchmark.runBenchmark(corpus, 1, output);
+
+        assertTrue(result);
+
+        String[] records = output.toString().split("\n");
+        assertTrue(records[0].startsWith("puzzle,1,4,"));
+        assertTrue(records[0].endsWith(",4321213434121243"));
+        assertTrue(records[1].startsWith("summary,1,"));
+    }
+}
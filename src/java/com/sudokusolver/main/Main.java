@@ -15,6 +15,19 @@ public final class Main {
     public static void main(String args[]) {
         boolean result = true;
 
+        // Benchmark mode: solve a corpus of puzzles and report per-puzzle latencies
+        if (args.length > 0 && "--benchmark".equals(args[0])) {
+            try (Writer output = new BufferedWriter(new OutputStreamWriter(System.out))) {
+                result = Benchmark.benchmarkMain(args, output);
+            } catch (IOException e) {
+                result = false;
+            }
+            if (!result) {
+                System.exit(1);
+            }
+            return;
+        }
+
         // try with resources (ensures resources are closed afterwards)
         try (BufferedReader input = new BufferedReader(new InputStreamReader(System.in));
                 Writer output = new BufferedWriter(new OutputStreamWriter(System.out));) {
@@ -0,0 +1,153 @@
+#!/usr/bin/env bash
+# Cross-language benchmark harness comparing the C++, Go and Java implementations.
+#
+# Runs the --benchmark mode of each implementation on the same puzzle corpora,
+# combines their per-puzzle records into one report, and checks that all
+# implementations produce identical solutions.
+#
+# Usage: benchmark.sh [--warmup N] [--output PREFIX] [--languages cc,go,java]
+#                     [--perf-counters] [corpus ...]
+#
+# Writes:
+#   PREFIX.csv          one row per language, corpus and puzzle
+#   PREFIX-summary.csv  one row per language and corpus
+#   PREFIX-perf.csv     with --perf-counters, hardware counters per corpus and
+#                       processing phase (C++ implementation only)
+#   PREFIX.json         all of the above
+set -euo pipefail
+
+warmup=3
+output="bench-report"
+languages="cc,go,java"
+perf_counters=""
+corpora=()
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    --warmup) warmup="$2"; shift 2 ;;
+    --output) output="$2"; shift 2 ;;
+    --languages) languages="$2"; shift 2 ;;
+    --perf-counters) perf_counters="--perf-counters"; shift ;;
+    *) corpora+=("$1"); shift ;;
+  esac
+done
+
+# Resolve user-provided paths against the directory bazel run was invoked from
+resolve() {
+  if [[ "$1" = /* || -z "${BUILD_WORKING_DIRECTORY:-}" ]]; then
+    echo "$1"
+  else
+    echo "${BUILD_WORKING_DIRECTORY}/$1"
+  fi
+}
+
+if [[ ${#corpora[@]} -eq 0 ]]; then
+  read -r -a corpora <<< "${BENCH_DEFAULT_CORPORA:-}"
+else
+  for i in "${!corpora[@]}"; do corpora[i]="$(resolve "${corpora[i]}")"; done
+fi
+output="$(resolve "${output}")"
+
+binary() {
+  case "$1" in
+    cc) echo "${BENCH_CC_BIN:?}" ;;
+    go) echo "${BENCH_GO_BIN:?}" ;;
+    java) echo "${BENCH_JAVA_BIN:?}" ;;
+  esac
+}
+
+records="$(mktemp)"
+trap 'rm -f "${records}"' EXIT
+
+# Collect records as: language,corpus,<benchmark record>, followed by the number of puzzles
+# in the corpus and the exit status of each implementation, so that an implementation which
+# crashed or failed to start is reported instead of silently missing from the comparison
+IFS=',' read -r -a langs <<< "${languages}"
+for corpus in "${corpora[@]}"; do
+  name="$(basename "${corpus}")"
+  puzzles="$(awk 'BEGIN { RS = "" } END { print NR }' "${corpus}")"
+  for lang in "${langs[@]}"; do
+    echo "Running ${lang} on ${corpus}" >&2
+    extra=()
+    if [[ "${lang}" == "cc" && -n "${perf_counters}" ]]; then extra+=("${perf_counters}"); fi
+    set +e
+    "$(binary "${lang}")" --benchmark "${corpus}" --warmup "${warmup}" "${extra[@]}" \
+      | sed "s|^|${lang},${name},|" >> "${records}"
+    exit_status="${PIPESTATUS[0]}"
+    set -e
+    echo "${lang},${name},expected,${puzzles},${exit_status}" >> "${records}"
+  done
+done
+
+awk -F',' -v csv="${output}.csv" -v summary="${output}-summary.csv" -v perf="${output}-perf.csv" -v json="${output}.json" '
+  $3 == "puzzle" {
+    key = $2 "," $4
+    n++; lang[n] = $1; corpus[n] = $2; puzzle[n] = $4; size[n] = $5; latency[n] = $6; solution[n] = $7
+    if (!(key in reference)) { reference[key] = $7; reflang[key] = $1 }
+    else if (reference[key] != $7) {
+      mismatches++
+      printf "Mismatch: %s puzzle %s differs between %s and %s\n", $2, $4, reflang[key], $1 > "/dev/stderr"
+    }
+  }
+  $3 == "puzzle" { produced[$1 "," $2]++ }
+  $3 == "summary" {
+    m++; slang[m] = $1; scorpus[m] = $2; spuzzles[m] = $4; stotal[m] = $5; srss[m] = $6
+  }
+  $3 == "expected" {
+    key = $1 "," $2
+    exit_status[key] = $5
+    if (produced[key] + 0 < $4) {
+      mismatches++
+      printf "Mismatch: %s produced %d of %d puzzle records for %s (exit status %s)\n", $1, produced[key], $4, $2, $5 > "/dev/stderr"
+    }
+  }
+  $3 == "perf" {
+    p++; plang[p] = $1; pcorpus[p] = $2; pphase[p] = $4
+    pcounts[p] = $5 "," $6 "," $7 "," $8 "," $9
+  }
+  END {
+    print "language,corpus,puzzle,size,latency_ns,solution" > csv
+    for (i = 1; i <= n; i++) printf "%s,%s,%s,%s,%s,%s\n", lang[i], corpus[i], puzzle[i], size[i], latency[i], solution[i] > csv
+
+    print "language,corpus,puzzles,total_ns,puzzles_per_second,peak_rss_kb,exit_status" > summary
+    for (i = 1; i <= m; i++) {
+      throughput[i] = stotal[i] > 0 ? spuzzles[i] * 1e9 / stotal[i] : 0
+      sstatus[i] = exit_status[slang[i] "," scorpus[i]]
+      printf "%s,%s,%s,%s,%.1f,%s,%s\n", slang[i], scorpus[i], spuzzles[i], stotal[i], throughput[i], srss[i], sstatus[i] > summary
+    }
+
+    printf "{\n  \"mismatches\": %d,\n  \"summary\": [\n", mismatches > json
+    for (i = 1; i <= m; i++) {
+      printf "    {\"language\": \"%s\", \"corpus\": \"%s\", \"puzzles\": %s, \"total_ns\": %s, \"puzzles_per_second\": %.1f, \"peak_rss_kb\": %s, \"exit_status\": %s}%s\n", \
+        slang[i], scorpus[i], spuzzles[i], stotal[i], throughput[i], srss[i], sstatus[i], (i < m ? "," : "") > json
+    }
+    if (p > 0) {
+      print "language,corpus,phase,cycles,instructions,l1d_misses,llc_misses,branch_misses" > perf
+      for (i = 1; i <= p; i++) printf "%s,%s,%s,%s\n", plang[i], pcorpus[i], pphase[i], pcounts[i] > perf
+    }
+
+    printf "  ],\n  \"perf\": [\n" > json
+    for (i = 1; i <= p; i++) {
+      split(pcounts[i], c, ",")
+      for (j = 1; j <= 5; j++) if (c[j] == "") c[j] = "null"
+      printf "    {\"language\": \"%s\", \"corpus\": \"%s\", \"phase\": \"%s\", \"cycles\": %s, \"instructions\": %s, \"l1d_misses\": %s, \"llc_misses\": %s, \"branch_misses\": %s}%s\n", \
+        plang[i], pcorpus[i], pphase[i], c[1], c[2], c[3], c[4], c[5], (i < p ? "," : "") > json
+    }
+    printf "  ],\n  \"puzzles\": [\n" > json
+    for (i = 1; i <= n; i++) {
+      printf "    {\"language\": \"%s\", \"corpus\": \"%s\", \"puzzle\": %s, \"size\": %s, \"latency_ns\": %s, \"solution\": \"%s\"}%s\n", \
+        lang[i], corpus[i], puzzle[i], size[i], latency[i], solution[i], (i < n ? "," : "") > json
+    }
+    printf "  ]\n}\n" > json
+
+    exit (mismatches > 0)
+  }
+' "${records}" && status=0 || status=$?
+
+cat "${output}-summary.csv"
+echo "Report written to ${output}.csv, ${output}-summary.csv and ${output}.json" >&2
+
+if [[ ${status} -ne 0 ]]; then
+  echo "Error: implementations produced different or missing solutions" >&2
+fi
+exit "${status}"